@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include "bench_util.h"
+
+namespace
+{
+constexpr size_t SERIES = 16;
+
+constexpr size_t SIZE = 1 << 18;
+
+/**
+ * Series of one trade every 10 milliseconds on average, over about 43 minutes.
+ */
+std::vector<std::vector<Instant>> all_series()
+{
+    std::vector<std::vector<Instant>> ret;
+    for (uint64_t s = 0; s < SERIES; ++s)
+        ret.push_back(sorted_instants(SIZE, 10'000'000, s));
+    return ret;
+}
+
+DatetimeRange range_of(const std::vector<std::vector<Instant>>& series)
+{
+    return DatetimeRange(Datetime::from_instant(series[0].front(), TZ::EST),
+                         Datetime::from_instant(series[0].back(), TZ::EST));
+}
+
+void BM_align_to_grid(benchmark::State& state)
+{
+    std::vector<std::vector<Instant>> columns = all_series();
+    std::vector<std::span<const Instant>> series(columns.begin(), columns.end());
+    TimeGrid grid = TimeGrid(range_of(columns), TimeDelta(0, 0, 0, 1));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(align_to_grid(grid, series, TimeDelta(0, 0, 1),
+                                               AsofDirection::BACKWARD,
+                                               static_cast<unsigned>(state.range(0))));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SERIES * SIZE));
+}
+
+void BM_datetime_grid_binary_search(benchmark::State& state)
+{
+    std::vector<std::vector<Datetime>> series;
+    for (const std::vector<Instant>& column : all_series())
+    {
+        series.emplace_back();
+        for (Instant instant : column)
+            series.back().push_back(Datetime::from_instant(instant, TZ::EST));
+    }
+    DatetimeRange range = range_of(all_series());
+    for (auto _ : state)
+    {
+        std::vector<Datetime> grid = Datetime::range(range.start, range.end, Seconds(1));
+        std::vector<std::vector<size_t>> out;
+        for (const std::vector<Datetime>& column : series)
+        {
+            out.emplace_back();
+            for (const Datetime& point : grid)
+            {
+                auto next = std::upper_bound(column.begin(), column.end(), point);
+                out.back().push_back(static_cast<size_t>(next - column.begin()));
+            }
+        }
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SERIES * SIZE));
+}
+}
+
+BENCHMARK(BM_align_to_grid)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_datetime_grid_binary_search)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include "bench_util.h"
+
+namespace
+{
+/**
+ * Joins trades against quotes that arrive 'range(1)' times as often.
+ */
+void BM_asof_join(benchmark::State& state)
+{
+    auto trades = sorted_instants(static_cast<size_t>(state.range(0)), 1'000'000, 1);
+    auto quotes = sorted_instants(static_cast<size_t>(state.range(0) * state.range(1)),
+                                  1'000'000 / state.range(1), 2);
+    auto threads = static_cast<unsigned>(state.range(2));
+    std::vector<size_t> out(trades.size());
+
+    for (auto _ : state)
+    {
+        asof_join(trades, quotes, TimeDelta(0, 0, 0, 1), AsofDirection::BACKWARD, threads, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(trades.size() + quotes.size()));
+}
+
+/**
+ * Baseline merge over 'Datetimes' with the full comparison operators.
+ */
+void BM_asof_join_datetime_merge(benchmark::State& state)
+{
+    auto to_datetimes = [](const std::vector<Instant>& instants)
+    {
+        std::vector<Datetime> datetimes;
+        datetimes.reserve(instants.size());
+        for (Instant instant : instants)
+            datetimes.push_back(Datetime::from_instant(instant, TZ::EST));
+        return datetimes;
+    };
+    auto trades = to_datetimes(sorted_instants(static_cast<size_t>(state.range(0)), 1'000'000, 1));
+    auto quotes = to_datetimes(sorted_instants(static_cast<size_t>(state.range(0) * state.range(1)),
+                                               1'000'000 / state.range(1), 2));
+    std::vector<size_t> out(trades.size());
+
+    for (auto _ : state)
+    {
+        size_t j = 0;
+        for (size_t i = 0; i < trades.size(); ++i)
+        {
+            while (j < quotes.size() && quotes[j] <= trades[i])
+                j++;
+            out[i] = j == 0 ? ASOF_NO_MATCH : j - 1;
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(trades.size() + quotes.size()));
+}
+}
+
+// Args are {left rows, right rows per left row, threads}.
+BENCHMARK(BM_asof_join)
+    ->Args({1 << 20, 1, 1})
+    ->Args({1 << 20, 64, 1})
+    ->Args({1 << 14, 4096, 1})
+    ->Args({50'000'000, 1, 1})
+    ->Args({50'000'000, 1, 8})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_asof_join_datetime_merge)
+    ->Args({1 << 20, 1})
+    ->Args({1 << 20, 64})
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,28 @@
+#ifndef DATETIME_BENCH_UTIL_H
+#define DATETIME_BENCH_UTIL_H
+
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <datetime/instant/instant.h>
+
+/**
+ * Gets 'size' sorted 'Instants' starting at 2022-01-03 with random gaps averaging
+ * 'mean_gap' nanoseconds, like the timestamps of a trade or quote feed.
+ */
+inline std::vector<Instant> sorted_instants(size_t size, int64_t mean_gap, uint64_t seed = 1)
+{
+    std::mt19937_64 rng(seed);
+    std::exponential_distribution<double> gap(1.0 / static_cast<double>(mean_gap));
+
+    std::vector<Instant> instants(size);
+    int64_t nanoseconds = 1'641'168'000'000'000'000;
+    for (Instant& instant : instants)
+    {
+        nanoseconds += static_cast<int64_t>(gap(rng));
+        instant = Instant(nanoseconds);
+    }
+    return instants;
+}
+
+#endif //DATETIME_BENCH_UTIL_H
@@ -0,0 +1,78 @@
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include "bench_util.h"
+
+namespace
+{
+constexpr size_t SIZE = 1 << 22;
+
+/**
+ * Gets 'Instants' one millisecond apart with no jitter, like a sampled clock.
+ */
+std::vector<Instant> regular_instants()
+{
+    std::vector<Instant> instants(SIZE);
+    for (size_t i = 0; i < SIZE; ++i)
+        instants[i] = Instant(1'641'168'000'000'000'000 + static_cast<int64_t>(i) * 1'000'000);
+    return instants;
+}
+
+/**
+ * Gets 'Instants' of microsecond resolution with random gaps, like an exchange feed.
+ */
+std::vector<Instant> feed_instants()
+{
+    std::vector<Instant> instants = sorted_instants(SIZE, 50'000);
+    for (Instant& instant : instants)
+        instant = Instant(instant.nanoseconds / 1'000 * 1'000);
+    return instants;
+}
+
+std::vector<Instant> instants_for(int64_t kind)
+{
+    return kind == 0 ? regular_instants() : feed_instants();
+}
+
+void BM_compressed_encode(benchmark::State& state)
+{
+    auto instants = instants_for(state.range(0));
+    for (auto _ : state)
+    {
+        CompressedTimestampColumn column = CompressedTimestampColumn(instants);
+        benchmark::DoNotOptimize(column.size());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(SIZE * sizeof(Instant)));
+}
+
+void BM_compressed_decode(benchmark::State& state)
+{
+    auto instants = instants_for(state.range(0));
+    CompressedTimestampColumn column = CompressedTimestampColumn(instants);
+    std::vector<Instant> out(SIZE);
+    for (auto _ : state)
+    {
+        column.decode(out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(SIZE * sizeof(Instant)));
+    state.counters["ratio"] = column.compression_ratio();
+}
+
+void BM_compressed_at(benchmark::State& state)
+{
+    auto instants = instants_for(state.range(0));
+    CompressedTimestampColumn column = CompressedTimestampColumn(instants);
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(column.at(i));
+        i = (i + 7919) % SIZE;
+    }
+}
+}
+
+// Arg is 0 for regular 'Instants' and 1 for feed-like 'Instants'.
+BENCHMARK(BM_compressed_encode)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_compressed_decode)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_compressed_at)->Arg(0)->Arg(1);
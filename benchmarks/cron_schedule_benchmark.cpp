@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+
+namespace
+{
+const std::vector<std::string_view> EXPRESSIONS = {"*/5 * * * *", "30 9 * * 1-5", "0 0 1 */3 *"};
+
+/**
+ * Matches a 'Datetime' in its own timezone against 'schedule' the way a job runner that
+ * steps minute by minute would, with the components of the 'Datetime'.
+ */
+Datetime next_by_stepping(const CronSchedule& schedule, Datetime datetime)
+{
+    datetime = Datetime(datetime.year, datetime.month, datetime.day, datetime.hour,
+                        datetime.minute, 0, 0, 0, 0, datetime.timezone);
+    do
+        datetime += Minutes(1);
+    while (!schedule.matches(datetime));
+    return datetime;
+}
+
+void BM_cron_next_after(benchmark::State& state)
+{
+    CronSchedule schedule = CronSchedule(EXPRESSIONS[static_cast<size_t>(state.range(0))]);
+    Datetime datetime = Datetime(2022, 1, 3, 10, 7, 0, 0, 0, 0, TZ::EST);
+    for (auto _ : state)
+    {
+        datetime = schedule.next_after(datetime, TZ::EST);
+        if (datetime.year == 2090)
+            datetime = Datetime(2022, 1, 3, 10, 7, 0, 0, 0, 0, TZ::EST);
+        benchmark::DoNotOptimize(datetime);
+    }
+    state.SetLabel(std::string(EXPRESSIONS[static_cast<size_t>(state.range(0))]));
+}
+
+void BM_cron_step_minutes(benchmark::State& state)
+{
+    CronSchedule schedule = CronSchedule(EXPRESSIONS[static_cast<size_t>(state.range(0))]);
+    Datetime datetime = Datetime(2022, 1, 3, 10, 7, 0, 0, 0, 0, TZ::EST);
+    for (auto _ : state)
+    {
+        datetime = next_by_stepping(schedule, datetime);
+        if (datetime.year == 2090)
+            datetime = Datetime(2022, 1, 3, 10, 7, 0, 0, 0, 0, TZ::EST);
+        benchmark::DoNotOptimize(datetime);
+    }
+    state.SetLabel(std::string(EXPRESSIONS[static_cast<size_t>(state.range(0))]));
+}
+}
+
+BENCHMARK(BM_cron_next_after)->DenseRange(0, 2);
+BENCHMARK(BM_cron_step_minutes)->DenseRange(0, 2);
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include <map>
+#include <random>
+#include <unordered_map>
+
+namespace
+{
+constexpr size_t LOOKUPS = 1 << 16;
+
+const DateRange RANGE = DateRange(Date(2000, 1, 1), Date(2029, 12, 31));
+
+std::vector<Date> all_days()
+{
+    std::vector<Date> ret;
+    for (int64_t day = RANGE.start.days_since_epoch(); day <= RANGE.end.days_since_epoch(); ++day)
+        ret.push_back(Date::from_days_since_epoch(day));
+    return ret;
+}
+
+std::vector<Date> lookups()
+{
+    std::vector<Date> days = all_days();
+    std::mt19937_64 rng(94);
+    std::vector<Date> ret;
+    for (size_t i = 0; i < LOOKUPS; ++i)
+        ret.push_back(days[rng() % days.size()]);
+    return ret;
+}
+
+template<typename Map>
+void find_all(benchmark::State& state, const Map& map)
+{
+    std::vector<Date> keys = lookups();
+    for (auto _ : state)
+    {
+        double total = 0;
+        for (const Date& key : keys)
+            total += map.find(key)->second;
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LOOKUPS));
+}
+
+void BM_date_map_find(benchmark::State& state)
+{
+    DateMap<double> map = DateMap<double>(RANGE, static_cast<DateMapStorage>(state.range(0)));
+    for (const Date& day : all_days())
+        map[day] = 1.0;
+
+    std::vector<Date> keys = lookups();
+    for (auto _ : state)
+    {
+        double total = 0;
+        for (const Date& key : keys)
+            total += *map.find(key);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LOOKUPS));
+}
+
+void BM_unordered_map_find(benchmark::State& state)
+{
+    std::unordered_map<Date, double> map;
+    for (const Date& day : all_days())
+        map[day] = 1.0;
+    find_all(state, map);
+}
+
+void BM_map_find(benchmark::State& state)
+{
+    std::map<Date, double> map;
+    for (const Date& day : all_days())
+        map[day] = 1.0;
+    find_all(state, map);
+}
+}
+
+BENCHMARK(BM_date_map_find)->Arg(static_cast<int64_t>(DateMapStorage::DENSE))
+    ->Arg(static_cast<int64_t>(DateMapStorage::PAGED));
+BENCHMARK(BM_unordered_map_find);
+BENCHMARK(BM_map_find);
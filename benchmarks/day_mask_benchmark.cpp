@@ -0,0 +1,93 @@
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include "bench_util.h"
+
+namespace
+{
+constexpr size_t SIZE = 1 << 16;
+
+/**
+ * 37 windows of 5 minutes every 10 minutes from 09:30 in EST.
+ */
+std::vector<TimeRange> windows()
+{
+    std::vector<TimeRange> ret;
+    for (int i = 0; i < 37; ++i)
+    {
+        int start = 9 * 60 + 30 + i * 10;
+        ret.emplace_back(Time(start / 60, start % 60, 0, 0, 0, 0, TZ::EST),
+                         Time(start / 60, start % 60 + 4, 59, 0, 0, 0, TZ::EST));
+    }
+    return ret;
+}
+
+/**
+ * Ticks every 1.3 seconds on average from midnight, so the column covers a whole day.
+ */
+std::vector<Instant> ticks()
+{
+    return sorted_instants(SIZE, 1'300'000'000);
+}
+
+std::vector<Time> tick_times()
+{
+    std::vector<Time> ret;
+    for (Instant instant : ticks())
+        ret.push_back(Datetime::from_instant(instant, TZ::EST).time());
+    return ret;
+}
+
+void BM_day_mask_contains(benchmark::State& state)
+{
+    DayMask mask = DayMask(windows(), TZ::EST);
+    std::vector<Time> times = tick_times();
+    for (auto _ : state)
+    {
+        size_t count = 0;
+        for (const Time& time : times)
+            count += mask.contains(time);
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+
+void BM_time_range_loop(benchmark::State& state)
+{
+    std::vector<TimeRange> ranges = windows();
+    std::vector<Time> times = tick_times();
+    for (auto _ : state)
+    {
+        size_t count = 0;
+        for (const Time& time : times)
+        {
+            for (const TimeRange& range : ranges)
+            {
+                if (range.in_range(time))
+                {
+                    count++;
+                    break;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+
+void BM_day_mask_mask(benchmark::State& state)
+{
+    DayMask mask = DayMask(windows(), TZ::EST, TimeDelta(0, 0, 0, 1));
+    std::vector<Instant> instants = ticks();
+    std::vector<uint8_t> out(SIZE);
+    for (auto _ : state)
+    {
+        mask.mask(instants, out);
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+}
+
+BENCHMARK(BM_day_mask_contains);
+BENCHMARK(BM_time_range_loop);
+BENCHMARK(BM_day_mask_mask);
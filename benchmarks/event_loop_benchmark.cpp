@@ -0,0 +1,45 @@
+#include <random>
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+
+namespace
+{
+constexpr size_t SESSIONS = 1 << 12;
+
+const Instant START = Instant(1'641'168'000'000'000'000);
+
+EventLoop::Task heartbeat(EventLoop& loop, TimeDelta interval, size_t& beats)
+{
+    while (true)
+    {
+        co_await loop.after(interval);
+        beats++;
+    }
+}
+
+/**
+ * Runs a heartbeat every 10 to 1000 milliseconds for each session, for 10 simulated seconds.
+ */
+void BM_event_loop_heartbeats(benchmark::State& state)
+{
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<uint16_t> interval(10, 1'000);
+    std::vector<TimeDelta> intervals;
+    for (size_t i = 0; i < SESSIONS; ++i)
+        intervals.push_back(TimeDelta(0, 0, 0, 0, interval(rng)));
+
+    size_t beats = 0;
+    for (auto _ : state)
+    {
+        Instant::mock_instant = START;
+        EventLoop loop = EventLoop();
+        for (const TimeDelta& delay : intervals)
+            heartbeat(loop, delay, beats);
+        loop.run_until(START + TimeDelta(0, 0, 0, 10));
+    }
+    Instant::mock_instant.reset();
+    state.SetItemsProcessed(static_cast<int64_t>(beats));
+}
+}
+
+BENCHMARK(BM_event_loop_heartbeats);
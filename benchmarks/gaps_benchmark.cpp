@@ -0,0 +1,52 @@
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include "bench_util.h"
+
+namespace
+{
+constexpr size_t SIZE = 1 << 24;
+
+void BM_diff(benchmark::State& state)
+{
+    auto instants = sorted_instants(SIZE, 1'000);
+    std::vector<int64_t> out(SIZE);
+    for (auto _ : state)
+    {
+        diff(instants, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(SIZE * sizeof(Instant)));
+}
+
+void BM_find_gaps(benchmark::State& state)
+{
+    auto instants = sorted_instants(SIZE, 1'000);
+    // Roughly one gap every million 'Instants'.
+    TimeDelta max_gap = TimeDelta::from_nanoseconds(14'000);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(find_gaps(instants, max_gap));
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(SIZE * sizeof(Instant)));
+}
+
+void BM_datetime_subtraction_gaps(benchmark::State& state)
+{
+    std::vector<Datetime> datetimes;
+    for (Instant instant : sorted_instants(SIZE / 64, 1'000))
+        datetimes.push_back(Datetime::from_instant(instant, TZ::EST));
+    TimeDelta max_gap = TimeDelta::from_nanoseconds(14'000);
+    for (auto _ : state)
+    {
+        size_t gaps = 0;
+        for (size_t i = 1; i < datetimes.size(); ++i)
+            gaps += datetimes[i] - datetimes[i - 1] > max_gap;
+        benchmark::DoNotOptimize(gaps);
+    }
+    state.SetBytesProcessed(state.iterations()
+                            * static_cast<int64_t>(datetimes.size() * sizeof(Instant)));
+}
+}
+
+BENCHMARK(BM_diff)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_find_gaps)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_datetime_subtraction_gaps)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include <unordered_map>
+#include "bench_util.h"
+
+namespace
+{
+constexpr size_t SIZE = 1 << 16;
+
+/**
+ * Previous hash of 'Datetime', combining each component of its 'Date' and 'Time'.
+ */
+struct ComponentHash
+{
+    static void combine(size_t& seed, size_t value)
+    {
+        seed ^= value + 0x9E3779B9 + (seed << 6) + (seed >> 2);
+    }
+
+    size_t operator()(const Datetime& datetime) const
+    {
+        Date date = datetime.date();
+        Time time = datetime.time();
+        size_t date_seed = 0;
+        combine(date_seed, date.year);
+        combine(date_seed, date.month);
+        combine(date_seed, date.day);
+        size_t time_seed = 0;
+        combine(time_seed, time.hour);
+        combine(time_seed, time.minute);
+        combine(time_seed, time.second);
+        combine(time_seed, time.millisecond);
+        combine(time_seed, time.microsecond);
+        combine(time_seed, time.nanosecond);
+        combine(time_seed, static_cast<size_t>(time.timezone.utc_offset));
+        size_t seed = 0;
+        combine(seed, date_seed);
+        combine(seed, time_seed);
+        return seed;
+    }
+};
+
+std::vector<Datetime> datetimes()
+{
+    std::vector<Datetime> ret;
+    for (Instant instant : sorted_instants(SIZE, 1'000'000))
+        ret.push_back(Datetime::from_instant(instant, TZ::EST));
+    return ret;
+}
+
+template<typename Hash>
+void BM_hash(benchmark::State& state)
+{
+    std::vector<Datetime> keys = datetimes();
+    for (auto _ : state)
+    {
+        size_t total = 0;
+        for (const Datetime& key : keys)
+            total += Hash{}(key);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+
+template<typename Hash>
+void BM_unordered_map_insert(benchmark::State& state)
+{
+    std::vector<Datetime> keys = datetimes();
+    for (auto _ : state)
+    {
+        std::unordered_map<Datetime, int, Hash> map;
+        for (const Datetime& key : keys)
+            map[key]++;
+        benchmark::DoNotOptimize(map.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+
+template<typename Hash>
+void BM_unordered_map_find(benchmark::State& state)
+{
+    std::vector<Datetime> keys = datetimes();
+    std::unordered_map<Datetime, int, Hash> map;
+    for (const Datetime& key : keys)
+        map[key]++;
+    for (auto _ : state)
+    {
+        int total = 0;
+        for (const Datetime& key : keys)
+            total += map.find(key)->second;
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+}
+
+BENCHMARK(BM_hash<std::hash<Datetime>>);
+BENCHMARK(BM_hash<ComponentHash>);
+BENCHMARK(BM_unordered_map_insert<std::hash<Datetime>>);
+BENCHMARK(BM_unordered_map_insert<ComponentHash>);
+BENCHMARK(BM_unordered_map_find<std::hash<Datetime>>);
+BENCHMARK(BM_unordered_map_find<ComponentHash>);
@@ -0,0 +1,57 @@
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include <map>
+#include "bench_util.h"
+
+namespace
+{
+constexpr size_t SIZE = 1 << 22;
+
+DatetimeRange domain_of(const std::vector<Instant>& instants)
+{
+    return DatetimeRange(Datetime::from_instant(instants.front(), TZ::EST),
+                         Datetime::from_instant(instants.back(), TZ::EST));
+}
+
+void BM_histogram(benchmark::State& state)
+{
+    auto instants = sorted_instants(SIZE, 100'000);
+    DatetimeRange domain = domain_of(instants);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(histogram(instants, TimeDelta(0, 0, 0, 1), domain,
+                                           static_cast<unsigned>(state.range(0))));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+
+void BM_histogram_weighted(benchmark::State& state)
+{
+    auto instants = sorted_instants(SIZE, 100'000);
+    std::vector<double> weights(SIZE, 1.0);
+    DatetimeRange domain = domain_of(instants);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(histogram(instants, weights, TimeDelta(0, 0, 0, 1), domain));
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+
+void BM_map_datetime_counts(benchmark::State& state)
+{
+    std::vector<Datetime> datetimes;
+    for (Instant instant : sorted_instants(SIZE / 16, 1'600'000))
+        datetimes.push_back(Datetime::from_instant(instant, TZ::EST));
+    for (auto _ : state)
+    {
+        std::map<Datetime, int> counts;
+        for (const Datetime& datetime : datetimes)
+        {
+            Datetime second = datetime;
+            counts[second.floor(TimeComponent::SECOND)]++;
+        }
+        benchmark::DoNotOptimize(counts.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(datetimes.size()));
+}
+}
+
+BENCHMARK(BM_histogram)->Arg(1)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_histogram_weighted)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_map_datetime_counts)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,57 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include <random>
+
+namespace
+{
+constexpr size_t SIZE = 1 << 16;
+
+std::vector<TimeDelta> latencies()
+{
+    std::mt19937_64 rng(91);
+    std::lognormal_distribution<double> latency(10, 1);
+    std::vector<TimeDelta> ret;
+    for (size_t i = 0; i < SIZE; ++i)
+        ret.push_back(TimeDelta::from_nanoseconds(static_cast<int64_t>(latency(rng))));
+    return ret;
+}
+
+LatencyHistogram shared = LatencyHistogram();
+
+void BM_latency_histogram_record(benchmark::State& state)
+{
+    std::vector<TimeDelta> values = latencies();
+    for (auto _ : state)
+    {
+        for (TimeDelta value : values)
+            shared.record(value);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+
+void BM_latency_histogram_percentile(benchmark::State& state)
+{
+    LatencyHistogram histogram = LatencyHistogram();
+    for (TimeDelta value : latencies())
+        histogram.record(value);
+    for (auto _ : state)
+        benchmark::DoNotOptimize(histogram.percentile(99.9));
+}
+
+void BM_sorted_vector_percentile(benchmark::State& state)
+{
+    std::vector<TimeDelta> values = latencies();
+    for (auto _ : state)
+    {
+        std::vector<TimeDelta> sorted = values;
+        auto rank = sorted.begin() + static_cast<std::ptrdiff_t>(SIZE * 999 / 1000);
+        std::nth_element(sorted.begin(), rank, sorted.end());
+        benchmark::DoNotOptimize(*rank);
+    }
+}
+}
+
+BENCHMARK(BM_latency_histogram_record)->Threads(1)->Threads(4)->UseRealTime();
+BENCHMARK(BM_latency_histogram_percentile);
+BENCHMARK(BM_sorted_vector_percentile);
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include "bench_util.h"
+
+namespace
+{
+/**
+ * Gets a day of feed 'Instants' arriving slightly out of order.
+ */
+std::vector<Instant> shuffled_instants(size_t size)
+{
+    std::vector<Instant> instants = sorted_instants(size, 1'000);
+    std::mt19937_64 rng(4);
+    for (size_t i = 0; i + 64 < size; ++i)
+        std::swap(instants[i], instants[i + rng() % 64]);
+    std::shuffle(instants.begin(), instants.begin() + static_cast<std::ptrdiff_t>(size / 10),
+                 rng);
+    return instants;
+}
+
+void BM_radix_sort(benchmark::State& state)
+{
+    auto instants = shuffled_instants(static_cast<size_t>(state.range(0)));
+    auto threads = static_cast<unsigned>(state.range(1));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<Instant> copy = instants;
+        state.ResumeTiming();
+        radix_sort(copy, threads);
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_argsort(benchmark::State& state)
+{
+    auto instants = shuffled_instants(static_cast<size_t>(state.range(0)));
+    auto threads = static_cast<unsigned>(state.range(1));
+    for (auto _ : state)
+        benchmark::DoNotOptimize(argsort(instants, threads));
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_std_sort_int64(benchmark::State& state)
+{
+    std::vector<int64_t> values;
+    for (Instant instant : shuffled_instants(static_cast<size_t>(state.range(0))))
+        values.push_back(instant.nanoseconds);
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<int64_t> copy = values;
+        state.ResumeTiming();
+        std::sort(copy.begin(), copy.end());
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_std_sort_datetime(benchmark::State& state)
+{
+    std::vector<Datetime> datetimes;
+    for (Instant instant : shuffled_instants(static_cast<size_t>(state.range(0))))
+        datetimes.push_back(Datetime::from_instant(instant, TZ::EST));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<Datetime> copy = datetimes;
+        state.ResumeTiming();
+        std::sort(copy.begin(), copy.end());
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_radix_sort_datetime(benchmark::State& state)
+{
+    std::vector<Datetime> datetimes;
+    for (Instant instant : shuffled_instants(static_cast<size_t>(state.range(0))))
+        datetimes.push_back(Datetime::from_instant(instant, TZ::EST));
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<Datetime> copy = datetimes;
+        state.ResumeTiming();
+        radix_sort(std::span<Datetime>(copy), static_cast<unsigned>(state.range(1)));
+        benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+}
+
+// Args are {instants, threads}.
+BENCHMARK(BM_radix_sort)
+    ->Args({1 << 20, 1})
+    ->Args({100'000'000, 1})
+    ->Args({100'000'000, 8})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_argsort)
+    ->Args({1 << 20, 1})
+    ->Args({1 << 20, 8})
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_std_sort_int64)
+    ->Arg(1 << 20)
+    ->Arg(100'000'000)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_std_sort_datetime)
+    ->Arg(1 << 20)
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK(BM_radix_sort_datetime)
+    ->Args({1 << 20, 1})
+    ->Unit(benchmark::kMillisecond);
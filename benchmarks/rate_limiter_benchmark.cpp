@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <mutex>
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+
+namespace
+{
+/**
+ * Token bucket guarded by a mutex, refilled from the elapsed time on every acquire.
+ */
+class MutexTokenBucket
+{
+public:
+    MutexTokenBucket(double permits_per_second, double burst) :
+        rate(permits_per_second / 1e9), burst(burst), tokens(burst),
+        last(Instant::now().nanoseconds) {}
+
+    bool try_acquire()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        int64_t now = Instant::now().nanoseconds;
+        tokens = std::min(burst, tokens + static_cast<double>(now - last) * rate);
+        last = now;
+        if (tokens < 1)
+            return false;
+        tokens -= 1;
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+
+    double rate;
+
+    double burst;
+
+    double tokens;
+
+    int64_t last;
+};
+
+RateLimiter& shared_limiter()
+{
+    static RateLimiter limiter = RateLimiter(100'000'000, TimeDelta(0, 0, 0, 1), 1'000'000);
+    return limiter;
+}
+
+MutexTokenBucket& shared_bucket()
+{
+    static MutexTokenBucket bucket = MutexTokenBucket(100'000'000, 1'000'000);
+    return bucket;
+}
+
+void BM_rate_limiter_try_acquire(benchmark::State& state)
+{
+    RateLimiter& limiter = shared_limiter();
+    int64_t acquired = 0;
+    for (auto _ : state)
+        acquired += limiter.try_acquire();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["acquired"] = benchmark::Counter(static_cast<double>(acquired),
+                                                    benchmark::Counter::kAvgThreadsRate);
+}
+
+void BM_mutex_token_bucket_try_acquire(benchmark::State& state)
+{
+    MutexTokenBucket& bucket = shared_bucket();
+    int64_t acquired = 0;
+    for (auto _ : state)
+        acquired += bucket.try_acquire();
+    state.SetItemsProcessed(state.iterations());
+    state.counters["acquired"] = benchmark::Counter(static_cast<double>(acquired),
+                                                    benchmark::Counter::kAvgThreadsRate);
+}
+
+void BM_sliding_window_try_acquire(benchmark::State& state)
+{
+    SlidingWindowRateLimiter limiter = SlidingWindowRateLimiter(10'000, TimeDelta(0, 0, 0, 1));
+    Instant now = Instant::now();
+    for (auto _ : state)
+    {
+        // Advances 50 microseconds per acquire, so the window is always full.
+        now += TimeDelta::from_nanoseconds(50'000);
+        benchmark::DoNotOptimize(limiter.try_acquire(1, now));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+}
+
+BENCHMARK(BM_rate_limiter_try_acquire)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_mutex_token_bucket_try_acquire)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(BM_sliding_window_try_acquire);
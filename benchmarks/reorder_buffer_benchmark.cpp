@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include <queue>
+#include "bench_util.h"
+
+namespace
+{
+constexpr size_t SIZE = 1 << 20;
+
+constexpr int64_t MAX_DISORDER = 20'000;
+
+/**
+ * Gets 'Instants' in the order they arrive, each up to 'MAX_DISORDER' late.
+ */
+std::vector<Instant> arrival_order()
+{
+    std::vector<Instant> instants = sorted_instants(SIZE, 1'000);
+    std::mt19937_64 rng(6);
+    std::vector<std::pair<int64_t, Instant>> arrivals;
+    for (Instant instant : instants)
+        arrivals.emplace_back(instant.nanoseconds + static_cast<int64_t>(rng() % MAX_DISORDER),
+                              instant);
+    std::sort(arrivals.begin(), arrivals.end());
+    for (size_t i = 0; i < SIZE; ++i)
+        instants[i] = arrivals[i].second;
+    return instants;
+}
+
+void BM_reorder_buffer(benchmark::State& state)
+{
+    std::vector<Instant> instants = arrival_order();
+    for (auto _ : state)
+    {
+        ReorderBuffer<uint32_t> buffer = ReorderBuffer<uint32_t>(
+            TimeDelta::from_nanoseconds(MAX_DISORDER));
+        int64_t total = 0;
+        auto sum = [&total](Instant instant, uint32_t) { total += instant.nanoseconds; };
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            buffer.push(instants[i], static_cast<uint32_t>(i));
+            buffer.drain(sum);
+        }
+        buffer.flush(sum);
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+
+void BM_priority_queue_datetime(benchmark::State& state)
+{
+    std::vector<Datetime> datetimes;
+    for (Instant instant : arrival_order())
+        datetimes.push_back(Datetime::from_instant(instant, TZ::EST));
+    TimeDelta max_disorder = TimeDelta::from_nanoseconds(MAX_DISORDER);
+
+    for (auto _ : state)
+    {
+        std::priority_queue<Datetime, std::vector<Datetime>, std::greater<>> queue;
+        Datetime latest = datetimes.front();
+        size_t released = 0;
+        for (const Datetime& datetime : datetimes)
+        {
+            queue.push(datetime);
+            if (datetime > latest)
+                latest = datetime;
+            while (!queue.empty() && queue.top() <= latest - max_disorder)
+            {
+                queue.pop();
+                released++;
+            }
+        }
+        benchmark::DoNotOptimize(released);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+}
+
+BENCHMARK(BM_reorder_buffer)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_priority_queue_datetime)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include "bench_util.h"
+
+namespace
+{
+/**
+ * Pushes one second of events arriving at 10M per second through a 500 millisecond window.
+ */
+template<typename Window>
+void push_events(benchmark::State& state)
+{
+    constexpr size_t EVENTS = 10'000'000;
+    auto instants = sorted_instants(EVENTS, 100);
+    std::vector<int64_t> values(EVENTS);
+    for (size_t i = 0; i < EVENTS; ++i)
+        values[i] = static_cast<int64_t>(i * 7919 % 1000);
+
+    for (auto _ : state)
+    {
+        Window window = Window(TimeDelta(0, 0, 0, 0, 500));
+        for (size_t i = 0; i < EVENTS; ++i)
+            window.push(instants[i], values[i]);
+        benchmark::DoNotOptimize(window.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(EVENTS));
+}
+
+void BM_rolling_count(benchmark::State& state)
+{
+    push_events<RollingWindow<int64_t, CountAggregation<int64_t>>>(state);
+}
+
+void BM_rolling_sum(benchmark::State& state)
+{
+    push_events<RollingWindow<int64_t, SumAggregation<int64_t>>>(state);
+}
+
+void BM_rolling_min_max(benchmark::State& state)
+{
+    push_events<RollingWindow<int64_t, MinAggregation<int64_t>, MaxAggregation<int64_t>>>(state);
+}
+
+/**
+ * Baseline that finds the start of the window by comparing 'Datetimes' and sums the window
+ * again for every event.
+ */
+void BM_rescan_datetime(benchmark::State& state)
+{
+    constexpr size_t EVENTS = 20'000;
+    std::vector<Datetime> datetimes;
+    for (Instant instant : sorted_instants(EVENTS, 100))
+        datetimes.push_back(Datetime::from_instant(instant, TZ::EST));
+    std::vector<int64_t> values(EVENTS);
+    for (size_t i = 0; i < EVENTS; ++i)
+        values[i] = static_cast<int64_t>(i * 7919 % 1000);
+    TimeDelta width = TimeDelta::from_nanoseconds(500'000);
+
+    for (auto _ : state)
+    {
+        size_t start = 0;
+        int64_t total = 0;
+        for (size_t i = 0; i < EVENTS; ++i)
+        {
+            Datetime window_start = datetimes[i] - width;
+            while (datetimes[start] <= window_start)
+                start++;
+            for (size_t j = start; j <= i; ++j)
+                total += values[j];
+        }
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(EVENTS));
+}
+}
+
+BENCHMARK(BM_rolling_count)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_rolling_sum)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_rolling_min_max)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_rescan_datetime)->Unit(benchmark::kMillisecond);
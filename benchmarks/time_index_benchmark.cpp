@@ -0,0 +1,84 @@
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include "bench_util.h"
+
+namespace
+{
+/**
+ * Gets 'count' random 'Instants' between the first and last of 'instants'.
+ */
+std::vector<Instant> random_queries(const std::vector<Instant>& instants, size_t count)
+{
+    std::mt19937_64 rng(3);
+    std::uniform_int_distribution<int64_t> value(instants.front().nanoseconds,
+                                                 instants.back().nanoseconds);
+    std::vector<Instant> queries(count);
+    for (Instant& query : queries)
+        query = Instant(value(rng));
+    return queries;
+}
+
+void BM_time_index_lower_bound(benchmark::State& state)
+{
+    auto instants = sorted_instants(static_cast<size_t>(state.range(0)), 1'000'000);
+    auto queries = random_queries(instants, 1 << 16);
+    TimeIndex index = TimeIndex(instants, state.range(1) != 0);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(index.lower_bound(queries[i++ & (queries.size() - 1)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_std_lower_bound_instant(benchmark::State& state)
+{
+    auto instants = sorted_instants(static_cast<size_t>(state.range(0)), 1'000'000);
+    auto queries = random_queries(instants, 1 << 16);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::lower_bound(instants.begin(), instants.end(),
+                                                  queries[i++ & (queries.size() - 1)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_std_lower_bound_datetime(benchmark::State& state)
+{
+    auto instants = sorted_instants(static_cast<size_t>(state.range(0)), 1'000'000);
+    std::vector<Datetime> datetimes;
+    datetimes.reserve(instants.size());
+    for (Instant instant : instants)
+        datetimes.push_back(Datetime::from_instant(instant, TZ::EST));
+
+    std::vector<Datetime> queries;
+    for (Instant query : random_queries(instants, 1 << 16))
+        queries.push_back(Datetime::from_instant(query, TZ::EST));
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(std::lower_bound(datetimes.begin(), datetimes.end(),
+                                                  queries[i++ & (queries.size() - 1)]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+}
+
+// Args are {instants, sampled}.
+BENCHMARK(BM_time_index_lower_bound)
+    ->Args({1 << 16, 1})
+    ->Args({1 << 24, 0})
+    ->Args({1 << 24, 1});
+
+BENCHMARK(BM_std_lower_bound_instant)
+    ->Arg(1 << 16)
+    ->Arg(1 << 24);
+
+BENCHMARK(BM_std_lower_bound_datetime)
+    ->Arg(1 << 16)
+    ->Arg(1 << 24);
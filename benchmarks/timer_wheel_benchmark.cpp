@@ -0,0 +1,107 @@
+#include <map>
+#include <random>
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+
+namespace
+{
+constexpr size_t TIMERS = 1 << 15;
+
+const Instant START = Instant(1'641'168'000'000'000'000);
+
+/**
+ * Deadlines of order timeouts and heartbeats, up to 30 seconds after 'START'.
+ */
+std::vector<Instant> deadlines()
+{
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<int64_t> offset(0, 30'000'000'000);
+    std::vector<Instant> ret;
+    for (size_t i = 0; i < TIMERS; ++i)
+        ret.push_back(Instant(START.nanoseconds + offset(rng)));
+    return ret;
+}
+
+void BM_timer_wheel_schedule_cancel(benchmark::State& state)
+{
+    std::vector<Instant> instants = deadlines();
+    TimerWheel<size_t> wheel = TimerWheel<size_t>(TimeDelta(0, 0, 0, 0, 1), START);
+    std::vector<TimerWheel<size_t>::TimerId> ids(TIMERS);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < TIMERS; ++i)
+            ids[i] = wheel.schedule(instants[i], i);
+        for (TimerWheel<size_t>::TimerId id : ids)
+            wheel.cancel(id);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(TIMERS));
+}
+
+void BM_multimap_insert_erase(benchmark::State& state)
+{
+    std::vector<Datetime> datetimes;
+    for (Instant instant : deadlines())
+        datetimes.push_back(Datetime::from_instant(instant, TZ::EST));
+    std::multimap<Datetime, size_t> timers;
+    std::vector<std::multimap<Datetime, size_t>::iterator> ids(TIMERS);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < TIMERS; ++i)
+            ids[i] = timers.emplace(datetimes[i], i);
+        for (auto id : ids)
+            timers.erase(id);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(TIMERS));
+}
+
+/**
+ * Schedules the timers, then expires them with a tick every millisecond for 30 seconds.
+ */
+void BM_timer_wheel_expire(benchmark::State& state)
+{
+    std::vector<Instant> instants = deadlines();
+    for (auto _ : state)
+    {
+        TimerWheel<size_t> wheel = TimerWheel<size_t>(TimeDelta(0, 0, 0, 0, 1), START);
+        for (size_t i = 0; i < TIMERS; ++i)
+            wheel.schedule(instants[i], i);
+
+        size_t sum = 0;
+        for (Instant now = START; !wheel.empty(); now += TimeDelta(0, 0, 0, 0, 1))
+            wheel.tick(now, [&sum](size_t value) { sum += value; });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(TIMERS));
+}
+
+void BM_multimap_expire(benchmark::State& state)
+{
+    std::vector<Datetime> datetimes;
+    for (Instant instant : deadlines())
+        datetimes.push_back(Datetime::from_instant(instant, TZ::EST));
+    for (auto _ : state)
+    {
+        std::multimap<Datetime, size_t> timers;
+        for (size_t i = 0; i < TIMERS; ++i)
+            timers.emplace(datetimes[i], i);
+
+        size_t sum = 0;
+        for (Instant now = START; !timers.empty(); now += TimeDelta(0, 0, 0, 0, 1))
+        {
+            Datetime datetime = Datetime::from_instant(now, TZ::EST);
+            while (!timers.empty() && timers.begin()->first <= datetime)
+            {
+                sum += timers.begin()->second;
+                timers.erase(timers.begin());
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(TIMERS));
+}
+}
+
+BENCHMARK(BM_timer_wheel_schedule_cancel);
+BENCHMARK(BM_multimap_insert_erase);
+BENCHMARK(BM_timer_wheel_expire);
+BENCHMARK(BM_multimap_expire);
@@ -0,0 +1,83 @@
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+#include <queue>
+#include "bench_util.h"
+
+namespace
+{
+constexpr size_t SIZE = 1 << 20;
+
+/**
+ * Splits 'SIZE' sorted 'Instants' across 'count' streams at random.
+ */
+std::vector<std::vector<Instant>> split(size_t count)
+{
+    std::vector<std::vector<Instant>> ret(count);
+    std::mt19937_64 rng(89);
+    for (Instant instant : sorted_instants(SIZE, 1'000))
+        ret[rng() % count].push_back(instant);
+    return ret;
+}
+
+void BM_timestamp_merger(benchmark::State& state)
+{
+    std::vector<std::vector<Instant>> columns = split(static_cast<size_t>(state.range(0)));
+    std::vector<std::vector<uint32_t>> values;
+    for (const std::vector<Instant>& column : columns)
+        values.emplace_back(column.size());
+
+    for (auto _ : state)
+    {
+        std::vector<SpanStream<uint32_t>> streams;
+        for (size_t s = 0; s < columns.size(); ++s)
+            streams.emplace_back(columns[s], values[s]);
+        std::vector<TimestampStream<uint32_t>*> pointers;
+        for (SpanStream<uint32_t>& stream : streams)
+            pointers.push_back(&stream);
+
+        TimestampMerger<uint32_t> merger = TimestampMerger<uint32_t>(pointers);
+        int64_t total = 0;
+        merger.drain([&total](Instant instant, size_t, uint32_t) { total += instant.nanoseconds; });
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+
+void BM_priority_queue_datetime(benchmark::State& state)
+{
+    std::vector<std::vector<Datetime>> columns;
+    for (const std::vector<Instant>& column : split(static_cast<size_t>(state.range(0))))
+    {
+        columns.emplace_back();
+        for (Instant instant : column)
+            columns.back().push_back(Datetime::from_instant(instant, TZ::EST));
+    }
+
+    for (auto _ : state)
+    {
+        using Head = std::pair<Datetime, size_t>;
+        std::priority_queue<Head, std::vector<Head>, std::greater<>> queue;
+        std::vector<size_t> positions(columns.size());
+        for (size_t s = 0; s < columns.size(); ++s)
+        {
+            if (!columns[s].empty())
+                queue.emplace(columns[s][0], s);
+        }
+        size_t merged = 0;
+        while (!queue.empty())
+        {
+            size_t s = queue.top().second;
+            queue.pop();
+            merged++;
+            if (++positions[s] < columns[s].size())
+                queue.emplace(columns[s][positions[s]], s);
+        }
+        benchmark::DoNotOptimize(merged);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(SIZE));
+}
+}
+
+BENCHMARK(BM_timestamp_merger)->RangeMultiplier(4)->Range(2, 1024)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_priority_queue_datetime)->RangeMultiplier(4)->Range(2, 1024)
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,86 @@
+#include <random>
+#include <unordered_map>
+#include <benchmark/benchmark.h>
+#include <datetime/datetime.h>
+
+namespace
+{
+constexpr size_t KEYS = 1 << 12;
+
+constexpr size_t LOOKUPS = 1 << 16;
+
+std::vector<uint64_t> lookups()
+{
+    std::mt19937_64 rng(1);
+    std::uniform_int_distribution<uint64_t> key(0, 2 * KEYS - 1);
+    std::vector<uint64_t> ret;
+    for (size_t i = 0; i < LOOKUPS; ++i)
+        ret.push_back(key(rng));
+    return ret;
+}
+
+void BM_ttl_cache_find(benchmark::State& state)
+{
+    std::vector<uint64_t> keys = lookups();
+    CoarseClock clock = CoarseClock();
+    TtlCache<uint64_t, double> cache = TtlCache<uint64_t, double>(TimeDelta(0, 1), clock);
+    for (uint64_t key = 0; key < KEYS; ++key)
+        cache.insert_or_assign(key, static_cast<double>(key));
+    for (auto _ : state)
+    {
+        clock.update();
+        double sum = 0;
+        for (uint64_t key : keys)
+            if (const double* value = cache.find(key))
+                sum += *value;
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LOOKUPS));
+}
+
+/**
+ * Stores the 'Datetime' of insertion and compares it with 'Datetime::now()' on every lookup.
+ */
+void BM_datetime_stamp_find(benchmark::State& state)
+{
+    std::vector<uint64_t> keys = lookups();
+    std::unordered_map<uint64_t, std::pair<double, Datetime>> cache;
+    for (uint64_t key = 0; key < KEYS; ++key)
+        cache.emplace(key, std::make_pair(static_cast<double>(key), Datetime::now()));
+    TimeDelta ttl = TimeDelta(0, 1);
+    for (auto _ : state)
+    {
+        double sum = 0;
+        for (uint64_t key : keys)
+        {
+            auto it = cache.find(key);
+            if (it != cache.end() && Datetime::now() < it->second.second + ttl)
+                sum += it->second.first;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LOOKUPS));
+}
+
+void BM_ttl_cache_insert(benchmark::State& state)
+{
+    std::vector<uint64_t> keys = lookups();
+    Instant start = Instant::now();
+    CoarseClock clock = CoarseClock(start);
+    TtlCache<uint64_t, double> cache = TtlCache<uint64_t, double>(TimeDelta(0, 0, 0, 1), clock);
+    int64_t step = 0;
+    for (auto _ : state)
+    {
+        // Every pass is 100 milliseconds, so entries expire after 10 passes.
+        clock.update(Instant(start.nanoseconds + 100'000'000 * ++step));
+        for (uint64_t key : keys)
+            cache.insert_or_assign(key, static_cast<double>(key));
+        benchmark::DoNotOptimize(cache.size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(LOOKUPS));
+}
+}
+
+BENCHMARK(BM_ttl_cache_find);
+BENCHMARK(BM_datetime_stamp_find);
+BENCHMARK(BM_ttl_cache_insert);
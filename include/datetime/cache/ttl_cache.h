@@ -0,0 +1,298 @@
+#ifndef DATETIME_TTL_CACHE_H
+#define DATETIME_TTL_CACHE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <fmt/format.h>
+#include "datetime/instant/coarse_clock.h"
+#include "datetime/instant/instant.h"
+#include "datetime/schedule/timer_wheel.h"
+#include "datetime/timedelta/timedelta.h"
+#include "../../../src/util/constant_divider.h"
+#include "../../../src/util/macros.h"
+
+/**
+ * Map whose entries expire a fixed time to live after they are inserted, such as cached
+ * reference data or session lookups.
+ *
+ * Time is read from a shared 'CoarseClock' and divided into ticks of 'resolution'. Each entry
+ * stores the tick it expires at as 32 bits relative to the tick the cache was created at, so
+ * checking an entry is a load of the clock, a multiplication and a comparison, instead of a
+ * 'Datetime::now()' and a component comparison. Ticks are compared with wrapping arithmetic,
+ * so the cache keeps working after the relative ticks overflow.
+ *
+ * Expired entries are removed lazily, in the buckets of a 'TimerWheel' that is advanced when
+ * an entry is inserted or by 'evict_expired', so 'find' only removes the expired entry it
+ * finds. A cache that is only read is advanced by 'find' every 2^30 ticks.
+ * A cache is not thread safe, but the 'CoarseClock' may be updated by another thread.
+ *
+ * @tparam K type of the keys.
+ * @tparam V type of the values.
+ * @tparam Hash hash function of the keys.
+ *
+ * @example
+ * CoarseClock clock = CoarseClock();
+ * TtlCache<std::string, Instrument> instruments = TtlCache<std::string, Instrument>(
+ *     TimeDelta(0, 0, 5), clock);
+ * instruments.insert_or_assign("ESH2", instrument);
+ * ...
+ * clock.update();
+ * if (const Instrument* cached = instruments.find("ESH2"))
+ *     quote(*cached);
+ */
+template<typename K, typename V, typename Hash = std::hash<K>>
+class TtlCache
+{
+    /**
+     * Ticks after which expired entries are evicted even if nothing is inserted, so that the
+     * expiry of every entry is within 2^31 ticks of the current tick and its 32 bit stamp
+     * compares correctly.
+     */
+    static constexpr int64_t MAX_EVICTION_LAG = int64_t(1) << 30;
+
+public:
+
+    /**
+     * Creates an empty 'TtlCache'.
+     *
+     * @param ttl time from the insertion of an entry to its expiry, rounded up to a tick.
+     * @param clock clock the cache reads the time from, which must outlive the cache.
+     * @param resolution duration of a tick. (default 1 millisecond)
+     *
+     * @throws std::invalid_argument if 'resolution' is not positive, or if 'ttl' is not
+     * positive or is 2^31 ticks or more.
+     */
+    TtlCache(const TimeDelta& ttl, const CoarseClock& clock,
+             TimeDelta resolution = TimeDelta(0, 0, 0, 0, 1)) :
+        clock(clock),
+        evictions(resolution, clock.now()),
+        tick_divider(static_cast<uint64_t>(resolution.total_nanoseconds())),
+        epoch_tick(tick_divider.floor_divide(clock.now().nanoseconds)),
+        ttl_ticks(ticks_of(ttl, resolution)),
+        evicted_tick(epoch_tick) {}
+
+    /**
+     * Inserts 'value' for 'key', or replaces the value of 'key', and restarts its time to
+     * live. Entries that have expired are evicted first.
+     *
+     * @param key key of the entry.
+     * @param value value of the entry.
+     *
+     * @return 'true' if 'key' had no entry, 'false' if its entry was replaced.
+     */
+    bool insert_or_assign(const K& key, V value)
+    {
+        Instant now = clock.now();
+        evict(now);
+
+        int64_t expiry = tick_divider.floor_divide(now.nanoseconds) + ttl_ticks;
+        typename TimerWheel<K>::TimerId timer = evictions.schedule(
+            Instant(expiry * static_cast<int64_t>(tick_divider.get_divisor())), key);
+        auto stamp = static_cast<uint32_t>(expiry - epoch_tick);
+
+        auto it = entries.find(key);
+        if (it == entries.end())
+        {
+            entries.emplace(key, Entry{std::move(value), stamp, timer});
+            return true;
+        }
+        evictions.cancel(it->second.timer);
+        it->second = Entry{std::move(value), stamp, timer};
+        return false;
+    }
+
+    /**
+     * Gets the value of 'key' if it has not expired. An expired entry is removed.
+     *
+     * @param key key to get the value of.
+     *
+     * @return pointer to the value of 'key', valid until the entry is replaced or removed,
+     * or 'nullptr' if 'key' has no entry or it has expired.
+     */
+    V* find(const K& key)
+    {
+        int64_t now = current_tick();
+        auto it = entries.find(key);
+        if (it == entries.end())
+        {
+            miss_count++;
+            return nullptr;
+        }
+        if (is_expired(it->second, now))
+        {
+            remove(it);
+            expiration_count++;
+            miss_count++;
+            return nullptr;
+        }
+        hit_count++;
+        return &it->second.value;
+    }
+
+    /**
+     * Removes the entry of 'key'.
+     *
+     * @param key key to remove.
+     *
+     * @return 'true' if 'key' had an entry that had not expired, 'false' otherwise.
+     */
+    bool erase(const K& key)
+    {
+        int64_t now = current_tick();
+        auto it = entries.find(key);
+        if (it == entries.end())
+            return false;
+
+        bool expired = is_expired(it->second, now);
+        remove(it);
+        expiration_count += expired;
+        return !expired;
+    }
+
+    /**
+     * Removes the entries that have expired.
+     *
+     * @return the number of removed entries.
+     */
+    size_t evict_expired()
+    {
+        return evict(clock.now());
+    }
+
+    /**
+     * Gets the number of entries, including expired entries that have not been removed yet.
+     *
+     * @return the number of entries.
+     */
+    size_t size() const
+    {
+        return entries.size();
+    }
+
+    /**
+     * Gets the number of calls to 'find' that returned a value.
+     *
+     * @return the number of hits.
+     */
+    uint64_t hits() const
+    {
+        return hit_count;
+    }
+
+    /**
+     * Gets the number of calls to 'find' that returned 'nullptr', including for expired
+     * entries.
+     *
+     * @return the number of misses.
+     */
+    uint64_t misses() const
+    {
+        return miss_count;
+    }
+
+    /**
+     * Gets the number of entries removed because they expired.
+     *
+     * @return the number of expirations.
+     */
+    uint64_t expirations() const
+    {
+        return expiration_count;
+    }
+
+private:
+
+    struct Entry
+    {
+        V value;
+
+        /**
+         * Tick the entry expires at, relative to 'epoch_tick' modulo 2^32.
+         */
+        uint32_t expiry;
+
+        typename TimerWheel<K>::TimerId timer;
+    };
+
+    const CoarseClock& clock;
+
+    /**
+     * Timer of each entry, keyed by the tick it expires at.
+     */
+    TimerWheel<K> evictions;
+
+    ConstantDivider tick_divider;
+
+    /**
+     * Tick the cache was created at.
+     */
+    int64_t epoch_tick;
+
+    int64_t ttl_ticks;
+
+    /**
+     * Tick of the last eviction, before which no entry expires.
+     */
+    int64_t evicted_tick;
+
+    std::unordered_map<K, Entry, Hash> entries;
+
+    uint64_t hit_count = 0;
+
+    uint64_t miss_count = 0;
+
+    uint64_t expiration_count = 0;
+
+    /**
+     * Gets the number of ticks of 'ttl', rounded up.
+     */
+    static int64_t ticks_of(const TimeDelta& ttl, const TimeDelta& resolution)
+    {
+        int64_t nanoseconds = ttl.total_nanoseconds();
+        int64_t tick = resolution.total_nanoseconds();
+        ASSERT(nanoseconds > 0 && (nanoseconds - 1) / tick < std::numeric_limits<int32_t>::max(),
+               std::invalid_argument(fmt::format("ttl '{}' must be positive and less than 2^31 "
+                                                 "ticks of '{}' nanoseconds", nanoseconds, tick)));
+        return (nanoseconds - 1) / tick + 1;
+    }
+
+    /**
+     * Gets the current tick, evicting expired entries first if the last eviction was
+     * 'MAX_EVICTION_LAG' ticks ago.
+     */
+    int64_t current_tick()
+    {
+        Instant now = clock.now();
+        int64_t tick = tick_divider.floor_divide(now.nanoseconds);
+        if (tick - evicted_tick >= MAX_EVICTION_LAG)
+            evict(now);
+        return tick;
+    }
+
+    bool is_expired(const Entry& entry, int64_t now) const
+    {
+        return static_cast<int32_t>(entry.expiry - static_cast<uint32_t>(now - epoch_tick)) <= 0;
+    }
+
+    void remove(typename std::unordered_map<K, Entry, Hash>::iterator it)
+    {
+        evictions.cancel(it->second.timer);
+        entries.erase(it);
+    }
+
+    size_t evict(Instant now)
+    {
+        size_t evicted = evictions.tick(now, [this](K& key) { entries.erase(key); });
+        evicted_tick = std::max(evicted_tick, tick_divider.floor_divide(now.nanoseconds));
+        expiration_count += evicted;
+        return evicted;
+    }
+};
+
+#endif //DATETIME_TTL_CACHE_H
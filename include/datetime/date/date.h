@@ -5,6 +5,7 @@
 #include "datetime/date/components/days.h"
 #include "datetime/time/time.h"
 #include <fmt/format.h>
+#include <../../../src/util/hash.h>
 #include <../../../src/util/macros.h>
 #include <stringhelpers/stringhelpers.h>
 #include "date_component.h"
@@ -171,6 +172,30 @@ public:
      */
     static size_t max_days_in_month(uint8_t month_idx, std::optional<uint16_t> year = {});
 
+    /**
+     * Gets the number of days between 'EPOCH' and this 'Date'.
+     *
+     * @return number of days since 'EPOCH'.
+     *
+     * @example
+     * Date date = Date(1970, 1, 11);
+     * std::cout << date.days_since_epoch();
+     *
+     * // output: 10
+     */
+    int64_t days_since_epoch() const;
+
+    /**
+     * Creates the 'Date' that is 'days' days after 'EPOCH'.
+     *
+     * @param days number of days since 'EPOCH'.
+     *
+     * @return 'Date' that is 'days' days after 'EPOCH'.
+     *
+     * @throws std::invalid_argument if the resulting 'Date' is invalid.
+     */
+    static Date from_days_since_epoch(int64_t days);
+
     /**
      * Adds 'days' to this 'Date'.
      *
@@ -420,13 +445,12 @@ Date::Date(std::string_view string, DateComponents... date_components)
            std::invalid_argument(fmt::format("'{}' is an invalid date", Date::to_string())));
 }
 
+/**
+ * Hashes 'date' by its days since 'Date::EPOCH'.
+ */
 inline size_t hash_value(const Date& date)
 {
-    size_t seed = 0;
-    boost::hash_combine(seed, date.year);
-    boost::hash_combine(seed, date.month);
-    boost::hash_combine(seed, date.day);
-    return seed;
+    return static_cast<size_t>(mix_hash(static_cast<uint64_t>(date.days_since_epoch())));
 }
 
 namespace std
@@ -0,0 +1,479 @@
+#ifndef DATETIME_DATE_MAP_H
+#define DATETIME_DATE_MAP_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fmt/format.h>
+#include "datetime/date/date.h"
+#include "datetime/date/date_range.h"
+#include "../../../src/util/macros.h"
+
+/**
+ * How a 'DateMap' stores its values.
+ */
+enum class DateMapStorage
+{
+    /**
+     * A value for every day of the range, for maps where most days have a value.
+     */
+    DENSE,
+
+    /**
+     * Pages of 64 days allocated when a day in them is first set, for maps where few days
+     * have a value, such as holidays.
+     */
+    PAGED
+};
+
+/**
+ * Map from the 'Dates' of a 'DateRange' to values, such as daily fixings or holiday flags.
+ *
+ * Values are stored in an array indexed by days since the start of the range, with a bit per
+ * day marking the days that have a value. A lookup is the days since 'Date::EPOCH' of the
+ * key, a subtraction and a load, and iteration scans the bits in date order.
+ *
+ * @tparam T type of the values, which must be default constructible.
+ *
+ * @example
+ * DateMap<double> fixings = DateMap<double>(DateRange(Date(2022, 1, 1), Date(2022, 12, 31)));
+ * fixings[Date(2022, 1, 3)] = 1.1318;
+ * if (const double* fixing = fixings.find(trade_date))
+ *     convert(*fixing);
+ */
+template<typename T>
+class DateMap
+{
+    /**
+     * Number of days in a page and in a word of 'present'.
+     */
+    static constexpr size_t PAGE_SIZE = 64;
+
+    using Page = std::array<T, PAGE_SIZE>;
+
+public:
+
+    /**
+     * Iterates the days with a value in date order.
+     */
+    template<bool Const>
+    class Iterator
+    {
+        using Map = std::conditional_t<Const, const DateMap, DateMap>;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<Date, std::conditional_t<Const, const T&, T&>>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = value_type;
+
+        Iterator() = default;
+
+        Iterator(Map* map, size_t offset, size_t end) :
+            map(map), offset(map->next_present(offset, end)), end(end) {}
+
+        reference operator*() const
+        {
+            return {Date::from_days_since_epoch(map->first_day + static_cast<int64_t>(offset)),
+                    map->value_at(offset)};
+        }
+
+        Iterator& operator++()
+        {
+            offset = map->next_present(offset + 1, end);
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator ret = *this;
+            ++(*this);
+            return ret;
+        }
+
+        bool operator==(const Iterator& other) const
+        {
+            return offset == other.offset;
+        }
+
+    private:
+        Map* map = nullptr;
+
+        size_t offset = 0;
+
+        size_t end = 0;
+    };
+
+    using iterator = Iterator<false>;
+
+    using const_iterator = Iterator<true>;
+
+    /**
+     * Days with a value within part of a 'DateMap'.
+     */
+    template<bool Const>
+    class Slice
+    {
+    public:
+        Slice(Iterator<Const> first, Iterator<Const> last) :
+            first(first), last(last) {}
+
+        Iterator<Const> begin() const
+        {
+            return first;
+        }
+
+        Iterator<Const> end() const
+        {
+            return last;
+        }
+
+    private:
+        Iterator<Const> first;
+
+        Iterator<Const> last;
+    };
+
+    /**
+     * Creates an empty 'DateMap' of the days in 'range'.
+     *
+     * @param range days that may have a value.
+     * @param storage how to store the values. (default DENSE)
+     */
+    explicit DateMap(const DateRange& range, DateMapStorage storage = DateMapStorage::DENSE) :
+        first_day(range.start.days_since_epoch()),
+        day_count(static_cast<size_t>(range.end.days_since_epoch() - first_day + 1)),
+        present((day_count + PAGE_SIZE - 1) / PAGE_SIZE)
+    {
+        if (storage == DateMapStorage::DENSE)
+            values = std::make_unique<T[]>(day_count);
+        else
+            pages.resize(present.size());
+    }
+
+    DateMap(const DateMap& other) :
+        first_day(other.first_day),
+        day_count(other.day_count),
+        count(other.count),
+        present(other.present),
+        pages(other.pages.size())
+    {
+        if (other.values)
+        {
+            values = std::make_unique<T[]>(day_count);
+            std::copy(other.values.get(), other.values.get() + day_count, values.get());
+        }
+        for (size_t p = 0; p < pages.size(); ++p)
+        {
+            if (other.pages[p])
+                pages[p] = std::make_unique<Page>(*other.pages[p]);
+        }
+    }
+
+    /**
+     * Moves the values of 'other' into a new 'DateMap', leaving 'other' with no days, so every
+     * 'Date' is outside its range.
+     */
+    DateMap(DateMap&& other) noexcept :
+        first_day(other.first_day),
+        day_count(std::exchange(other.day_count, 0)),
+        count(std::exchange(other.count, 0)),
+        present(std::move(other.present)),
+        values(std::move(other.values)),
+        pages(std::move(other.pages)) {}
+
+    DateMap& operator=(DateMap other) noexcept
+    {
+        std::swap(first_day, other.first_day);
+        std::swap(day_count, other.day_count);
+        std::swap(count, other.count);
+        std::swap(present, other.present);
+        std::swap(values, other.values);
+        std::swap(pages, other.pages);
+        return *this;
+    }
+
+    /**
+     * Gets the value of 'date', which is default constructed if 'date' has no value.
+     *
+     * @param date day to get the value of.
+     *
+     * @return reference to the value of 'date'.
+     *
+     * @throws std::invalid_argument if 'date' is outside the range of this map.
+     */
+    T& operator[](const Date& date)
+    {
+        size_t offset = checked_offset(date);
+        uint64_t& word = present[offset / PAGE_SIZE];
+        uint64_t bit = uint64_t(1) << (offset % PAGE_SIZE);
+        if (!(word & bit))
+        {
+            if (!pages.empty() && !pages[offset / PAGE_SIZE])
+                pages[offset / PAGE_SIZE] = std::make_unique<Page>();
+            word |= bit;
+            count++;
+        }
+        return value_at(offset);
+    }
+
+    /**
+     * Sets the value of 'date'.
+     *
+     * @param date day to set the value of.
+     * @param value value to set.
+     *
+     * @return 'true' if 'date' had no value, 'false' if its value was replaced.
+     *
+     * @throws std::invalid_argument if 'date' is outside the range of this map.
+     */
+    bool insert_or_assign(const Date& date, T value)
+    {
+        size_t previous = count;
+        (*this)[date] = std::move(value);
+        return count != previous;
+    }
+
+    /**
+     * Gets the value of 'date'.
+     *
+     * @param date day to get the value of.
+     *
+     * @return pointer to the value of 'date', or 'nullptr' if 'date' has no value or is
+     * outside the range of this map.
+     */
+    T* find(const Date& date)
+    {
+        return const_cast<T*>(std::as_const(*this).find(date));
+    }
+
+    /**
+     * @see find(const Date&)
+     */
+    const T* find(const Date& date) const
+    {
+        // Days before the start wrap around to large offsets.
+        auto offset = static_cast<size_t>(date.days_since_epoch() - first_day);
+        if (offset >= day_count || !is_present(offset))
+            return nullptr;
+        return &value_at(offset);
+    }
+
+    /**
+     * Gets the value of 'date'.
+     *
+     * @param date day to get the value of.
+     *
+     * @return reference to the value of 'date'.
+     *
+     * @throws std::invalid_argument if 'date' has no value.
+     */
+    const T& at(const Date& date) const
+    {
+        const T* value = find(date);
+        ASSERT(value != nullptr,
+               std::invalid_argument(fmt::format("date '{}' has no value", date.to_string())));
+        return *value;
+    }
+
+    /**
+     * Checks if 'date' has a value.
+     *
+     * @param date day to check.
+     *
+     * @return 'true' if 'date' has a value, 'false' otherwise.
+     */
+    bool contains(const Date& date) const
+    {
+        return find(date) != nullptr;
+    }
+
+    /**
+     * Removes the value of 'date'.
+     *
+     * @param date day to remove the value of.
+     *
+     * @return 'true' if 'date' had a value, 'false' otherwise.
+     */
+    bool erase(const Date& date)
+    {
+        auto offset = static_cast<size_t>(date.days_since_epoch() - first_day);
+        if (offset >= day_count || !is_present(offset))
+            return false;
+
+        value_at(offset) = T();
+        uint64_t& word = present[offset / PAGE_SIZE];
+        word &= ~(uint64_t(1) << (offset % PAGE_SIZE));
+        if (!pages.empty() && word == 0)
+            pages[offset / PAGE_SIZE].reset();
+        count--;
+        return true;
+    }
+
+    /**
+     * Gets the number of days with a value.
+     *
+     * @return the number of days with a value.
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * Checks if no day has a value.
+     *
+     * @return 'true' if no day has a value, 'false' otherwise.
+     */
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * Gets the days that may have a value.
+     *
+     * @return the range of this map.
+     */
+    DateRange range() const
+    {
+        return DateRange(Date::from_days_since_epoch(first_day),
+                         Date::from_days_since_epoch(first_day
+                                                     + static_cast<int64_t>(day_count) - 1));
+    }
+
+    iterator begin()
+    {
+        return iterator(this, 0, day_count);
+    }
+
+    iterator end()
+    {
+        return iterator(this, day_count, day_count);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(this, 0, day_count);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(this, day_count, day_count);
+    }
+
+    /**
+     * Gets the days with a value within 'date_range', in date order.
+     *
+     * @param date_range days to get, which may extend past the range of this map.
+     *
+     * @return lazy sequence of the days with a value and their values.
+     */
+    Slice<false> slice(const DateRange& date_range)
+    {
+        auto [first, last] = offsets(date_range);
+        return Slice<false>(iterator(this, first, last), iterator(this, last, last));
+    }
+
+    /**
+     * @see slice(const DateRange&)
+     */
+    Slice<true> slice(const DateRange& date_range) const
+    {
+        auto [first, last] = offsets(date_range);
+        return Slice<true>(const_iterator(this, first, last), const_iterator(this, last, last));
+    }
+
+private:
+
+    /**
+     * Days since 'Date::EPOCH' of the start of the range.
+     */
+    int64_t first_day;
+
+    size_t day_count;
+
+    size_t count = 0;
+
+    /**
+     * Bit 'i % 64' of word 'i / 64' is set if the day 'i' days after the start has a value.
+     */
+    std::vector<uint64_t> present;
+
+    /**
+     * Value of every day if 'DENSE', null otherwise. Not a 'std::vector' so 'DateMap<bool>'
+     * can return references to its values.
+     */
+    std::unique_ptr<T[]> values;
+
+    /**
+     * Page of the days of each word of 'present' if 'PAGED', where a page is only allocated
+     * while one of its days has a value. Empty otherwise.
+     */
+    std::vector<std::unique_ptr<Page>> pages;
+
+    bool is_present(size_t offset) const
+    {
+        return present[offset / PAGE_SIZE] >> (offset % PAGE_SIZE) & 1;
+    }
+
+    T& value_at(size_t offset)
+    {
+        return const_cast<T&>(std::as_const(*this).value_at(offset));
+    }
+
+    const T& value_at(size_t offset) const
+    {
+        if (values)
+            return values[offset];
+        return (*pages[offset / PAGE_SIZE])[offset % PAGE_SIZE];
+    }
+
+    size_t checked_offset(const Date& date) const
+    {
+        auto offset = static_cast<size_t>(date.days_since_epoch() - first_day);
+        ASSERT(offset < day_count,
+               std::invalid_argument(fmt::format("date '{}' is outside the range of the map",
+                                                 date.to_string())));
+        return offset;
+    }
+
+    /**
+     * Gets the offsets of the days of 'date_range' within this map, as '[first, last)'.
+     */
+    std::pair<size_t, size_t> offsets(const DateRange& date_range) const
+    {
+        auto days = static_cast<int64_t>(day_count);
+        int64_t first = std::clamp<int64_t>(date_range.start.days_since_epoch() - first_day, 0,
+                                            days);
+        int64_t last = std::clamp<int64_t>(date_range.end.days_since_epoch() - first_day + 1,
+                                           first, days);
+        return {static_cast<size_t>(first), static_cast<size_t>(last)};
+    }
+
+    /**
+     * Gets the first offset at or after 'offset' and before 'end' that has a value, or 'end'.
+     */
+    size_t next_present(size_t offset, size_t end) const
+    {
+        while (offset < end)
+        {
+            uint64_t word = present[offset / PAGE_SIZE] >> (offset % PAGE_SIZE);
+            if (word != 0)
+                return std::min(offset + static_cast<size_t>(std::countr_zero(word)), end);
+            offset = (offset / PAGE_SIZE + 1) * PAGE_SIZE;
+        }
+        return end;
+    }
+};
+
+#endif //DATETIME_DATE_MAP_H
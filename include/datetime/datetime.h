@@ -5,5 +5,31 @@
 #include "date/date_range.h"
 #include "time/time_range.h"
 #include "datetime/datetime_range.h"
+#include "cache/ttl_cache.h"
+#include "date/date_map.h"
+#include "instant/coarse_clock.h"
+#include "instant/instant.h"
+#include "interval/interval_index.h"
+#include "interval/interval_set.h"
+#include "schedule/cron_schedule.h"
+#include "schedule/day_mask.h"
+#include "schedule/event_loop.h"
+#include "schedule/recurring_window.h"
+#include "schedule/timer_wheel.h"
+#include "series/align_to_grid.h"
+#include "series/asof_join.h"
+#include "series/compressed_timestamp_column.h"
+#include "series/gaps.h"
+#include "series/histogram.h"
+#include "series/radix_sort.h"
+#include "series/resample.h"
+#include "series/rolling_window.h"
+#include "series/time_index.h"
+#include "stream/latency_histogram.h"
+#include "stream/rate_limiter.h"
+#include "stream/reorder_buffer.h"
+#include "stream/timestamp_merger.h"
+#include "stream/timestamp_stream.h"
+#include "stream/watermark_tracker.h"
 
 #endif //DATETIME_H
@@ -3,6 +3,7 @@
 
 #include "datetime/date/date.h"
 #include "datetime/time/time.h"
+#include "datetime/instant/instant.h"
 
 /**
  * 'Date' and a 'Time' with components: 'year', 'month', 'day', 'hour', 'minute',
@@ -88,6 +89,27 @@ public:
      */
     size_t to_ms(Timezone timezone = TZ::UTC) const;
 
+    /**
+     * Creates a 'Datetime' from an 'Instant'.
+     *
+     * @param instant 'Instant' to convert.
+     * @param timezone timezone the 'Datetime' will be in. (default default_timezone)
+     *
+     * @return 'Datetime' that represents the same point in time as 'instant'.
+     *
+     * @throws std::invalid_argument if 'instant' is outside the range of a valid 'Date'.
+     */
+    static Datetime from_instant(Instant instant, Timezone timezone = default_timezone);
+
+    /**
+     * Converts 'this' to an 'Instant'.
+     *
+     * Unlike 'to_ms', the conversion is done in constant time and keeps nanosecond precision.
+     *
+     * @return 'Instant' that represents the same point in time as 'this'.
+     */
+    Instant to_instant() const;
+
     /**
      * Creates a 'Datetime' from a std::string.
      *
@@ -719,12 +741,14 @@ private:
     int64_t total_nanoseconds() const override;
 };
 
+/**
+ * Hashes 'datetime' by its 'Instant', so equal 'Datetimes' in different timezones have the same
+ * hash.
+ */
 inline size_t hash_value(const Datetime& datetime)
 {
-    size_t seed = 0;
-    boost::hash_combine(seed, datetime.date());
-    boost::hash_combine(seed, datetime.time());
-    return seed;
+    auto nanoseconds = static_cast<uint64_t>(datetime.to_instant().nanoseconds);
+    return static_cast<size_t>(mix_hash(nanoseconds));
 }
 
 namespace std
@@ -1,8 +1,11 @@
 #ifndef DATETIME_DATETIMERANGE_H
 #define DATETIME_DATETIMERANGE_H
 
+#include <cstdint>
+#include <span>
 #include <utility>
 #include "datetime.h"
+#include "datetime/instant/instant.h"
 #include "../../../src/range.h"
 
 /**
@@ -18,6 +21,50 @@ struct DatetimeRange : Range<Datetime>
      */
     DatetimeRange(const Datetime& start, const Datetime& end) :
         Range(start, end) {}
+
+    /**
+     * Checks which of 'instants' are in the range of this 'DatetimeRange'.
+     *
+     * The range is converted to 'Instants' once, then each element is checked with a single
+     * branchless comparison so the loop can be vectorized.
+     *
+     * @param instants 'Instants' to check.
+     * @param out set to 1 for every element of 'instants' that is in range, 0 otherwise.
+     *
+     * @throws std::invalid_argument if 'out' is smaller than 'instants'.
+     */
+    void mask(std::span<const Instant> instants, std::span<uint8_t> out) const;
+
+    /**
+     * Checks which of 'instants' are in the range of this 'DatetimeRange'.
+     *
+     * @param instants 'Instants' to check.
+     * @param out bitset where bit 'i % 64' of word 'i / 64' is set if 'instants[i]' is in
+     * range and cleared otherwise.
+     *
+     * @throws std::invalid_argument if 'out' has less than 'instants.size()' bits.
+     */
+    void mask_bits(std::span<const Instant> instants, std::span<uint64_t> out) const;
+
+    /**
+     * Counts the 'instants' that are in the range of this 'DatetimeRange'.
+     *
+     * @param instants 'Instants' to check.
+     *
+     * @return number of 'instants' that are in range.
+     */
+    size_t count_in_range(std::span<const Instant> instants) const;
+
+    /**
+     * Gets the indexes of the 'instants' that are in the range of this 'DatetimeRange'.
+     *
+     * Uses a binary search for each end of the range.
+     *
+     * @param instants 'Instants' to check, sorted in ascending order.
+     *
+     * @return '[first, last)' indexes of the 'instants' that are in range.
+     */
+    std::pair<size_t, size_t> sorted_bounds(std::span<const Instant> instants) const;
 };
 
 #endif //DATETIME_DATETIMERANGE_H
@@ -0,0 +1,75 @@
+#ifndef DATETIME_COARSE_CLOCK_H
+#define DATETIME_COARSE_CLOCK_H
+
+#include <atomic>
+#include <cstdint>
+#include "datetime/instant/instant.h"
+
+/**
+ * Clock that is read with a single relaxed load and updated explicitly, such as once per
+ * batch of messages or by a periodic task.
+ *
+ * A single 'CoarseClock' can be shared by many readers, such as every 'TtlCache' of a
+ * process, so only the updater reads the system clock. Readers may see a time up to the
+ * update period old.
+ *
+ * @example
+ * CoarseClock clock = CoarseClock();
+ * ...
+ * clock.update();
+ * Instant now = clock.now();
+ */
+class CoarseClock
+{
+public:
+
+    /**
+     * Creates a 'CoarseClock' set to 'start'.
+     *
+     * @param start initial time. (default Instant::now())
+     */
+    explicit CoarseClock(Instant start = Instant::now()) :
+        current(start.nanoseconds) {}
+
+    CoarseClock(const CoarseClock&) = delete;
+
+    CoarseClock& operator=(const CoarseClock&) = delete;
+
+    /**
+     * Gets the time of the last update.
+     *
+     * @return the time of the last update, or the start of the clock.
+     */
+    Instant now() const
+    {
+        return Instant(current.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * Sets the clock to 'Instant::now()', which is the simulated time when
+     * 'Instant::mock_instant' is set.
+     */
+    void update()
+    {
+        update(Instant::now());
+    }
+
+    /**
+     * Sets the clock to 'now'.
+     *
+     * @param now current time.
+     */
+    void update(Instant now)
+    {
+        current.store(now.nanoseconds, std::memory_order_relaxed);
+    }
+
+private:
+
+    /**
+     * Nanoseconds since the Unix epoch of the last update.
+     */
+    std::atomic<int64_t> current;
+};
+
+#endif //DATETIME_COARSE_CLOCK_H
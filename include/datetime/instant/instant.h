@@ -0,0 +1,187 @@
+#ifndef DATETIME_INSTANT_H
+#define DATETIME_INSTANT_H
+
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ostream>
+#include "datetime/timedelta/timedelta.h"
+#include "../../../src/util/hash.h"
+
+/**
+ * Point in time stored as nanoseconds since the Unix epoch (1970-01-01 00:00 UTC).
+ *
+ * Unlike 'Datetime', an 'Instant' has no timezone and no components, so comparing two
+ * 'Instants' is a single integer comparison. Columns of timestamps should be stored as
+ * 'Instants' and converted to 'Datetime' only when the components are needed.
+ *
+ * @see Datetime::to_instant
+ * @see Datetime::from_instant
+ */
+struct Instant
+{
+    /**
+     * Nanoseconds since the Unix epoch.
+     */
+    int64_t nanoseconds = 0;
+
+    /**
+     * Nanoseconds in a hour.
+     */
+    static constexpr int64_t NANOSECONDS_PER_HOUR = 3'600'000'000'000;
+
+    /**
+     * Nanoseconds in a day.
+     */
+    static constexpr int64_t NANOSECONDS_PER_DAY = 24 * NANOSECONDS_PER_HOUR;
+
+    /**
+     * 'Instant' returned by 'now' instead of reading the system clock, if set.
+     *
+     * Code that reads the clock through 'now' can be run against a simulated clock by
+     * setting and advancing it. Takes precedence over 'Date::mock_date' and 'Time::mock_time'.
+     */
+    static std::optional<Instant> mock_instant;
+
+    /**
+     * Creates an 'Instant' at the Unix epoch.
+     */
+    constexpr Instant() = default;
+
+    /**
+     * Creates an 'Instant' 'nanoseconds' after the Unix epoch.
+     *
+     * @param nanoseconds nanoseconds since the Unix epoch.
+     */
+    constexpr explicit Instant(int64_t nanoseconds) :
+        nanoseconds(nanoseconds) {}
+
+    /**
+     * Gets the current 'Instant'.
+     *
+     * A single read of 'std::chrono::system_clock', without the timezone conversion and
+     * component decomposition of 'Datetime::now'.
+     *
+     * @return 'mock_instant' if it is set, 'Datetime::now' as an 'Instant' if 'Date::mock_date'
+     * or 'Time::mock_time' is set, the current 'Instant' otherwise.
+     */
+    static Instant now();
+
+    /**
+     * Gets the current 'Instant' from a clock that never steps back, for measuring time between
+     * readings, such as by rate limiters and event loops.
+     *
+     * The system clock is read on the first call and the time elapsed on
+     * 'std::chrono::steady_clock' is added to it, so readings are on the same scale as 'now' but
+     * ignore later corrections of the system clock, such as by NTP.
+     *
+     * @return 'now()' if the clock is mocked, the current monotonic 'Instant' otherwise.
+     */
+    static Instant monotonic_now();
+
+    /**
+     * Compares the nanoseconds since the Unix epoch of 'this' and 'other'.
+     */
+    constexpr auto operator<=>(const Instant& other) const = default;
+
+    /**
+     * Adds 'time_delta' to this 'Instant'.
+     *
+     * @param time_delta 'TimeDelta' to add.
+     *
+     * @return a reference to this modified 'Instant'.
+     */
+    Instant& operator+=(const TimeDelta& time_delta)
+    {
+        nanoseconds += time_delta.total_nanoseconds();
+        return *this;
+    }
+
+    /**
+     * Subtracts 'time_delta' from this 'Instant'.
+     *
+     * @param time_delta 'TimeDelta' to subtract.
+     *
+     * @return a reference to this modified 'Instant'.
+     */
+    Instant& operator-=(const TimeDelta& time_delta)
+    {
+        nanoseconds -= time_delta.total_nanoseconds();
+        return *this;
+    }
+
+    /**
+     * Adds 'time_delta' to 'instant'.
+     *
+     * @param instant 'Instant' to add to.
+     * @param time_delta 'TimeDelta' to add.
+     *
+     * @return a new 'Instant' with 'time_delta' added.
+     */
+    friend Instant operator+(Instant instant, const TimeDelta& time_delta)
+    {
+        instant += time_delta;
+        return instant;
+    }
+
+    /**
+     * Subtracts 'time_delta' from 'instant'.
+     *
+     * @param instant 'Instant' to subtract from.
+     * @param time_delta 'TimeDelta' to subtract.
+     *
+     * @return a new 'Instant' with 'time_delta' subtracted.
+     */
+    friend Instant operator-(Instant instant, const TimeDelta& time_delta)
+    {
+        instant -= time_delta;
+        return instant;
+    }
+
+    /**
+     * Subtracts 'other' from 'instant'.
+     *
+     * @param instant 'Instant' 'other' is subtracting from.
+     * @param other 'Instant' to subtract from 'instant'.
+     *
+     * @return 'TimeDelta' of the difference between 'instant' and 'other'.
+     */
+    friend TimeDelta operator-(Instant instant, Instant other)
+    {
+        return TimeDelta::from_nanoseconds(instant.nanoseconds - other.nanoseconds);
+    }
+
+    /**
+     * Outputs 'instant' into 'os' as nanoseconds since the Unix epoch.
+     *
+     * @param os 'std::ostream' to insert 'instant' into.
+     * @param instant 'Instant' to insert into 'os'.
+     *
+     * @return a reference to 'os' after inserting 'instant' into 'os'.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const Instant& instant)
+    {
+        return os << instant.nanoseconds;
+    }
+};
+
+inline size_t hash_value(const Instant& instant)
+{
+    return static_cast<size_t>(mix_hash(static_cast<uint64_t>(instant.nanoseconds)));
+}
+
+namespace std
+{
+template<>
+struct hash<Instant>
+{
+    size_t operator()(const Instant& instant) const
+    {
+        return hash_value(instant);
+    }
+};
+}
+
+#endif //DATETIME_INSTANT_H
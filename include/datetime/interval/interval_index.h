@@ -0,0 +1,442 @@
+#ifndef DATETIME_INTERVAL_INDEX_H
+#define DATETIME_INTERVAL_INDEX_H
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "datetime/interval/interval_key.h"
+#include "../../../src/range.h"
+#include "../../../src/util/macros.h"
+
+/**
+ * Matches of a batch query against an 'IntervalIndex'.
+ *
+ * Stores the matched range ids of every queried point back to back, so the matches of the
+ * 'i'th point are 'ids[offsets[i]]' up to 'ids[offsets[i + 1]]'.
+ */
+struct IntervalMatches
+{
+    /**
+     * Start of the matches of each point in 'ids', followed by the total number of matches.
+     */
+    std::vector<size_t> offsets = {0};
+
+    /**
+     * Ids of the matched ranges.
+     */
+    std::vector<size_t> ids;
+
+    /**
+     * Gets the number of queried points.
+     *
+     * @return number of queried points.
+     */
+    size_t size() const
+    {
+        return offsets.size() - 1;
+    }
+
+    /**
+     * Gets the ids of the ranges matched by the 'idx'th queried point.
+     *
+     * @param idx index of the queried point.
+     *
+     * @return ids of the ranges matched by the 'idx'th point.
+     */
+    std::span<const size_t> operator[](size_t idx) const
+    {
+        return std::span<const size_t>(ids).subspan(offsets[idx],
+                                                    offsets[idx + 1] - offsets[idx]);
+    }
+};
+
+/**
+ * Immutable index over many 'Ranges' of 'T' that answers which ranges contain a point or
+ * overlap another range in O(log n + k).
+ *
+ * The ranges are stored by their 'IntervalKey' in a flat array sorted by start, which is
+ * treated as an implicit binary search tree where every node also holds the greatest end of
+ * its subtree. Ranges are identified by their position in the sequence the index was built
+ * from.
+ *
+ * @tparam T type of the ranges' points. Must have an 'IntervalKey' specialization.
+ *
+ * @example
+ * std::vector<DatetimeRange> halts = ...;
+ * IntervalIndex<Datetime> index = IntervalIndex<Datetime>(halts);
+ * std::vector<size_t> active_halts = index.containing(Datetime::now());
+ */
+template<typename T>
+class IntervalIndex
+{
+public:
+
+    /**
+     * Creates an 'IntervalIndex' over 'ranges'.
+     *
+     * @tparam Ranges sequence of 'Range<T>' or types derived from it, such as 'DatetimeRange'.
+     *
+     * @param ranges ranges to index. The id of each range is its position in 'ranges'.
+     */
+    template<std::ranges::input_range Ranges>
+    requires std::is_convertible_v<std::ranges::range_reference_t<Ranges>, const Range<T>&>
+    explicit IntervalIndex(const Ranges& ranges)
+    {
+        size_t id = 0;
+        for (const Range<T>& range : ranges)
+        {
+            // 'Range' is inclusive, store as [start, end + 1) so every comparison is strict.
+            int64_t start = IntervalKey<T>::key(range.start);
+            int64_t end = IntervalKey<T>::key(range.end) + 1;
+
+            if constexpr (requires { IntervalKey<T>::wrap_key; })
+            {
+                // Split ranges that wrap around, both halves keep the id of the range.
+                if (start >= end)
+                {
+                    nodes.push_back(Node{start, IntervalKey<T>::wrap_key, 0, id});
+                    any_wrapped = true;
+                    start = 0;
+                }
+            }
+            nodes.push_back(Node{start, end, 0, id++});
+        }
+        range_count = id;
+
+        std::sort(nodes.begin(), nodes.end(), [](const Node& lhs, const Node& rhs) {
+            return lhs.start < rhs.start || (lhs.start == rhs.start && lhs.id < rhs.id);
+        });
+
+        build_max_ends();
+    }
+
+    /**
+     * Gets the number of indexed ranges.
+     *
+     * @return number of indexed ranges.
+     */
+    size_t size() const
+    {
+        return range_count;
+    }
+
+    /**
+     * Gets the ids of the ranges that contain 'point'.
+     *
+     * @tparam Point 'T' or any other type 'IntervalKey<T>' can key, such as 'Instant'.
+     *
+     * @param point point to check.
+     *
+     * @return ids of the ranges that contain 'point', ordered by the start of the range. A range
+     * that wraps around and contains 'point' after the wrap is ordered as if it started there.
+     */
+    template<typename Point>
+    std::vector<size_t> containing(const Point& point) const
+    {
+        int64_t key = IntervalKey<T>::key(point);
+        std::vector<size_t> ret;
+        query(key, key + 1, [&ret](size_t id) { ret.push_back(id); });
+        return ret;
+    }
+
+    /**
+     * Gets the ids of the ranges that overlap the range from 'start' to 'end' (inclusive).
+     *
+     * If 'IntervalKey<T>' wraps around, a range whose 'end' key is before its 'start' key, such
+     * as a 'TimeRange' that crosses midnight in UTC, is split at the wrap like indexed ranges.
+     *
+     * @tparam Point 'T' or any other type 'IntervalKey<T>' can key, such as 'Instant'.
+     *
+     * @param start start of the range to check.
+     * @param end end of the range to check.
+     *
+     * @return ids of the ranges that overlap, ordered by the first key at which they overlap,
+     * counting from 'start' and past the wrap.
+     *
+     * @throws std::invalid_argument if 'start' is after 'end' and 'IntervalKey<T>' does not wrap
+     * around.
+     */
+    template<typename Point>
+    std::vector<size_t> overlapping(const Point& start, const Point& end) const
+    {
+        int64_t start_key = IntervalKey<T>::key(start);
+        int64_t end_key = IntervalKey<T>::key(end);
+
+        std::vector<size_t> ret;
+        auto on_match = [&ret](size_t id) { ret.push_back(id); };
+
+        if constexpr (requires { IntervalKey<T>::wrap_key; })
+        {
+            if (start_key > end_key)
+            {
+                query(start_key, IntervalKey<T>::wrap_key, on_match);
+                query(0, end_key + 1, on_match);
+                remove_repeats(ret);
+                return ret;
+            }
+        }
+
+        ASSERT(start_key <= end_key,
+               std::invalid_argument("Start must be less than or equal to end"));
+
+        query(start_key, end_key + 1, on_match);
+        // Both halves of a range that wraps around can overlap.
+        if (any_wrapped)
+            remove_repeats(ret);
+        return ret;
+    }
+
+    /**
+     * Gets the ids of the ranges that overlap 'range'.
+     *
+     * @param range range to check.
+     *
+     * @return ids of the ranges that overlap 'range', ordered by the first key at which they
+     * overlap.
+     */
+    std::vector<size_t> overlapping(const Range<T>& range) const
+    {
+        return overlapping(range.start, range.end);
+    }
+
+    /**
+     * Gets the ids of the ranges that contain each of 'points'.
+     *
+     * Sweeps 'points' and the ranges together, keeping the ranges that have started in a
+     * min-heap by end, so each range is added and evicted once no matter how many points it
+     * contains.
+     *
+     * @tparam Point 'T' or any other type 'IntervalKey<T>' can key, such as 'Instant'.
+     *
+     * @param points points to check, sorted in ascending order.
+     *
+     * @return ids of the ranges that contain each point, in no particular order per point.
+     *
+     * @throws std::invalid_argument if 'points' is not sorted.
+     */
+    template<typename Point>
+    IntervalMatches containing_sorted(std::span<const Point> points) const
+    {
+        IntervalMatches ret;
+        ret.offsets.reserve(points.size() + 1);
+
+        // Min-heap of the ends of the ranges whose start has been passed.
+        std::vector<const Node*> active;
+        auto later_end = [](const Node* lhs, const Node* rhs) { return lhs->end > rhs->end; };
+
+        size_t next_node = 0;
+        int64_t prev_key = std::numeric_limits<int64_t>::min();
+        for (const Point& point : points)
+        {
+            int64_t key = IntervalKey<T>::key(point);
+            ASSERT(key >= prev_key, std::invalid_argument("Points must be sorted"));
+            prev_key = key;
+
+            for (; next_node < nodes.size() && nodes[next_node].start <= key; ++next_node)
+            {
+                active.push_back(&nodes[next_node]);
+                std::push_heap(active.begin(), active.end(), later_end);
+            }
+            while (!active.empty() && active.front()->end <= key)
+            {
+                std::pop_heap(active.begin(), active.end(), later_end);
+                active.pop_back();
+            }
+
+            for (const Node* node : active)
+                ret.ids.push_back(node->id);
+            ret.offsets.push_back(ret.ids.size());
+        }
+
+        return ret;
+    }
+
+    /**
+     * Gets the ids of the ranges that contain each of 'points'.
+     *
+     * @param points points to check, sorted in ascending order.
+     *
+     * @return ids of the ranges that contain each point, in no particular order per point.
+     */
+    template<typename Point>
+    IntervalMatches containing_sorted(const std::vector<Point>& points) const
+    {
+        return containing_sorted(std::span<const Point>(points));
+    }
+
+private:
+
+    /**
+     * Indexed range stored as [start, end) keys.
+     */
+    struct Node
+    {
+        int64_t start;
+        int64_t end;
+
+        /**
+         * Greatest 'end' in the subtree rooted at this node.
+         */
+        int64_t max_end;
+
+        size_t id;
+    };
+
+    /**
+     * Ranges sorted by start.
+     */
+    std::vector<Node> nodes;
+
+    /**
+     * Whether any range wraps around and is split into two nodes.
+     */
+    bool any_wrapped = false;
+
+    /**
+     * Number of indexed ranges, which is less than the number of nodes if any range wraps
+     * around.
+     */
+    size_t range_count = 0;
+
+    /**
+     * Level of the root of the implicit tree.
+     */
+    int root_level = -1;
+
+    /**
+     * Fills 'max_end' of each node.
+     *
+     * Node 'i' is at the level equal to the number of trailing 1 bits of 'i', and the node at
+     * index 'i' on level 'k' has children at 'i - 2^(k-1)' and 'i + 2^(k-1)'. Children past the
+     * end of the array take the greatest end of the last real subtree instead.
+     */
+    void build_max_ends()
+    {
+        if (nodes.empty())
+            return;
+
+        size_t last_idx = 0;
+        int64_t last_max = 0;
+        for (size_t i = 0; i < nodes.size(); i += 2)
+        {
+            last_idx = i;
+            last_max = nodes[i].max_end = nodes[i].end;
+        }
+
+        int level = 1;
+        for (; size_t(1) << level <= nodes.size(); ++level)
+        {
+            size_t half = size_t(1) << (level - 1);
+            for (size_t i = (half << 1) - 1; i < nodes.size(); i += half << 2)
+            {
+                int64_t left_max = nodes[i - half].max_end;
+                int64_t right_max = i + half < nodes.size() ? nodes[i + half].max_end : last_max;
+                nodes[i].max_end = std::max({nodes[i].end, left_max, right_max});
+            }
+
+            last_idx = (last_idx >> level & 1) ? last_idx - half : last_idx + half;
+            if (last_idx < nodes.size())
+                last_max = std::max(last_max, nodes[last_idx].max_end);
+        }
+        root_level = level - 1;
+    }
+
+    /**
+     * Removes all but the first of each id in 'ids' in O(k log k), keeping their order.
+     *
+     * The ids are sorted by id and then position, so the repeats of an id follow its first
+     * position and are marked to be removed.
+     */
+    static void remove_repeats(std::vector<size_t>& ids)
+    {
+        std::vector<std::pair<size_t, size_t>> by_id;
+        by_id.reserve(ids.size());
+        for (size_t i = 0; i < ids.size(); ++i)
+            by_id.emplace_back(ids[i], i);
+        std::sort(by_id.begin(), by_id.end());
+
+        std::vector<bool> repeat(ids.size());
+        bool any_repeat = false;
+        for (size_t i = 1; i < by_id.size(); ++i)
+        {
+            if (by_id[i].first == by_id[i - 1].first)
+            {
+                repeat[by_id[i].second] = true;
+                any_repeat = true;
+            }
+        }
+        if (!any_repeat)
+            return;
+
+        size_t kept = 0;
+        for (size_t i = 0; i < ids.size(); ++i)
+        {
+            if (!repeat[i])
+                ids[kept++] = ids[i];
+        }
+        ids.resize(kept);
+    }
+
+    /**
+     * Calls 'on_match' with the id of every range overlapping [start, end), in order of the
+     * start of the range.
+     */
+    template<typename Func>
+    void query(int64_t start, int64_t end, Func&& on_match) const
+    {
+        if (nodes.empty())
+            return;
+
+        struct Frame
+        {
+            size_t idx;
+            int level;
+            bool left_done;
+        };
+
+        // Small subtrees are scanned linearly instead of walked.
+        constexpr int scan_level = 3;
+
+        Frame stack[64];
+        size_t top = 0;
+        stack[top++] = Frame{(size_t(1) << root_level) - 1, root_level, false};
+
+        while (top > 0)
+        {
+            Frame frame = stack[--top];
+            if (frame.level <= scan_level)
+            {
+                size_t first = frame.idx >> frame.level << frame.level;
+                size_t last = std::min(first + (size_t(1) << (frame.level + 1)) - 1,
+                                       nodes.size());
+                for (size_t i = first; i < last && nodes[i].start < end; ++i)
+                {
+                    if (start < nodes[i].end)
+                        on_match(nodes[i].id);
+                }
+            }
+            else if (!frame.left_done)
+            {
+                size_t left = frame.idx - (size_t(1) << (frame.level - 1));
+                stack[top++] = Frame{frame.idx, frame.level, true};
+                if (left >= nodes.size() || nodes[left].max_end > start)
+                    stack[top++] = Frame{left, frame.level - 1, false};
+            }
+            else if (frame.idx < nodes.size() && nodes[frame.idx].start < end)
+            {
+                if (start < nodes[frame.idx].end)
+                    on_match(nodes[frame.idx].id);
+                stack[top++] = Frame{frame.idx + (size_t(1) << (frame.level - 1)),
+                                     frame.level - 1,
+                                     false};
+            }
+        }
+    }
+};
+
+#endif //DATETIME_INTERVAL_INDEX_H
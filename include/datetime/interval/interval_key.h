@@ -0,0 +1,124 @@
+#ifndef DATETIME_INTERVAL_KEY_H
+#define DATETIME_INTERVAL_KEY_H
+
+#include <cstdint>
+#include "datetime/datetime/datetime.h"
+#include "datetime/instant/instant.h"
+
+/**
+ * Maps a point of type 'T' to an ordered 64-bit integer key.
+ *
+ * Interval containers store keys instead of 'T' so that their comparisons are integer
+ * comparisons that do not depend on the timezone of each point.
+ *
+ * Each specialization provides 'key' to map a point to its key, 'from_key' to map a key back
+ * to a point, and 'unit_nanoseconds', the duration of one key. Specializations whose points
+ * are whole units, such as days, set 'discrete' so a range's duration includes its end.
+ *
+ * @tparam T type of the points in the interval container.
+ */
+template<typename T>
+struct IntervalKey;
+
+/**
+ * Keys 'Datetimes' and 'Instants' by nanoseconds since the Unix epoch.
+ *
+ * Keys map back to 'Datetimes' in 'TZ::UTC'.
+ */
+template<>
+struct IntervalKey<Datetime>
+{
+    static constexpr int64_t unit_nanoseconds = 1;
+
+    static constexpr bool discrete = false;
+
+    static int64_t key(const Datetime& datetime)
+    {
+        return datetime.to_instant().nanoseconds;
+    }
+
+    static int64_t key(Instant instant)
+    {
+        return instant.nanoseconds;
+    }
+
+    static Datetime from_key(int64_t key)
+    {
+        return Datetime::from_instant(Instant(key), TZ::UTC);
+    }
+};
+
+/**
+ * Keys 'Instants' by nanoseconds since the Unix epoch.
+ */
+template<>
+struct IntervalKey<Instant>
+{
+    static constexpr int64_t unit_nanoseconds = 1;
+
+    static constexpr bool discrete = false;
+
+    static int64_t key(Instant instant)
+    {
+        return instant.nanoseconds;
+    }
+
+    static Instant from_key(int64_t key)
+    {
+        return Instant(key);
+    }
+};
+
+/**
+ * Keys 'Dates' by days since 'Date::EPOCH'.
+ */
+template<>
+struct IntervalKey<Date>
+{
+    static constexpr int64_t unit_nanoseconds = Instant::NANOSECONDS_PER_DAY;
+
+    static constexpr bool discrete = true;
+
+    static int64_t key(const Date& date)
+    {
+        return date.days_since_epoch();
+    }
+
+    static Date from_key(int64_t key)
+    {
+        return Date::from_days_since_epoch(key);
+    }
+};
+
+/**
+ * Keys 'Times' by nanoseconds of the day in 'TZ::UTC'.
+ *
+ * A time of day is circular, so a range whose start key is after its end key (because it
+ * crosses midnight in UTC) wraps around 'wrap_key'. Keys map back to 'Times' in 'TZ::UTC'.
+ */
+template<>
+struct IntervalKey<Time>
+{
+    static constexpr int64_t unit_nanoseconds = 1;
+
+    static constexpr bool discrete = false;
+
+    /**
+     * Nanoseconds in a day, the first key past the end of the day.
+     */
+    static constexpr int64_t wrap_key = Instant::NANOSECONDS_PER_DAY;
+
+    static int64_t key(Time time)
+    {
+        time.set_timezone(TZ::UTC);
+        return time.total_nanoseconds();
+    }
+
+    static Time from_key(int64_t key)
+    {
+        TimeDelta time_of_day = TimeDelta::from_nanoseconds(key);
+        return Time(time_of_day, TZ::UTC);
+    }
+};
+
+#endif //DATETIME_INTERVAL_KEY_H
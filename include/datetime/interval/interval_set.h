@@ -0,0 +1,300 @@
+#ifndef DATETIME_INTERVAL_SET_H
+#define DATETIME_INTERVAL_SET_H
+
+#include <algorithm>
+#include <limits>
+#include <ranges>
+#include <utility>
+#include <vector>
+#include "datetime/interval/interval_key.h"
+#include "datetime/timedelta/timedelta.h"
+#include "../../../src/range.h"
+
+/**
+ * Set of points of type 'T' stored as sorted, coalesced, non-overlapping ranges.
+ *
+ * The ranges are stored by their 'IntervalKey' in a flat array of boundaries
+ * '[start0, end0, start1, end1, ...)' where each range covers '[start, end)'. Because the
+ * boundaries are strictly increasing, a point is in the set if an odd number of boundaries
+ * are less than or equal to it, and every set operation is a single merge of two boundary
+ * arrays.
+ *
+ * @tparam T type of the set's points. Must have an 'IntervalKey' specialization.
+ *
+ * @example
+ * IntervalSet<Datetime> sessions = IntervalSet<Datetime>(session_ranges);
+ * IntervalSet<Datetime> halts = IntervalSet<Datetime>(halt_ranges);
+ * IntervalSet<Datetime> trading = sessions - halts;
+ * TimeDelta time_trading = trading.duration();
+ */
+template<typename T>
+class IntervalSet
+{
+public:
+
+    /**
+     * Creates an empty 'IntervalSet'.
+     */
+    IntervalSet() = default;
+
+    /**
+     * Creates an 'IntervalSet' of the points in any of 'ranges'.
+     *
+     * @tparam Ranges sequence of 'Range<T>' or types derived from it, such as 'DatetimeRange'.
+     *
+     * @param ranges ranges to add to the set. They may overlap and be in any order.
+     */
+    template<std::ranges::input_range Ranges>
+    requires std::is_convertible_v<std::ranges::range_reference_t<Ranges>, const Range<T>&>
+    explicit IntervalSet(const Ranges& ranges)
+    {
+        std::vector<std::pair<int64_t, int64_t>> keyed;
+        for (const Range<T>& range : ranges)
+        {
+            // 'Range' is inclusive, store as [start, end + 1).
+            int64_t start = IntervalKey<T>::key(range.start);
+            int64_t end = IntervalKey<T>::key(range.end) + 1;
+
+            if constexpr (requires { IntervalKey<T>::wrap_key; })
+            {
+                if (start >= end)
+                {
+                    keyed.emplace_back(start, IntervalKey<T>::wrap_key);
+                    start = 0;
+                }
+            }
+            keyed.emplace_back(start, end);
+        }
+
+        std::sort(keyed.begin(), keyed.end());
+
+        for (const auto& [start, end] : keyed)
+        {
+            // Coalesce ranges that overlap or touch the previous range.
+            if (!bounds.empty() && start <= bounds.back())
+                bounds.back() = std::max(bounds.back(), end);
+            else
+            {
+                bounds.push_back(start);
+                bounds.push_back(end);
+            }
+        }
+    }
+
+    /**
+     * Creates an 'IntervalSet' of the points in 'range'.
+     *
+     * @param range range of the set.
+     */
+    explicit IntervalSet(const Range<T>& range) :
+        IntervalSet(std::vector<Range<T>>{range}) {}
+
+    /**
+     * Checks if the set has no points.
+     *
+     * @return 'true' if the set has no points, 'false' otherwise.
+     */
+    bool empty() const
+    {
+        return bounds.empty();
+    }
+
+    /**
+     * Gets the number of disjoint ranges in the set.
+     *
+     * @return number of disjoint ranges in the set.
+     */
+    size_t size() const
+    {
+        return bounds.size() / 2;
+    }
+
+    /**
+     * Gets the disjoint ranges of the set in ascending order.
+     *
+     * @return disjoint ranges of the set, as converted back by 'IntervalKey<T>::from_key'.
+     */
+    std::vector<Range<T>> ranges() const
+    {
+        std::vector<Range<T>> ret;
+        ret.reserve(size());
+        for (size_t i = 0; i < bounds.size(); i += 2)
+            ret.emplace_back(IntervalKey<T>::from_key(bounds[i]),
+                             IntervalKey<T>::from_key(bounds[i + 1] - 1));
+        return ret;
+    }
+
+    /**
+     * Checks if 'point' is in the set using a binary search.
+     *
+     * @tparam Point 'T' or any other type 'IntervalKey<T>' can key, such as 'Instant'.
+     *
+     * @param point point to check.
+     *
+     * @return 'true' if 'point' is in the set, 'false' otherwise.
+     */
+    template<typename Point>
+    bool contains(const Point& point) const
+    {
+        auto after = std::upper_bound(bounds.begin(), bounds.end(), IntervalKey<T>::key(point));
+        return (after - bounds.begin()) % 2 == 1;
+    }
+
+    /**
+     * Gets the total duration covered by the set.
+     *
+     * The duration of each range is its 'end' minus its 'start', except for discrete points
+     * like 'Dates', where the range includes its end, so a 'DateRange' of a single day lasts
+     * one day.
+     *
+     * @return total duration covered by the set.
+     */
+    TimeDelta duration() const
+    {
+        int64_t units = 0;
+        for (size_t i = 0; i < bounds.size(); i += 2)
+            units += bounds[i + 1] - bounds[i];
+
+        if constexpr (!IntervalKey<T>::discrete)
+            units -= static_cast<int64_t>(size());
+
+        if constexpr (requires { IntervalKey<T>::wrap_key; })
+        {
+            // Ranges touching both ends of a wrapping key space are one range around the wrap.
+            if (size() > 1 && bounds.front() == 0 && bounds.back() == IntervalKey<T>::wrap_key)
+                units++;
+        }
+
+        return TimeDelta::from_nanoseconds(units * IntervalKey<T>::unit_nanoseconds);
+    }
+
+    /**
+     * Gets the points in 'this' or 'other'.
+     *
+     * @param other set to unite with.
+     *
+     * @return points in 'this' or 'other'.
+     */
+    IntervalSet set_union(const IntervalSet& other) const
+    {
+        return combine(other, [](bool in_this, bool in_other) { return in_this || in_other; });
+    }
+
+    /**
+     * Gets the points in both 'this' and 'other'.
+     *
+     * @param other set to intersect with.
+     *
+     * @return points in both 'this' and 'other'.
+     */
+    IntervalSet set_intersection(const IntervalSet& other) const
+    {
+        return combine(other, [](bool in_this, bool in_other) { return in_this && in_other; });
+    }
+
+    /**
+     * Gets the points in 'this' that are not in 'other'.
+     *
+     * @param other set of points to remove.
+     *
+     * @return points in 'this' that are not in 'other'.
+     */
+    IntervalSet set_difference(const IntervalSet& other) const
+    {
+        return combine(other, [](bool in_this, bool in_other) { return in_this && !in_other; });
+    }
+
+    /**
+     * Gets the points in 'universe' that are not in 'this'.
+     *
+     * @param universe range of points to take the complement within.
+     *
+     * @return points in 'universe' that are not in 'this'.
+     */
+    IntervalSet complement(const Range<T>& universe) const
+    {
+        return IntervalSet(universe).set_difference(*this);
+    }
+
+    /**
+     * @see set_union
+     */
+    IntervalSet operator|(const IntervalSet& other) const
+    {
+        return set_union(other);
+    }
+
+    /**
+     * @see set_intersection
+     */
+    IntervalSet operator&(const IntervalSet& other) const
+    {
+        return set_intersection(other);
+    }
+
+    /**
+     * @see set_difference
+     */
+    IntervalSet operator-(const IntervalSet& other) const
+    {
+        return set_difference(other);
+    }
+
+    /**
+     * Checks if 'this' and 'other' have the same points.
+     *
+     * @param other 'IntervalSet' to compare to.
+     *
+     * @return 'true' if 'this' and 'other' have the same points, 'false' otherwise.
+     */
+    bool operator==(const IntervalSet& other) const
+    {
+        return bounds == other.bounds;
+    }
+
+private:
+
+    /**
+     * Boundaries of the ranges as '[start0, end0, start1, end1, ...)' keys.
+     */
+    std::vector<int64_t> bounds;
+
+    /**
+     * Merges the boundaries of 'this' and 'other', keeping the points where 'op' returns
+     * 'true' for whether the point is in 'this' and whether it is in 'other'.
+     */
+    template<typename Op>
+    IntervalSet combine(const IntervalSet& other, Op op) const
+    {
+        constexpr int64_t no_bound = std::numeric_limits<int64_t>::max();
+
+        IntervalSet ret;
+        ret.bounds.reserve(bounds.size() + other.bounds.size());
+
+        size_t this_idx = 0;
+        size_t other_idx = 0;
+        bool in_ret = false;
+        while (this_idx < bounds.size() || other_idx < other.bounds.size())
+        {
+            int64_t this_bound = this_idx < bounds.size() ? bounds[this_idx] : no_bound;
+            int64_t other_bound =
+                other_idx < other.bounds.size() ? other.bounds[other_idx] : no_bound;
+            int64_t bound = std::min(this_bound, other_bound);
+
+            this_idx += this_bound == bound;
+            other_idx += other_bound == bound;
+
+            // Passing an odd number of boundaries means the points from 'bound' are inside.
+            bool in = op(this_idx % 2 == 1, other_idx % 2 == 1);
+            if (in != in_ret)
+            {
+                ret.bounds.push_back(bound);
+                in_ret = in;
+            }
+        }
+
+        return ret;
+    }
+};
+
+#endif //DATETIME_INTERVAL_SET_H
@@ -0,0 +1,213 @@
+#ifndef DATETIME_CRON_SCHEDULE_H
+#define DATETIME_CRON_SCHEDULE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include "datetime/datetime/datetime.h"
+#include "datetime/instant/instant.h"
+#include "datetime/time/timezone.h"
+
+/**
+ * Schedule of a cron expression, such as "30 9 * * 1-5" for 09:30 every weekday.
+ *
+ * An expression has the 5 fields minute, hour, day of month, month and day of week, each
+ * '*', a number, a range 'a-b', either of those followed by a step '/n', or a comma
+ * separated list of those. Months and days of the week may also be names, such as 'JAN' and
+ * 'MON', and Sunday is 0 or 7. As in cron, if neither the day of month nor the day of week
+ * starts with '*', a day matches if either of them matches. The macros '@yearly',
+ * '@annually', '@monthly', '@weekly', '@daily' and '@hourly' are also accepted.
+ *
+ * Each field is parsed into a bitmask, so the next fire time is found by jumping to the next
+ * allowed month, day, hour and minute with bit-scans instead of stepping minute by minute.
+ *
+ * @example
+ * CronSchedule quarterly = CronSchedule("0 0 1 JAN,APR,JUL,OCT *");
+ * Datetime next = quarterly.next_after(Datetime::now(), TZ::EST);
+ * for (Datetime fire_time : quarterly.fire_times(next, TZ::EST) | std::views::take(4))
+ *     std::cout << fire_time << std::endl;
+ */
+class CronSchedule
+{
+public:
+
+    /**
+     * Lazy, unbounded sequence of the fire times of a 'CronSchedule' after a point in time.
+     */
+    class FireTimes : public std::ranges::view_interface<FireTimes>
+    {
+    public:
+
+        /**
+         * Iterates the fire times in ascending order.
+         */
+        class Iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Datetime;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = Datetime;
+
+            Iterator() = default;
+
+            Iterator(const CronSchedule* schedule, Instant fire_time, Timezone timezone) :
+                schedule(schedule), fire_time(fire_time), timezone(timezone) {}
+
+            Datetime operator*() const
+            {
+                return Datetime::from_instant(fire_time, timezone);
+            }
+
+            Iterator& operator++()
+            {
+                fire_time = schedule->next_after(fire_time, timezone);
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator ret = *this;
+                ++(*this);
+                return ret;
+            }
+
+        private:
+            const CronSchedule* schedule = nullptr;
+
+            Instant fire_time;
+
+            Timezone timezone = Timezone(0);
+        };
+
+        FireTimes() = default;
+
+        FireTimes(const CronSchedule* schedule, Instant after, Timezone timezone) :
+            schedule(schedule), after(after), timezone(timezone) {}
+
+        Iterator begin() const
+        {
+            return Iterator(schedule, schedule->next_after(after, timezone), timezone);
+        }
+
+        std::unreachable_sentinel_t end() const
+        {
+            return std::unreachable_sentinel;
+        }
+
+    private:
+        const CronSchedule* schedule = nullptr;
+
+        Instant after;
+
+        Timezone timezone = Timezone(0);
+    };
+
+    /**
+     * Creates a 'CronSchedule' from a cron expression.
+     *
+     * @param expression cron expression with 5 fields separated by whitespace, or a macro.
+     *
+     * @throws std::invalid_argument if 'expression' is invalid or never matches a day, such
+     * as "0 0 30 2 *".
+     */
+    explicit CronSchedule(std::string_view expression);
+
+    /**
+     * Gets the first fire time after 'instant'.
+     *
+     * @param instant 'Instant' to search from, which is not itself returned.
+     * @param timezone timezone the expression is evaluated in.
+     *
+     * @return the first fire time after 'instant'.
+     *
+     * @throws std::invalid_argument if the first fire time is after the last valid 'Date'.
+     */
+    Instant next_after(Instant instant, Timezone timezone) const;
+
+    /**
+     * Gets the first fire time after 'datetime'.
+     *
+     * @param datetime 'Datetime' to search from, which is not itself returned.
+     * @param timezone timezone the expression is evaluated in.
+     *
+     * @return the first fire time after 'datetime', in 'timezone'.
+     *
+     * @throws std::invalid_argument if the first fire time is after the last valid 'Date'.
+     */
+    Datetime next_after(const Datetime& datetime, Timezone timezone) const;
+
+    /**
+     * Checks if the minute of 'instant' is a fire time.
+     *
+     * @param instant 'Instant' to check.
+     * @param timezone timezone the expression is evaluated in.
+     *
+     * @return 'true' if the schedule fires in the minute of 'instant', 'false' otherwise.
+     */
+    bool matches(Instant instant, Timezone timezone) const;
+
+    /**
+     * Checks if the minute of 'datetime' is a fire time, evaluated in the timezone of
+     * 'datetime'.
+     *
+     * @param datetime 'Datetime' to check.
+     *
+     * @return 'true' if the schedule fires in the minute of 'datetime', 'false' otherwise.
+     */
+    bool matches(const Datetime& datetime) const;
+
+    /**
+     * Gets the fire times after 'after'.
+     *
+     * @param after 'Datetime' to start after.
+     * @param timezone timezone the expression is evaluated in and the fire times are in.
+     *
+     * @return lazy, unbounded sequence of the fire times.
+     */
+    FireTimes fire_times(const Datetime& after, Timezone timezone) const;
+
+private:
+
+    /**
+     * Bit 'i' is set if the schedule fires in minute 'i' of an hour.
+     */
+    uint64_t minutes = 0;
+
+    /**
+     * Bit 'i' is set if the schedule fires in hour 'i' of a day.
+     */
+    uint32_t hours = 0;
+
+    /**
+     * Bit 'i' is set if the schedule fires on day 'i' of a month, from 1.
+     */
+    uint32_t days = 0;
+
+    /**
+     * Bit 'i' is set if the schedule fires in month 'i', from 1.
+     */
+    uint16_t months = 0;
+
+    /**
+     * Bit 'i' is set if the schedule fires on day 'i' of the week, where Sunday is 0.
+     */
+    uint8_t weekdays = 0;
+
+    /**
+     * 'true' if a day must match both 'days' and 'weekdays', which is when either field
+     * starts with '*', and 'false' if it must match either of them.
+     */
+    bool match_both_days = true;
+
+    /**
+     * Gets the first day of the month of 'date' on or after 'date' the schedule fires on, or
+     * 0 if there is none.
+     */
+    uint32_t next_day(const Date& date) const;
+};
+
+#endif //DATETIME_CRON_SCHEDULE_H
@@ -0,0 +1,184 @@
+#ifndef DATETIME_DAY_MASK_H
+#define DATETIME_DAY_MASK_H
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "datetime/instant/instant.h"
+#include "datetime/time/time_range.h"
+#include "datetime/time/timezone.h"
+#include "datetime/timedelta/timedelta.h"
+#include "../../../src/util/constant_divider.h"
+#include "../../../src/util/math.h"
+
+/**
+ * Set of times of the day, such as the intraday windows a strategy may trade in, stored as a
+ * bitmap with a bit per slot of 'resolution' in a day.
+ *
+ * A time is in the mask if its slot is between the slots of the start and the end of one of
+ * the 'TimeRanges' the mask was built from, inclusive. Like the ranges, the end is included, so
+ * the whole slot of the end is in the mask: at a resolution of a minute, a range ending at 11:00
+ * also contains 11:00:30. Membership is exact when the ranges start on a multiple of
+ * 'resolution' and end one nanosecond before one. A check is a division by a 'ConstantDivider'
+ * and a bit test, however many ranges the mask was built from.
+ *
+ * If the end of a range is before its start once converted to 'timezone', the range wraps
+ * around midnight.
+ *
+ * @example
+ * DayMask windows = DayMask(ranges, TZ::EST);
+ * if (windows.contains(trade.instant))
+ *     execute(trade);
+ * std::optional<Instant> next_window = windows.next_set(trade.instant);
+ */
+class DayMask
+{
+public:
+
+    /**
+     * Creates a 'DayMask' of the times in any of 'ranges'.
+     *
+     * The mask uses 'NANOSECONDS_PER_DAY / resolution' bits, 184 bytes at the default
+     * resolution of a minute and 10.5 KiB at a resolution of a second.
+     *
+     * @param ranges times of the day in the mask.
+     * @param timezone timezone the days of the mask start at midnight in.
+     * @param resolution duration of each slot of the bitmap. (default 1 minute)
+     *
+     * @throws std::invalid_argument if 'resolution' is not positive or does not divide a day
+     * evenly.
+     */
+    DayMask(std::span<const TimeRange> ranges, Timezone timezone,
+            TimeDelta resolution = TimeDelta(0, 0, 1));
+
+    /**
+     * Checks if 'time' is in this mask.
+     *
+     * @param time 'Time' to check, in any timezone.
+     *
+     * @return 'true' if 'time' is in this mask, 'false' otherwise.
+     */
+    bool contains(const Time& time) const
+    {
+        return test(slot_of(offset_of(time)));
+    }
+
+    /**
+     * Checks if the time of day of 'instant' in 'timezone' is in this mask.
+     *
+     * @param instant 'Instant' to check.
+     *
+     * @return 'true' if 'instant' is in this mask, 'false' otherwise.
+     */
+    bool contains(Instant instant) const
+    {
+        return test(slot_of(offset_of(instant)));
+    }
+
+    /**
+     * Gets the first 'Time' at or after 'time' on the same day that is in this mask.
+     *
+     * @param time 'Time' to search from, in any timezone.
+     *
+     * @return 'time' if it is in this mask, otherwise the start of the next slot in this mask,
+     * in 'timezone', or 'std::nullopt' if no later slot of the day is in this mask.
+     */
+    std::optional<Time> next_set(Time time) const;
+
+    /**
+     * Gets the first 'Instant' at or after 'instant' that is in this mask.
+     *
+     * @param instant 'Instant' to search from.
+     *
+     * @return 'instant' if it is in this mask, otherwise the start of the next slot in this
+     * mask, which may be on a later day, or 'std::nullopt' if this mask is empty.
+     */
+    std::optional<Instant> next_set(Instant instant) const;
+
+    /**
+     * Checks which of 'instants' are in this mask.
+     *
+     * @param instants 'Instants' to check.
+     * @param out set to 1 for every element of 'instants' that is in this mask, 0 otherwise.
+     *
+     * @throws std::invalid_argument if 'out' is smaller than 'instants'.
+     */
+    void mask(std::span<const Instant> instants, std::span<uint8_t> out) const;
+
+    /**
+     * Checks which of 'instants' are in this mask.
+     *
+     * @param instants 'Instants' to check.
+     * @param out bitset where bit 'i % 64' of word 'i / 64' is set if 'instants[i]' is in
+     * this mask and cleared otherwise.
+     *
+     * @throws std::invalid_argument if 'out' has less than 'instants.size()' bits.
+     */
+    void mask_bits(std::span<const Instant> instants, std::span<uint64_t> out) const;
+
+    /**
+     * Checks if no time is in this mask.
+     *
+     * @return 'true' if no slot is set, 'false' otherwise.
+     */
+    bool empty() const;
+
+private:
+
+    /**
+     * Timezone the days of the mask start at midnight in.
+     */
+    Timezone timezone;
+
+    /**
+     * Divides nanoseconds after midnight by the resolution.
+     */
+    ConstantDivider slot_divider;
+
+    /**
+     * Number of slots in a day.
+     */
+    size_t slot_count;
+
+    /**
+     * Bit 'i % 64' of word 'i / 64' is set if slot 'i' is in the mask.
+     */
+    std::vector<uint64_t> words;
+
+    int64_t offset_of(const Time& time) const
+    {
+        return floor_mod(time.total_nanoseconds()
+                         + (time.timezone.utc_offset - timezone.utc_offset)
+                             * Instant::NANOSECONDS_PER_HOUR,
+                         Instant::NANOSECONDS_PER_DAY);
+    }
+
+    int64_t offset_of(Instant instant) const
+    {
+        return floor_mod(instant.nanoseconds - timezone.utc_offset * Instant::NANOSECONDS_PER_HOUR,
+                         Instant::NANOSECONDS_PER_DAY);
+    }
+
+    size_t slot_of(int64_t offset) const
+    {
+        return static_cast<size_t>(slot_divider.divide(static_cast<uint64_t>(offset)));
+    }
+
+    bool test(size_t slot) const
+    {
+        return words[slot / 64] >> (slot % 64) & 1;
+    }
+
+    /**
+     * Sets the slots from 'first' to 'last', inclusive.
+     */
+    void set(size_t first, size_t last);
+
+    /**
+     * Gets the first slot at or after 'slot' that is set, or 'slot_count'.
+     */
+    size_t find_next(size_t slot) const;
+};
+
+#endif //DATETIME_DAY_MASK_H
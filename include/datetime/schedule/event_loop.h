@@ -0,0 +1,217 @@
+#ifndef DATETIME_EVENT_LOOP_H
+#define DATETIME_EVENT_LOOP_H
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <limits>
+#include "datetime/datetime/datetime.h"
+#include "datetime/instant/instant.h"
+#include "datetime/schedule/recurring_window.h"
+#include "datetime/schedule/timer_wheel.h"
+#include "datetime/timedelta/timedelta.h"
+
+/**
+ * Single threaded loop that resumes coroutines when the time they wait for is reached.
+ *
+ * Waiting coroutines are kept in a 'TimerWheel', so all the coroutines whose deadlines fall
+ * in the same tick of 'resolution' are resumed by a single wakeup. The loop reads the time
+ * with 'Instant::monotonic_now()', so sleeps are not stretched or cut short by corrections of
+ * the system clock. When the clock is mocked, the loop jumps 'Instant::mock_instant' to the
+ * next deadline instead of sleeping, so a test of a day of timers runs instantly. If only
+ * 'Date::mock_date' or 'Time::mock_time' is set, 'Instant::mock_instant' is set from them on
+ * the first jump.
+ *
+ * @example
+ * EventLoop::Task heartbeat(EventLoop& loop, Session& session)
+ * {
+ *     while (session.is_connected())
+ *     {
+ *         session.send_heartbeat();
+ *         co_await loop.after(TimeDelta(0, 0, 0, 30));
+ *     }
+ * }
+ *
+ * EventLoop loop = EventLoop();
+ * heartbeat(loop, session);
+ * loop.run();
+ */
+class EventLoop
+{
+public:
+
+    /**
+     * Coroutine run by an 'EventLoop'.
+     *
+     * A 'Task' starts running when it is called and runs until its first 'co_await', and
+     * its frame is destroyed when it finishes, including when it throws. Exceptions it throws,
+     * even before its first 'co_await', are rethrown by the next 'run' or 'run_until' on the
+     * same thread.
+     */
+    struct Task
+    {
+        struct promise_type
+        {
+            Task get_return_object()
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() {}
+
+            void unhandled_exception()
+            {
+                // Rethrowing here would leave the frame suspended at its final suspend point,
+                // with nothing to destroy it if the task has not been resumed by a loop yet.
+                if (!task_exception)
+                    task_exception = std::current_exception();
+            }
+        };
+    };
+
+    /**
+     * Awaitable that suspends a coroutine until a deadline.
+     */
+    class Sleep
+    {
+    public:
+        Sleep(EventLoop* loop, Instant deadline) :
+            loop(loop), deadline(deadline) {}
+
+        bool await_ready() const
+        {
+            return deadline <= Instant::monotonic_now();
+        }
+
+        void await_suspend(std::coroutine_handle<> handle) const
+        {
+            loop->wheel.schedule(deadline, handle);
+        }
+
+        void await_resume() const {}
+
+    private:
+        EventLoop* loop;
+
+        Instant deadline;
+    };
+
+    /**
+     * Creates an 'EventLoop' with no waiting coroutines.
+     *
+     * @param resolution duration of a tick of the timer wheel, within which deadlines are
+     * resumed together. (default 1 millisecond)
+     *
+     * @throws std::invalid_argument if 'resolution' is not positive.
+     */
+    explicit EventLoop(TimeDelta resolution = TimeDelta(0, 0, 0, 0, 1));
+
+    EventLoop(const EventLoop&) = delete;
+
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    /**
+     * Destroys the frames of the coroutines that are still waiting.
+     */
+    ~EventLoop();
+
+    /**
+     * Suspends the awaiting coroutine until 'deadline'.
+     *
+     * @param deadline time to resume at. The coroutine is not suspended if 'deadline' has
+     * been reached.
+     *
+     * @return awaitable of the wait.
+     */
+    Sleep at(Instant deadline)
+    {
+        return Sleep(this, deadline);
+    }
+
+    /**
+     * @see at(Instant)
+     */
+    Sleep at(const Datetime& deadline)
+    {
+        return Sleep(this, deadline.to_instant());
+    }
+
+    /**
+     * Suspends the awaiting coroutine for 'delay'.
+     *
+     * @param delay time to wait from 'Instant::monotonic_now()'.
+     *
+     * @return awaitable of the wait.
+     */
+    Sleep after(const TimeDelta& delay)
+    {
+        return Sleep(this, Instant::monotonic_now() + delay);
+    }
+
+    /**
+     * Suspends the awaiting coroutine until the next start of 'session'.
+     *
+     * @param session recurring session, such as the regular hours of an exchange.
+     *
+     * @return awaitable of the wait, which resumes immediately at the start of a session.
+     */
+    Sleep next_session_open(const RecurringWindow& session)
+    {
+        return Sleep(this, session.next_start(Instant::monotonic_now()));
+    }
+
+    /**
+     * Resumes waiting coroutines as their deadlines are reached, until none are waiting.
+     */
+    void run();
+
+    /**
+     * Resumes waiting coroutines as their deadlines are reached, until none are waiting or
+     * the next deadline is after 'end'.
+     *
+     * @param end last deadline to resume. When the clock is simulated, it is advanced to
+     * 'end' before returning.
+     */
+    void run_until(Instant end);
+
+    /**
+     * Gets the number of waiting coroutines.
+     *
+     * @return the number of waiting coroutines.
+     */
+    size_t pending() const
+    {
+        return wheel.size();
+    }
+
+private:
+
+    TimerWheel<std::coroutine_handle<>> wheel;
+
+    /**
+     * First exception thrown by a 'Task' on this thread that has not been rethrown yet.
+     */
+    static thread_local std::exception_ptr task_exception;
+
+    /**
+     * Rethrows 'task_exception', if any, and clears it.
+     */
+    static void rethrow_task_exception();
+
+    /**
+     * Sleeps until 'deadline', or advances the simulated clock to it.
+     */
+    static void wait_until(Instant deadline);
+};
+
+#endif //DATETIME_EVENT_LOOP_H
@@ -0,0 +1,206 @@
+#ifndef DATETIME_RECURRING_WINDOW_H
+#define DATETIME_RECURRING_WINDOW_H
+
+#include <bitset>
+#include <cstdint>
+#include <iterator>
+#include "datetime/date/date_range.h"
+#include "datetime/datetime/datetime_range.h"
+#include "datetime/instant/instant.h"
+#include "datetime/time/time_range.h"
+
+/**
+ * Window of time that recurs every allowed day, such as "09:30 to 16:00 in 'TZ::EST' every
+ * weekday".
+ *
+ * The window is stored as nanosecond offsets from the start of a day in 'timezone', so every
+ * query is answered from the day number and time of day of the queried point without
+ * creating a 'DatetimeRange' per day.
+ *
+ * If the end of the window is before its start once converted to 'timezone', the window
+ * ends on the day after the day it starts.
+ *
+ * @example
+ * RecurringWindow regular_hours = RecurringWindow(TimeRange(Time(9, 30), Time(16)), TZ::EST,
+ *                                                 RecurringWindow::WEEKDAYS);
+ * bool is_open = regular_hours.contains(Datetime::now());
+ * Datetime next_open = regular_hours.next_start(Datetime::now());
+ */
+class RecurringWindow
+{
+public:
+
+    /**
+     * Days of the week a window may start on, indexed by 'Date::DayOfWeek'.
+     */
+    using Days = std::bitset<7>;
+
+    /**
+     * Every day of the week.
+     */
+    static const Days EVERY_DAY;
+
+    /**
+     * Monday through Friday.
+     */
+    static const Days WEEKDAYS;
+
+    /**
+     * Lazy sequence of the occurrences of a 'RecurringWindow' that start within a 'DateRange'.
+     */
+    class Occurrences
+    {
+    public:
+
+        /**
+         * Iterates the occurrences in order of their start.
+         */
+        class Iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = DatetimeRange;
+            using difference_type = std::ptrdiff_t;
+            using pointer = void;
+            using reference = DatetimeRange;
+
+            Iterator(const RecurringWindow* window, int64_t day, int64_t end_day) :
+                window(window), day(day), end_day(end_day) {}
+
+            DatetimeRange operator*() const;
+
+            Iterator& operator++();
+
+            Iterator operator++(int);
+
+            bool operator==(const Iterator& other) const
+            {
+                return day == other.day;
+            }
+
+        private:
+            const RecurringWindow* window;
+
+            /**
+             * Day of the current occurrence in days since 'Date::EPOCH'.
+             */
+            int64_t day;
+
+            /**
+             * Day after the last day an occurrence may start on.
+             */
+            int64_t end_day;
+        };
+
+        Occurrences(const RecurringWindow* window, int64_t first_day, int64_t last_day);
+
+        Iterator begin() const;
+
+        Iterator end() const;
+
+    private:
+        const RecurringWindow* window;
+
+        int64_t first_day;
+
+        /**
+         * Day after the last day an occurrence may start on.
+         */
+        int64_t end_day;
+    };
+
+    /**
+     * Creates a 'RecurringWindow' from 'time_range' on each of 'days' in 'timezone'.
+     *
+     * @param time_range times of the day the window starts and ends at.
+     * @param timezone timezone 'time_range' and 'days' are evaluated in.
+     * @param days days of the week the window starts on. (default EVERY_DAY)
+     *
+     * @throws std::invalid_argument if 'days' has no days.
+     */
+    RecurringWindow(const TimeRange& time_range, Timezone timezone, Days days = EVERY_DAY);
+
+    /**
+     * Checks if 'datetime' is in an occurrence of this window.
+     *
+     * @param datetime 'Datetime' to check.
+     *
+     * @return 'true' if 'datetime' is in an occurrence, 'false' otherwise.
+     */
+    bool contains(const Datetime& datetime) const;
+
+    /**
+     * Checks if 'instant' is in an occurrence of this window.
+     *
+     * @param instant 'Instant' to check.
+     *
+     * @return 'true' if 'instant' is in an occurrence, 'false' otherwise.
+     */
+    bool contains(Instant instant) const;
+
+    /**
+     * Gets the start of the first occurrence that starts at or after 'datetime'.
+     *
+     * @param datetime 'Datetime' to search from.
+     *
+     * @return start of the next occurrence, in 'timezone'.
+     */
+    Datetime next_start(const Datetime& datetime) const;
+
+    /**
+     * Gets the start of the first occurrence that starts at or after 'instant'.
+     *
+     * @param instant 'Instant' to search from.
+     *
+     * @return start of the next occurrence.
+     */
+    Instant next_start(Instant instant) const;
+
+    /**
+     * Gets the occurrences that start on a day within 'date_range' in 'timezone'.
+     *
+     * @param date_range days to get the occurrences of.
+     *
+     * @return lazy sequence of the occurrences.
+     */
+    Occurrences occurrences(const DateRange& date_range) const;
+
+private:
+
+    /**
+     * Nanoseconds after the start of the day in 'timezone' the window starts at.
+     */
+    int64_t start_offset;
+
+    /**
+     * Nanoseconds after the start of the day in 'timezone' the window ends at.
+     */
+    int64_t end_offset;
+
+    /**
+     * Timezone the window is evaluated in.
+     */
+    Timezone timezone;
+
+    /**
+     * Days of the week the window starts on.
+     */
+    Days days;
+
+    /**
+     * Checks if the window starts on the day 'day' days after 'Date::EPOCH'.
+     */
+    bool starts_on(int64_t day) const;
+
+    /**
+     * Gets the first day on or after 'day' the window starts on.
+     */
+    int64_t next_start_day(int64_t day) const;
+
+    /**
+     * Gets the 'Instant' 'offset' nanoseconds after the start of 'day' in 'timezone'.
+     */
+    Instant at(int64_t day, int64_t offset) const;
+};
+
+#endif //DATETIME_RECURRING_WINDOW_H
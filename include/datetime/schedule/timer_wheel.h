@@ -0,0 +1,494 @@
+#ifndef DATETIME_TIMER_WHEEL_H
+#define DATETIME_TIMER_WHEEL_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <fmt/format.h>
+#include "datetime/datetime/datetime.h"
+#include "datetime/instant/instant.h"
+#include "datetime/timedelta/timedelta.h"
+#include "../../../src/util/constant_divider.h"
+#include "../../../src/util/macros.h"
+#include "../../../src/util/durations.h"
+
+/**
+ * Timers with deadlines, such as order timeouts and heartbeats, that expire in batches as
+ * time advances.
+ *
+ * Time is divided into ticks of 'resolution', and deadlines are rounded up to a tick so a
+ * timer never expires early. Timers are kept in 4 levels of 256 slots, where the slots of
+ * level 'l' each span 256^l ticks. A timer is put in the slot of the lowest level whose span
+ * reaches its deadline, and moved down a level when time reaches the start of its slot, so
+ * scheduling and cancelling are O(1) and each timer is moved at most 3 times. 'tick' skips
+ * runs of empty slots with a bit-scan of each level.
+ *
+ * Deadlines more than 256^4 ticks away, about 50 days at a resolution of a millisecond,
+ * are parked in the last slot of the top level and moved again when it is reached.
+ *
+ * @tparam T type of the value of a timer, passed to the callback of 'tick' when it expires.
+ *
+ * @example
+ * TimerWheel<OrderId> timeouts = TimerWheel<OrderId>(TimeDelta(0, 0, 0, 0, 1));
+ * auto timer = timeouts.schedule_after(TimeDelta(0, 0, 0, 5), order.id);
+ * ...
+ * timeouts.cancel(timer);
+ * ...
+ * timeouts.tick(Instant::now(), [](OrderId id) { expire(id); });
+ */
+template<typename T>
+class TimerWheel
+{
+    static constexpr uint32_t LEVELS = 4;
+
+    static constexpr uint32_t SLOT_BITS = 8;
+
+    static constexpr uint32_t SLOTS = 1 << SLOT_BITS;
+
+    /**
+     * Sentinel of the list of timers whose deadline has been reached.
+     */
+    static constexpr uint32_t DUE = LEVELS * SLOTS;
+
+    /**
+     * Sentinel of the list of timers being expired by 'tick'.
+     */
+    static constexpr uint32_t FIRING = DUE + 1;
+
+    /**
+     * Number of sentinels, which come before the links of the timers.
+     */
+    static constexpr uint32_t SENTINELS = FIRING + 1;
+
+    /**
+     * End of the list of free timers.
+     */
+    static constexpr uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+public:
+
+    /**
+     * Identifies a scheduled timer, to cancel it.
+     */
+    using TimerId = uint64_t;
+
+    /**
+     * Creates an empty 'TimerWheel'.
+     *
+     * @param resolution duration of a tick. (default 1 millisecond)
+     * @param start time the wheel starts at. (default Instant::now())
+     *
+     * @throws std::invalid_argument if 'resolution' is not positive.
+     */
+    explicit TimerWheel(TimeDelta resolution = TimeDelta(0, 0, 0, 0, 1),
+                        Instant start = Instant::now()) :
+        tick_divider(positive_nanoseconds(resolution, "resolution")),
+        current_tick(tick_divider.floor_divide(start.nanoseconds)),
+        current_time(start),
+        links(SENTINELS)
+    {
+        for (uint32_t list = 0; list < SENTINELS; ++list)
+            links[list] = {list, list};
+    }
+
+    /**
+     * Schedules a timer that expires at 'deadline'.
+     *
+     * @param deadline time the timer expires at. Timers with a deadline that has already
+     * been reached expire on the next call to 'tick'.
+     * @param value value passed to the callback of 'tick' when the timer expires.
+     *
+     * @return id of the timer.
+     */
+    TimerId schedule(Instant deadline, T value)
+    {
+        uint32_t index = allocate();
+        Timer& timer = timers[index];
+        // Rounded up so the timer does not expire before 'deadline'.
+        timer.deadline = -tick_divider.floor_divide(-deadline.nanoseconds);
+        timer.value.emplace(std::move(value));
+        place(index);
+        count++;
+        return static_cast<TimerId>(index) << 32 | timer.generation;
+    }
+
+    /**
+     * @see schedule(Instant, T)
+     */
+    TimerId schedule(const Datetime& deadline, T value)
+    {
+        return schedule(deadline.to_instant(), std::move(value));
+    }
+
+    /**
+     * Schedules a timer that expires 'delay' after the time of the last call to 'tick'.
+     *
+     * @param delay time until the timer expires.
+     * @param value value passed to the callback of 'tick' when the timer expires.
+     *
+     * @return id of the timer.
+     */
+    TimerId schedule_after(const TimeDelta& delay, T value)
+    {
+        return schedule(current_time + delay, std::move(value));
+    }
+
+    /**
+     * Cancels the timer 'id' so it does not expire.
+     *
+     * @param id id of the timer.
+     *
+     * @return 'true' if the timer was cancelled, 'false' if it has already expired or been
+     * cancelled.
+     */
+    bool cancel(TimerId id)
+    {
+        auto index = static_cast<uint32_t>(id >> 32);
+        if (index >= timers.size() || timers[index].generation != static_cast<uint32_t>(id)
+            || !timers[index].value)
+            return false;
+
+        unlink(SENTINELS + index);
+        uint32_t list = timers[index].list;
+        if (list < DUE && is_empty(list))
+            occupied[list / SLOTS][list % SLOTS / 64] &= ~(uint64_t(1) << list % 64);
+        release(index);
+        return true;
+    }
+
+    /**
+     * Advances the wheel to 'now' and expires every timer whose deadline has been reached,
+     * in order of their deadline.
+     *
+     * Timers scheduled by 'callback' that are already due expire on the next call.
+     *
+     * @param now current time. Times before the time of the last call do not move the
+     * wheel back.
+     * @param callback called with a reference to the value of each expired timer.
+     *
+     * @return the number of expired timers.
+     */
+    template<typename Callback>
+    size_t tick(Instant now, Callback&& callback)
+    {
+        current_time = std::max(current_time, now);
+        advance(tick_divider.floor_divide(now.nanoseconds));
+        return expire(callback);
+    }
+
+    /**
+     * @see tick(Instant, Callback&&)
+     */
+    template<typename Callback>
+    size_t tick(const Datetime& now, Callback&& callback)
+    {
+        return tick(now.to_instant(), callback);
+    }
+
+    /**
+     * Advances the wheel to 'Instant::now()', which is the simulated time when
+     * 'Instant::mock_instant' is set.
+     *
+     * @see tick(Instant, Callback&&)
+     */
+    template<typename Callback>
+    size_t tick(Callback&& callback)
+    {
+        return tick(Instant::now(), callback);
+    }
+
+    /**
+     * Gets the earliest time a call to 'tick' may expire a timer, to sleep until.
+     *
+     * @return the earliest possible deadline of a timer, not before the time of the last
+     * call to 'tick', or 'std::nullopt' if there are no timers.
+     */
+    std::optional<Instant> next_expiry() const
+    {
+        if (count == 0)
+            return std::nullopt;
+        if (!is_empty(DUE) || !is_empty(FIRING))
+            return current_time;
+        return std::max(current_time, Instant(next_event_tick()
+                                              * static_cast<int64_t>(tick_divider.get_divisor())));
+    }
+
+    /**
+     * Gets the time of the last call to 'tick', or the start of the wheel.
+     *
+     * @return the current time of the wheel.
+     */
+    Instant now() const
+    {
+        return current_time;
+    }
+
+    /**
+     * Gets the number of timers that have not expired or been cancelled.
+     *
+     * @return the number of scheduled timers.
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * Checks if there are no scheduled timers.
+     *
+     * @return 'true' if there are no timers, 'false' otherwise.
+     */
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+private:
+
+    struct Link
+    {
+        uint32_t prev;
+
+        uint32_t next;
+    };
+
+    struct Timer
+    {
+        /**
+         * Tick the timer expires at.
+         */
+        int64_t deadline = 0;
+
+        /**
+         * Incremented every time the timer is released, so ids of released timers are
+         * rejected.
+         */
+        uint32_t generation = 0;
+
+        /**
+         * Sentinel of the list the timer was put in. A timer moved to 'DUE' keeps the slot
+         * it was in.
+         */
+        uint32_t list = 0;
+
+        /**
+         * Value of the timer, empty while the timer is free.
+         */
+        std::optional<T> value;
+    };
+
+    ConstantDivider tick_divider;
+
+    /**
+     * Last tick the wheel has been advanced to.
+     */
+    int64_t current_tick;
+
+    Instant current_time;
+
+    /**
+     * Links of the circular lists of timers, where the first 'SENTINELS' links are the heads
+     * of the slots and of 'DUE' and 'FIRING', and link 'SENTINELS + i' is of 'timers[i]'. The
+     * links of free timers chain the free list through 'next'.
+     */
+    std::vector<Link> links;
+
+    std::vector<Timer> timers;
+
+    uint32_t free_head = NONE;
+
+    size_t count = 0;
+
+    /**
+     * Bit 's % 64' of word 's / 64' of a level is set if slot 's' of the level may have
+     * timers.
+     */
+    std::array<std::array<uint64_t, SLOTS / 64>, LEVELS> occupied = {};
+
+    bool is_empty(uint32_t list) const
+    {
+        return links[list].next == list;
+    }
+
+    void unlink(uint32_t link)
+    {
+        links[links[link].prev].next = links[link].next;
+        links[links[link].next].prev = links[link].prev;
+    }
+
+    void push_back(uint32_t list, uint32_t link)
+    {
+        uint32_t last = links[list].prev;
+        links[link] = {last, list};
+        links[last].next = link;
+        links[list].prev = link;
+    }
+
+    /**
+     * Moves all the timers of 'from' to the end of 'to'.
+     */
+    void splice(uint32_t from, uint32_t to)
+    {
+        if (is_empty(from))
+            return;
+
+        uint32_t first = links[from].next;
+        uint32_t last = links[from].prev;
+        uint32_t to_last = links[to].prev;
+        links[to_last].next = first;
+        links[first].prev = to_last;
+        links[last].next = to;
+        links[to].prev = last;
+        links[from] = {from, from};
+    }
+
+    uint32_t allocate()
+    {
+        if (free_head == NONE)
+        {
+            timers.emplace_back();
+            links.push_back({});
+            return static_cast<uint32_t>(timers.size() - 1);
+        }
+
+        uint32_t index = free_head;
+        free_head = links[SENTINELS + index].next;
+        return index;
+    }
+
+    void release(uint32_t index)
+    {
+        timers[index].value.reset();
+        timers[index].generation++;
+        links[SENTINELS + index].next = free_head;
+        free_head = index;
+        count--;
+    }
+
+    /**
+     * Puts the timer 'index' in the list for its deadline relative to 'current_tick'.
+     */
+    void place(uint32_t index)
+    {
+        Timer& timer = timers[index];
+        if (timer.deadline <= current_tick)
+        {
+            timer.list = DUE;
+            push_back(DUE, SENTINELS + index);
+            return;
+        }
+
+        auto delta = static_cast<uint64_t>(timer.deadline - current_tick);
+        uint32_t level = 0;
+        while (level + 1 < LEVELS && delta >> SLOT_BITS * (level + 1) != 0)
+            level++;
+
+        int64_t target = timer.deadline;
+        if (delta >> SLOT_BITS * LEVELS != 0)
+            target = current_tick + (int64_t(1) << SLOT_BITS * LEVELS) - 1;
+
+        auto slot = static_cast<uint32_t>(target >> SLOT_BITS * level) & (SLOTS - 1);
+        occupied[level][slot / 64] |= uint64_t(1) << slot % 64;
+        timer.list = level * SLOTS + slot;
+        push_back(timer.list, SENTINELS + index);
+    }
+
+    /**
+     * Gets the first tick after 'current_tick' that expires or moves timers.
+     */
+    int64_t next_event_tick() const
+    {
+        int64_t ret = std::numeric_limits<int64_t>::max();
+        for (uint32_t level = 0; level < LEVELS; ++level)
+        {
+            int64_t base = current_tick >> SLOT_BITS * level;
+            auto start = static_cast<uint32_t>(base + 1) & (SLOTS - 1);
+
+            // Scan the slots cyclically from the one after the current one.
+            for (uint32_t distance = 0; distance < SLOTS;)
+            {
+                uint32_t slot = (start + distance) & (SLOTS - 1);
+                uint64_t word = occupied[level][slot / 64] >> slot % 64;
+                if (word != 0)
+                {
+                    distance += static_cast<uint32_t>(std::countr_zero(word));
+                    ret = std::min(ret, (base + 1 + distance) << SLOT_BITS * level);
+                    break;
+                }
+                distance += 64 - slot % 64;
+            }
+        }
+        return ret;
+    }
+
+    /**
+     * Advances 'current_tick' to 'target', moving the timers of each slot that is reached
+     * down a level and the timers of each tick that is reached to 'DUE'.
+     */
+    void advance(int64_t target)
+    {
+        while (current_tick < target)
+        {
+            int64_t next = next_event_tick();
+            if (next > target)
+            {
+                current_tick = target;
+                return;
+            }
+
+            current_tick = next;
+            for (uint32_t level = LEVELS - 1; level > 0; --level)
+            {
+                if ((next & ((int64_t(1) << SLOT_BITS * level) - 1)) == 0)
+                    cascade(level, static_cast<uint32_t>(next >> SLOT_BITS * level) & (SLOTS - 1));
+            }
+
+            auto slot = static_cast<uint32_t>(next) & (SLOTS - 1);
+            occupied[0][slot / 64] &= ~(uint64_t(1) << slot % 64);
+            splice(slot, DUE);
+        }
+    }
+
+    /**
+     * Puts the timers of 'slot' of 'level' back in the wheel relative to 'current_tick'.
+     */
+    void cascade(uint32_t level, uint32_t slot)
+    {
+        occupied[level][slot / 64] &= ~(uint64_t(1) << slot % 64);
+        uint32_t list = level * SLOTS + slot;
+        while (!is_empty(list))
+        {
+            uint32_t link = links[list].next;
+            unlink(link);
+            place(link - SENTINELS);
+        }
+    }
+
+    template<typename Callback>
+    size_t expire(Callback& callback)
+    {
+        // Timers left by a callback that threw are expired first.
+        splice(DUE, FIRING);
+
+        size_t expired = 0;
+        while (!is_empty(FIRING))
+        {
+            uint32_t link = links[FIRING].next;
+            unlink(link);
+            uint32_t index = link - SENTINELS;
+            T value = std::move(*timers[index].value);
+            release(index);
+            expired++;
+            callback(value);
+        }
+        return expired;
+    }
+};
+
+#endif //DATETIME_TIMER_WHEEL_H
@@ -0,0 +1,156 @@
+#ifndef DATETIME_ALIGN_TO_GRID_H
+#define DATETIME_ALIGN_TO_GRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "datetime/datetime/datetime_range.h"
+#include "datetime/instant/instant.h"
+#include "datetime/series/asof_direction.h"
+#include "datetime/series/asof_join.h"
+#include "datetime/timedelta/timedelta.h"
+
+/**
+ * Evenly spaced 'Instants', such as every second of a session, without storing them.
+ *
+ * @example
+ * // Every second from 09:30 to 16:00, like 'Datetime::range' with 'Seconds(1)'.
+ * TimeGrid grid = TimeGrid(DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 16)),
+ *                          TimeDelta(0, 0, 0, 1));
+ */
+class TimeGrid
+{
+public:
+
+    /**
+     * Creates a 'TimeGrid' of 'size' 'Instants' every 'step' from 'start'.
+     *
+     * @param start first 'Instant' of the grid.
+     * @param step time between consecutive 'Instants'.
+     * @param size number of 'Instants'.
+     *
+     * @throws std::invalid_argument if 'step' is not positive.
+     */
+    TimeGrid(Instant start, TimeDelta step, size_t size);
+
+    /**
+     * Creates a 'TimeGrid' of the 'Instants' every 'step' from the start of 'range' up to and
+     * including its end.
+     *
+     * @param range range of the grid.
+     * @param step time between consecutive 'Instants'.
+     *
+     * @throws std::invalid_argument if 'step' is not positive.
+     */
+    TimeGrid(const DatetimeRange& range, TimeDelta step);
+
+    /**
+     * Gets the 'Instant' at 'index'.
+     *
+     * @param index index of the 'Instant', less than 'size()'.
+     *
+     * @return 'index' steps after the start.
+     */
+    Instant operator[](size_t index) const
+    {
+        return Instant(start.nanoseconds + static_cast<int64_t>(index) * step);
+    }
+
+    /**
+     * Gets the number of 'Instants'.
+     *
+     * @return the number of 'Instants'.
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+private:
+
+    Instant start;
+
+    /**
+     * Nanoseconds between consecutive 'Instants'.
+     */
+    int64_t step;
+
+    size_t count;
+};
+
+/**
+ * Matches each 'Instant' of 'grid' with the nearest of 'series' in 'direction', such as to
+ * forward-fill a series onto a common grid of seconds.
+ *
+ * A match is the same as 'asof_join' with the 'Instants' of 'grid' on the left, so 'BACKWARD'
+ * forward-fills, 'FORWARD' back-fills and 'NEAREST' takes the closest. Both are swept once
+ * together, with each 'Instant' of 'grid' computed from its index instead of being stored.
+ *
+ * As with the right column of 'asof_join', 'series' is not checked to be sorted, since that
+ * would read all of it; an unsorted 'series' gives unspecified matches.
+ *
+ * @param grid 'Instants' to find a match for.
+ * @param series 'Instants' to match against, sorted in ascending order.
+ * @param tolerance largest distance between an 'Instant' of 'grid' and its match.
+ * @param direction direction to search for a match in. (default BACKWARD)
+ *
+ * @return for each 'Instant' of 'grid', the index in 'series' of its match, or
+ * 'ASOF_NO_MATCH' if there is no match within 'tolerance'.
+ *
+ * @throws std::invalid_argument if 'tolerance' is negative.
+ *
+ * @example
+ * // Last price at or before each second, if it is at most a minute old.
+ * std::vector<size_t> indices = align_to_grid(grid, trade_instants, TimeDelta(0, 0, 1));
+ */
+std::vector<size_t> align_to_grid(const TimeGrid& grid, std::span<const Instant> series,
+                                  TimeDelta tolerance,
+                                  AsofDirection direction = AsofDirection::BACKWARD);
+
+/**
+ * Matches each 'Instant' of 'grid' with the nearest of 'series' in 'direction', without a
+ * tolerance.
+ *
+ * @see align_to_grid(const TimeGrid&, std::span<const Instant>, TimeDelta, AsofDirection)
+ */
+std::vector<size_t> align_to_grid(const TimeGrid& grid, std::span<const Instant> series,
+                                  AsofDirection direction = AsofDirection::BACKWARD);
+
+/**
+ * Matches each 'Instant' of 'grid' with the nearest of 'series' in 'direction', writing the
+ * indices to 'out' instead of allocating.
+ *
+ * @param out set to the index in 'series' of the match of each 'Instant' of 'grid'.
+ *
+ * @throws std::invalid_argument if 'out' is smaller than 'grid'.
+ *
+ * @see align_to_grid(const TimeGrid&, std::span<const Instant>, TimeDelta, AsofDirection)
+ */
+void align_to_grid(const TimeGrid& grid, std::span<const Instant> series, TimeDelta tolerance,
+                   AsofDirection direction, std::span<size_t> out);
+
+/**
+ * Matches each 'Instant' of 'grid' with the nearest of each of 'series', such as to compare
+ * many instruments second by second.
+ *
+ * The series are aligned in parallel on 'thread_count' threads, each taking the next series
+ * not yet aligned.
+ *
+ * @param grid 'Instants' to find a match for.
+ * @param series series to align, each sorted in ascending order.
+ * @param tolerance largest distance between an 'Instant' of 'grid' and its match.
+ * @param direction direction to search for a match in. (default BACKWARD)
+ * @param thread_count number of threads to align with. (default 1)
+ *
+ * @return for each of 'series', the index of the match of each 'Instant' of 'grid'.
+ *
+ * @throws std::invalid_argument if 'tolerance' is negative or 'thread_count' is 0.
+ *
+ * @see align_to_grid(const TimeGrid&, std::span<const Instant>, TimeDelta, AsofDirection)
+ */
+std::vector<std::vector<size_t>> align_to_grid(
+    const TimeGrid& grid, std::span<const std::span<const Instant>> series, TimeDelta tolerance,
+    AsofDirection direction = AsofDirection::BACKWARD, unsigned thread_count = 1);
+
+#endif //DATETIME_ALIGN_TO_GRID_H
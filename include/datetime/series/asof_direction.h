@@ -0,0 +1,28 @@
+#ifndef DATETIME_ASOFDIRECTION_H
+#define DATETIME_ASOFDIRECTION_H
+
+/**
+ * Directions an as-of join searches for a match in.
+ *
+ * @see asof_join
+ */
+enum class AsofDirection
+{
+    /**
+     * Last right 'Instant' at or before the left 'Instant'.
+     */
+    BACKWARD,
+
+    /**
+     * First right 'Instant' at or after the left 'Instant'.
+     */
+    FORWARD,
+
+    /**
+     * Closest of the backward and forward matches, preferring the backward match on ties.
+     */
+    NEAREST
+};
+
+
+#endif //DATETIME_ASOFDIRECTION_H
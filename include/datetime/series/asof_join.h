@@ -0,0 +1,77 @@
+#ifndef DATETIME_ASOF_JOIN_H
+#define DATETIME_ASOF_JOIN_H
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+#include "datetime/instant/instant.h"
+#include "datetime/series/asof_direction.h"
+#include "datetime/timedelta/timedelta.h"
+
+/**
+ * Index 'asof_join' sets for a left 'Instant' without a match.
+ */
+inline constexpr size_t ASOF_NO_MATCH = std::numeric_limits<size_t>::max();
+
+/**
+ * Matches each of 'left' with the nearest of 'right' in 'direction', such as the latest quote
+ * at or before each trade.
+ *
+ * Both columns are merged in a single pass. The position in 'right' is advanced by galloping,
+ * doubling the step until it passes the left 'Instant' and then binary searching the last
+ * step, so joining a short column against a long one costs O(n log(m / n)) instead of O(m).
+ *
+ * With a 'thread_count' above 1, 'left' is split into that many contiguous partitions that
+ * are joined in parallel, each starting from a binary search of 'right'.
+ *
+ * Only 'left' is checked to be sorted, since it is read in full anyway. Checking 'right' would
+ * read all of it and cancel out the gallop, so an unsorted 'right' gives unspecified matches.
+ *
+ * @param left 'Instants' to find a match for, sorted in ascending order.
+ * @param right 'Instants' to match against, sorted in ascending order.
+ * @param tolerance largest distance between a left 'Instant' and its match.
+ * @param direction direction to search for a match in. (default BACKWARD)
+ * @param thread_count number of threads to join with. (default 1)
+ *
+ * @return for each of 'left', the index in 'right' of its match, or 'ASOF_NO_MATCH' if there
+ * is no match within 'tolerance'. If several of 'right' are equal, the last is matched when
+ * searching backward and the first when searching forward.
+ *
+ * @throws std::invalid_argument if 'tolerance' is negative, 'thread_count' is 0, or 'left'
+ * is not sorted.
+ *
+ * @example
+ * // Latest quote at most 1 second before each trade.
+ * std::vector<size_t> quote_indices = asof_join(trade_instants, quote_instants,
+ *                                               TimeDelta(0, 0, 0, 1));
+ */
+std::vector<size_t> asof_join(std::span<const Instant> left, std::span<const Instant> right,
+                              TimeDelta tolerance,
+                              AsofDirection direction = AsofDirection::BACKWARD,
+                              unsigned thread_count = 1);
+
+/**
+ * Matches each of 'left' with the nearest of 'right' in 'direction', without a tolerance.
+ *
+ * @see asof_join(std::span<const Instant>, std::span<const Instant>, TimeDelta, AsofDirection, unsigned)
+ */
+std::vector<size_t> asof_join(std::span<const Instant> left, std::span<const Instant> right,
+                              AsofDirection direction = AsofDirection::BACKWARD,
+                              unsigned thread_count = 1);
+
+/**
+ * Matches each of 'left' with the nearest of 'right' in 'direction', writing the indices to
+ * 'out' instead of allocating.
+ *
+ * @param out set to the index in 'right' of the match of each of 'left'.
+ *
+ * @throws std::invalid_argument if 'out' is smaller than 'left'.
+ *
+ * @see asof_join(std::span<const Instant>, std::span<const Instant>, TimeDelta, AsofDirection, unsigned)
+ */
+void asof_join(std::span<const Instant> left, std::span<const Instant> right,
+               TimeDelta tolerance, AsofDirection direction, unsigned thread_count,
+               std::span<size_t> out);
+
+#endif //DATETIME_ASOF_JOIN_H
@@ -0,0 +1,204 @@
+#ifndef DATETIME_COMPRESSED_TIMESTAMP_COLUMN_H
+#define DATETIME_COMPRESSED_TIMESTAMP_COLUMN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "datetime/instant/instant.h"
+
+/**
+ * Column of 'Instants' compressed with delta-of-delta encoding.
+ *
+ * Consecutive timestamps of a feed differ by small, regular deltas, so the change between
+ * consecutive deltas is usually 0 or small. Each change is zigzag encoded and written with a
+ * prefix selecting one of a few payload widths:
+ *
+ * - '0': the delta is unchanged.
+ * - '10' and 8 bits, '110' and 16 bits, '1110' and 32 bits.
+ * - '1111' and 64 bits.
+ *
+ * The column is split into blocks of 'BLOCK_SIZE' 'Instants'. Each block stores its first
+ * 'Instant' uncompressed and its position in the bit stream, so any block can be decoded
+ * without decoding the ones before it.
+ *
+ * @example
+ * CompressedTimestampColumn column;
+ * for (const Trade& trade : trades)
+ *     column.append(trade.instant);
+ *
+ * std::vector<Instant> instants = column.decode();
+ * double ratio = column.compression_ratio();
+ */
+class CompressedTimestampColumn
+{
+public:
+
+    /**
+     * Number of 'Instants' in each block.
+     */
+    static constexpr size_t BLOCK_SIZE = 1024;
+
+    /**
+     * Creates an empty 'CompressedTimestampColumn'.
+     */
+    CompressedTimestampColumn() = default;
+
+    /**
+     * Creates a 'CompressedTimestampColumn' of 'instants'.
+     *
+     * @param instants 'Instants' to compress, in any order.
+     */
+    explicit CompressedTimestampColumn(std::span<const Instant> instants);
+
+    /**
+     * Appends 'instant' to the end of the column.
+     *
+     * @param instant 'Instant' to append.
+     */
+    void append(Instant instant);
+
+    /**
+     * Appends 'instants' to the end of the column.
+     *
+     * @param instants 'Instants' to append.
+     */
+    void append(std::span<const Instant> instants);
+
+    /**
+     * Gets the number of 'Instants' in the column.
+     *
+     * @return the number of 'Instants'.
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * Checks if the column has no 'Instants'.
+     *
+     * @return 'true' if the column is empty, 'false' otherwise.
+     */
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * Gets the number of blocks in the column.
+     *
+     * @return the number of blocks.
+     */
+    size_t block_count() const
+    {
+        return blocks.size();
+    }
+
+    /**
+     * Gets the 'Instant' at 'index', decoding only the start of its block.
+     *
+     * @param index index of the 'Instant'.
+     *
+     * @return the 'Instant' at 'index'.
+     *
+     * @throws std::invalid_argument if 'index' is not less than 'size()'.
+     */
+    Instant at(size_t index) const;
+
+    /**
+     * Decodes the block with index 'block'.
+     *
+     * @param block index of the block.
+     * @param out set to the 'Instants' of the block, which has 'BLOCK_SIZE' 'Instants' unless
+     * it is the last block.
+     *
+     * @return number of 'Instants' decoded.
+     *
+     * @throws std::invalid_argument if 'block' is not less than 'block_count()' or 'out' is
+     * smaller than the block.
+     */
+    size_t decode_block(size_t block, std::span<Instant> out) const;
+
+    /**
+     * Decodes every 'Instant' of the column.
+     *
+     * @param out set to the 'Instants' of the column.
+     *
+     * @throws std::invalid_argument if 'out' is smaller than 'size()'.
+     */
+    void decode(std::span<Instant> out) const;
+
+    /**
+     * Decodes every 'Instant' of the column.
+     *
+     * @return the 'Instants' of the column.
+     */
+    std::vector<Instant> decode() const;
+
+    /**
+     * Gets the number of bytes used by the compressed column.
+     *
+     * @return the size in bytes of the bit stream and the block headers.
+     */
+    size_t compressed_bytes() const;
+
+    /**
+     * Gets how many times smaller the column is than an array of 'Instants'.
+     *
+     * @return the uncompressed size divided by 'compressed_bytes()', or 0 if empty.
+     */
+    double compression_ratio() const;
+
+private:
+
+    /**
+     * Header of a block of 'BLOCK_SIZE' 'Instants'.
+     */
+    struct Block
+    {
+        /**
+         * First 'Instant' of the block, which is not in the bit stream.
+         */
+        Instant first;
+
+        /**
+         * Position in bits of the second 'Instant' of the block in 'words'.
+         */
+        uint64_t bit_offset;
+    };
+
+    std::vector<Block> blocks;
+
+    /**
+     * Bit stream of the encoded deltas of delta, least significant bit first, followed by
+     * a zeroed word so a 64-bit read never goes past the end.
+     */
+    std::vector<uint64_t> words = {0};
+
+    uint64_t bit_size = 0;
+
+    size_t count = 0;
+
+    /**
+     * Last appended 'Instant'.
+     */
+    uint64_t previous = 0;
+
+    /**
+     * Difference between the last two appended 'Instants' of the last block.
+     */
+    uint64_t previous_delta = 0;
+
+    /**
+     * Writes the 'bits' low bits of 'value' to the end of the bit stream.
+     */
+    void write(uint64_t value, uint32_t bits);
+
+    /**
+     * Decodes 'size' 'Instants' of the block with header 'header' into 'out'.
+     */
+    void decode(const Block& header, size_t size, Instant* out) const;
+};
+
+#endif //DATETIME_COMPRESSED_TIMESTAMP_COLUMN_H
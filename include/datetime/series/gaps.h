@@ -0,0 +1,142 @@
+#ifndef DATETIME_GAPS_H
+#define DATETIME_GAPS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "datetime/instant/instant.h"
+#include "datetime/timedelta/timedelta.h"
+
+/**
+ * Time between two consecutive 'Instants' of a series that is longer than allowed.
+ */
+struct Gap
+{
+    /**
+     * 'Instant' before the gap.
+     */
+    Instant start;
+
+    /**
+     * 'Instant' after the gap.
+     */
+    Instant end;
+
+    /**
+     * Index in the series of 'end'.
+     */
+    size_t index;
+
+    /**
+     * Gets the length of the gap.
+     *
+     * @return time from 'start' to 'end'.
+     */
+    TimeDelta duration() const
+    {
+        return end - start;
+    }
+
+    bool operator==(const Gap& other) const = default;
+};
+
+/**
+ * Gets the difference in nanoseconds between each pair of consecutive 'instants'.
+ *
+ * @param instants 'Instants' to get the differences of.
+ * @param out set so 'out[i]' is 'instants[i + 1]' minus 'instants[i]'.
+ *
+ * @throws std::invalid_argument if 'out' has less than 'instants.size() - 1' elements.
+ */
+void diff(std::span<const Instant> instants, std::span<int64_t> out);
+
+/**
+ * Gets the difference in nanoseconds between each pair of consecutive 'instants'.
+ *
+ * @param instants 'Instants' to get the differences of.
+ *
+ * @return 'instants.size() - 1' differences, where element 'i' is 'instants[i + 1]' minus
+ * 'instants[i]', or no differences if 'instants' has less than 2 elements.
+ */
+std::vector<int64_t> diff(std::span<const Instant> instants);
+
+/**
+ * Gets every pair of consecutive 'instants' further apart than 'max_gap', such as the
+ * outages of a feed.
+ *
+ * Blocks of differences are first checked with a single comparison per element that the
+ * compiler can vectorize, so a series without gaps is read at close to memory bandwidth.
+ * Only blocks with a gap are scanned again for its position.
+ *
+ * @param instants 'Instants' of the series, sorted in ascending order.
+ * @param max_gap longest allowed time between consecutive 'instants'.
+ *
+ * @return the gaps in order.
+ *
+ * @throws std::invalid_argument if 'max_gap' is negative.
+ */
+std::vector<Gap> find_gaps(std::span<const Instant> instants, TimeDelta max_gap);
+
+/**
+ * Detects gaps in a live series as its 'Instants' arrive.
+ *
+ * @example
+ * GapDetector detector = GapDetector(TimeDelta(0, 0, 0, 5));
+ * if (std::optional<Gap> gap = detector.push(message.instant))
+ *     alert(*gap);
+ *
+ * @see find_gaps
+ */
+class GapDetector
+{
+public:
+
+    /**
+     * Creates a 'GapDetector' that reports consecutive 'Instants' further apart than
+     * 'max_gap'.
+     *
+     * @param max_gap longest allowed time between consecutive 'Instants'.
+     *
+     * @throws std::invalid_argument if 'max_gap' is negative.
+     */
+    explicit GapDetector(TimeDelta max_gap);
+
+    /**
+     * Adds the next 'Instant' of the series.
+     *
+     * @param instant next 'Instant'.
+     *
+     * @return the gap before 'instant', or 'std::nullopt' if there is none.
+     */
+    std::optional<Gap> push(Instant instant);
+
+    /**
+     * Adds the next 'Instants' of the series.
+     *
+     * @param instants next 'Instants'.
+     * @param gaps appended with the gaps before any of 'instants'.
+     */
+    void push(std::span<const Instant> instants, std::vector<Gap>& gaps);
+
+    /**
+     * Gets the number of 'Instants' added.
+     *
+     * @return the number of 'Instants' added.
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+private:
+
+    int64_t max_gap;
+
+    Instant previous;
+
+    size_t count = 0;
+};
+
+#endif //DATETIME_GAPS_H
@@ -0,0 +1,61 @@
+#ifndef DATETIME_HISTOGRAM_H
+#define DATETIME_HISTOGRAM_H
+
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "datetime/datetime/datetime_range.h"
+#include "datetime/instant/instant.h"
+#include "datetime/timedelta/timedelta.h"
+
+/**
+ * Counts the 'instants' in each bucket of 'bucket_width' from the start of 'domain', such as
+ * the messages per second of a feed.
+ *
+ * The buckets cover 'domain', with the end of 'domain' counted in the last bucket. 'instants'
+ * outside 'domain' are ignored and do not need to be sorted. The bucket of each 'Instant' is
+ * computed with a 'ConstantDivider', and runs of 'instants' in the same bucket are counted in
+ * a register before being added to the histogram.
+ *
+ * With a 'thread_count' above 1, 'instants' are split into that many contiguous partitions
+ * that are counted into partial histograms on their own threads, which are then summed.
+ *
+ * @param instants 'Instants' to count.
+ * @param bucket_width duration of each bucket.
+ * @param domain range of time to count.
+ * @param thread_count number of threads to count with. (default 1)
+ *
+ * @return number of 'instants' in each bucket, where bucket 'i' starts 'i * bucket_width'
+ * after the start of 'domain'.
+ *
+ * @throws std::invalid_argument if 'bucket_width' is not positive or 'thread_count' is 0.
+ *
+ * @example
+ * // Messages per second during the session
+ * std::vector<uint64_t> rates = histogram(instants, TimeDelta(0, 0, 0, 1), session);
+ */
+std::vector<uint64_t> histogram(std::span<const Instant> instants, TimeDelta bucket_width,
+                                const DatetimeRange& domain, unsigned thread_count = 1);
+
+/**
+ * Sums 'weights' in each bucket of 'bucket_width' from the start of 'domain', such as the
+ * traded volume per minute.
+ *
+ * @param instants 'Instants' of the weights.
+ * @param weights weight of each of 'instants'.
+ * @param bucket_width duration of each bucket.
+ * @param domain range of time to sum.
+ * @param thread_count number of threads to sum with. (default 1)
+ *
+ * @return sum of the 'weights' of the 'instants' in each bucket.
+ *
+ * @throws std::invalid_argument if 'weights' and 'instants' have different sizes,
+ * 'bucket_width' is not positive or 'thread_count' is 0.
+ *
+ * @see histogram(std::span<const Instant>, TimeDelta, const DatetimeRange&, unsigned)
+ */
+std::vector<double> histogram(std::span<const Instant> instants, std::span<const double> weights,
+                              TimeDelta bucket_width, const DatetimeRange& domain,
+                              unsigned thread_count = 1);
+
+#endif //DATETIME_HISTOGRAM_H
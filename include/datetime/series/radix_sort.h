@@ -0,0 +1,64 @@
+#ifndef DATETIME_RADIX_SORT_H
+#define DATETIME_RADIX_SORT_H
+
+#include <cstddef>
+#include <span>
+#include <vector>
+#include "datetime/datetime/datetime.h"
+#include "datetime/instant/instant.h"
+
+/**
+ * Sorts 'instants' in ascending order with a least significant digit radix sort.
+ *
+ * Each 'Instant' is sorted by its 64-bit nanoseconds in passes of 11 bits. The digits of
+ * every pass are counted up front, and a pass is skipped when all 'instants' share its digit,
+ * which is the case for the high digits of timestamps within a few days of each other.
+ *
+ * With a 'thread_count' above 1, a most significant digit pass first splits 'instants' into
+ * 256 buckets in parallel, then the buckets are sorted by the remaining digits in parallel.
+ *
+ * @param instants 'Instants' to sort.
+ * @param thread_count number of threads to sort with. (default 1)
+ *
+ * @throws std::invalid_argument if 'thread_count' is 0.
+ */
+void radix_sort(std::span<Instant> instants, unsigned thread_count = 1);
+
+/**
+ * Sorts 'datetimes' in ascending order with a radix sort of their 'Instants'.
+ *
+ * The sort is stable, so equal 'Datetimes' in different timezones keep their order.
+ *
+ * @param datetimes 'Datetimes' to sort.
+ * @param thread_count number of threads to sort with. (default 1)
+ *
+ * @throws std::invalid_argument if 'thread_count' is 0.
+ *
+ * @see radix_sort(std::span<Instant>, unsigned)
+ */
+void radix_sort(std::span<Datetime> datetimes, unsigned thread_count = 1);
+
+/**
+ * Gets the order that sorts 'instants', such as to reorder the other columns of a feed by
+ * timestamp.
+ *
+ * @param instants 'Instants' to sort.
+ * @param thread_count number of threads to sort with. (default 1)
+ *
+ * @return indexes of 'instants' in ascending order of 'Instant', equal 'Instants' keeping
+ * their order.
+ *
+ * @throws std::invalid_argument if 'thread_count' is 0.
+ *
+ * @see radix_sort(std::span<Instant>, unsigned)
+ */
+std::vector<size_t> argsort(std::span<const Instant> instants, unsigned thread_count = 1);
+
+/**
+ * Gets the order that sorts 'datetimes'.
+ *
+ * @see argsort(std::span<const Instant>, unsigned)
+ */
+std::vector<size_t> argsort(std::span<const Datetime> datetimes, unsigned thread_count = 1);
+
+#endif //DATETIME_RADIX_SORT_H
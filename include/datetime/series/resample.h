@@ -0,0 +1,235 @@
+#ifndef DATETIME_RESAMPLE_H
+#define DATETIME_RESAMPLE_H
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+#include "datetime/instant/instant.h"
+#include "datetime/time/timezone.h"
+#include "datetime/timedelta/timedelta.h"
+#include "../../../src/util/constant_divider.h"
+
+/**
+ * Evenly spaced buckets of time that 'Instants' are grouped into, such as the bars of an
+ * OHLC series.
+ *
+ * Buckets either start every 'width' from a fixed origin, or restart every day at a fixed
+ * time of day in a timezone, such as local midnight or the open of a session. The bucket of
+ * an 'Instant' is computed with integer arithmetic on its nanoseconds, using a
+ * 'ConstantDivider' instead of a hardware division.
+ *
+ * @example
+ * // 5 minute bars starting at 09:30 in EST every day.
+ * BucketGrid grid = BucketGrid(TimeDelta(0, 0, 5), TZ::EST, TimeDelta(0, 9, 30));
+ * int64_t bucket = grid.bucket_id(instant);
+ * Instant bar_start = grid.bucket_start(bucket);
+ */
+class BucketGrid
+{
+public:
+
+    /**
+     * Creates a 'BucketGrid' with a bucket starting every 'width' from 'origin'.
+     *
+     * @param width duration of each bucket.
+     * @param origin start of the bucket with id 0. (default Unix epoch)
+     *
+     * @throws std::invalid_argument if 'width' is not positive.
+     */
+    explicit BucketGrid(TimeDelta width, Instant origin = Instant());
+
+    /**
+     * Creates a 'BucketGrid' whose buckets restart every day at 'day_offset' after midnight
+     * in 'timezone'.
+     *
+     * If 'width' does not divide a day evenly, the last bucket of each day is shorter. Ids
+     * are consecutive within a day but skip between days.
+     *
+     * @param width duration of each bucket.
+     * @param timezone timezone whose midnight the buckets are aligned to.
+     * @param day_offset time after midnight the first bucket of each day starts at.
+     * (default 0)
+     *
+     * @throws std::invalid_argument if 'width' is not positive.
+     */
+    BucketGrid(TimeDelta width, Timezone timezone, TimeDelta day_offset = TimeDelta());
+
+    /**
+     * Gets the id of the bucket 'instant' is in.
+     *
+     * @param instant 'Instant' to get the bucket of.
+     *
+     * @return id of the bucket 'instant' is in.
+     */
+    int64_t bucket_id(Instant instant) const
+    {
+        int64_t offset = instant.nanoseconds - origin.nanoseconds;
+        if (buckets_per_day == 0)
+            return width_divider.floor_divide(offset);
+
+        int64_t day = day_divider.floor_divide(offset);
+        int64_t time_of_day = offset - day * Instant::NANOSECONDS_PER_DAY;
+        return day * buckets_per_day
+            + static_cast<int64_t>(width_divider.divide(static_cast<uint64_t>(time_of_day)));
+    }
+
+    /**
+     * Gets the id of the bucket of each of 'instants'.
+     *
+     * @param instants 'Instants' to get the bucket of.
+     * @param out set to the id of the bucket of each of 'instants'.
+     *
+     * @throws std::invalid_argument if 'out' is smaller than 'instants'.
+     */
+    void bucket_ids(std::span<const Instant> instants, std::span<int64_t> out) const;
+
+    /**
+     * Gets the start of the bucket with id 'id'.
+     *
+     * @param id id of the bucket.
+     *
+     * @return start of the bucket.
+     */
+    Instant bucket_start(int64_t id) const;
+
+    /**
+     * Gets the end of the bucket with id 'id', which is the first 'Instant' after the bucket.
+     *
+     * @param id id of the bucket.
+     *
+     * @return end of the bucket.
+     */
+    Instant bucket_end(int64_t id) const;
+
+private:
+
+    /**
+     * Start of bucket 0.
+     */
+    Instant origin;
+
+    ConstantDivider width_divider;
+
+    ConstantDivider day_divider;
+
+    /**
+     * Number of buckets that start each day, or 0 if the buckets do not restart every day.
+     */
+    int64_t buckets_per_day = 0;
+};
+
+/**
+ * Gets the id of the bucket of each of 'instants', where buckets start every 'width' from
+ * 'origin'.
+ *
+ * @param instants 'Instants' to get the bucket of.
+ * @param width duration of each bucket.
+ * @param origin start of the bucket with id 0.
+ * @param out set to the id of the bucket of each of 'instants'.
+ *
+ * @see BucketGrid
+ */
+void bucket_ids(std::span<const Instant> instants, TimeDelta width, Instant origin,
+                std::span<int64_t> out);
+
+/**
+ * Detects the bucket boundaries of a sorted stream of 'Instants'.
+ *
+ * @example
+ * Resampler resampler = Resampler(BucketGrid(TimeDelta(0, 0, 1)));
+ * for (const Trade& trade : trades)
+ * {
+ *     if (resampler.push(trade.instant) && bar.count > 0)
+ *         emit(bar);
+ *     bar.add(trade);
+ * }
+ */
+class Resampler
+{
+public:
+
+    /**
+     * Creates a 'Resampler' that groups 'Instants' into the buckets of 'grid'.
+     *
+     * @param grid buckets to group into.
+     */
+    explicit Resampler(BucketGrid grid) :
+        grid(std::move(grid)) {}
+
+    /**
+     * Adds the next 'Instant' of the stream.
+     *
+     * @param instant next 'Instant', not before the previous one.
+     *
+     * @return 'true' if 'instant' is the first 'Instant' of its bucket, 'false' otherwise.
+     *
+     * @throws std::invalid_argument if 'instant' is before the previous 'Instant'.
+     */
+    bool push(Instant instant);
+
+    /**
+     * Adds the next 'Instants' of the stream.
+     *
+     * @param instants next 'Instants', sorted in ascending order.
+     * @param boundaries appended with the index in 'instants' of every 'Instant' that is the
+     * first of its bucket.
+     *
+     * @throws std::invalid_argument if 'instants' are not sorted.
+     */
+    void push(std::span<const Instant> instants, std::vector<size_t>& boundaries);
+
+    /**
+     * Checks if any 'Instant' has been added.
+     *
+     * @return 'true' if an 'Instant' has been added, 'false' otherwise.
+     */
+    bool started() const
+    {
+        return has_bucket;
+    }
+
+    /**
+     * Gets the id of the bucket of the last added 'Instant'.
+     *
+     * @return id of the current bucket.
+     */
+    int64_t bucket_id() const
+    {
+        return current_bucket;
+    }
+
+    /**
+     * Gets the start of the bucket of the last added 'Instant'.
+     *
+     * @return start of the current bucket.
+     */
+    Instant bucket_start() const
+    {
+        return grid.bucket_start(current_bucket);
+    }
+
+    /**
+     * Gets the end of the bucket of the last added 'Instant'.
+     *
+     * @return end of the current bucket.
+     */
+    Instant bucket_end() const
+    {
+        return current_end;
+    }
+
+private:
+
+    BucketGrid grid;
+
+    bool has_bucket = false;
+
+    int64_t current_bucket = 0;
+
+    Instant current_end;
+
+    Instant last_instant;
+};
+
+#endif //DATETIME_RESAMPLE_H
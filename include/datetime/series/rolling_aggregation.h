@@ -0,0 +1,235 @@
+#ifndef DATETIME_ROLLING_AGGREGATION_H
+#define DATETIME_ROLLING_AGGREGATION_H
+
+#include <concepts>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <vector>
+
+/**
+ * Aggregation kept up to date by a 'RollingWindow' as elements enter and leave it.
+ *
+ * 'add' is called with every element entering the window and 'remove' with every element
+ * leaving it, in the order they were added.
+ *
+ * @see RollingWindow
+ */
+template<typename A, typename T>
+concept RollingAggregation = requires(A aggregation, const A& const_aggregation, const T& value)
+{
+    aggregation.add(value);
+    aggregation.remove(value);
+    aggregation.clear();
+    const_aggregation.value();
+};
+
+/**
+ * Associative operation with an identity, such as addition or the maximum.
+ *
+ * @see MonoidAggregation
+ */
+template<typename M>
+concept Monoid = requires(const typename M::value_type& value)
+{
+    { M::identity() } -> std::convertible_to<typename M::value_type>;
+    { M::combine(value, value) } -> std::convertible_to<typename M::value_type>;
+};
+
+/**
+ * Number of elements in the window.
+ */
+template<typename T>
+class CountAggregation
+{
+public:
+
+    void add(const T&)
+    {
+        count++;
+    }
+
+    void remove(const T&)
+    {
+        count--;
+    }
+
+    void clear()
+    {
+        count = 0;
+    }
+
+    size_t value() const
+    {
+        return count;
+    }
+
+private:
+    size_t count = 0;
+};
+
+/**
+ * Sum of the elements in the window, updated in O(1) by subtracting the elements that leave.
+ *
+ * @tparam T type of the elements. Must support '+=' and '-='.
+ * @tparam Sum type of the sum. (default T)
+ */
+template<typename T, typename Sum = T>
+class SumAggregation
+{
+public:
+
+    void add(const T& value)
+    {
+        sum += value;
+    }
+
+    void remove(const T& value)
+    {
+        sum -= value;
+    }
+
+    void clear()
+    {
+        sum = Sum();
+    }
+
+    Sum value() const
+    {
+        return sum;
+    }
+
+private:
+    Sum sum = Sum();
+};
+
+/**
+ * Extreme of the elements in the window by 'Compare', such as the minimum for 'std::less'.
+ *
+ * Keeps a monotonic deque of the elements that may still become the extreme, so adding and
+ * removing an element is amortized O(1).
+ *
+ * @tparam T type of the elements.
+ * @tparam Compare 'Compare(a, b)' is true if 'a' is more extreme than 'b'.
+ */
+template<typename T, typename Compare>
+class ExtremeAggregation
+{
+public:
+
+    void add(const T& value)
+    {
+        // Elements less extreme than 'value' leave before it, so can never be the extreme.
+        while (!candidates.empty() && compare(value, candidates.back()))
+            candidates.pop_back();
+        candidates.push_back(value);
+    }
+
+    void remove(const T& value)
+    {
+        // Equal elements are all kept, so the front is the removed element if they are equal.
+        if (!candidates.empty() && !compare(candidates.front(), value)
+            && !compare(value, candidates.front()))
+            candidates.pop_front();
+    }
+
+    void clear()
+    {
+        candidates.clear();
+    }
+
+    /**
+     * Gets the extreme of the elements in the window.
+     *
+     * @return the extreme, undefined if the window is empty.
+     */
+    const T& value() const
+    {
+        return candidates.front();
+    }
+
+private:
+    std::deque<T> candidates;
+
+    [[no_unique_address]] Compare compare;
+};
+
+/**
+ * Minimum of the elements in the window.
+ */
+template<typename T>
+using MinAggregation = ExtremeAggregation<T, std::less<T>>;
+
+/**
+ * Maximum of the elements in the window.
+ */
+template<typename T>
+using MaxAggregation = ExtremeAggregation<T, std::greater<T>>;
+
+/**
+ * Combination by a 'Monoid' of the elements in the window, for operations that cannot be
+ * undone such as a bitwise or.
+ *
+ * The elements are kept in two stacks: new elements are pushed on the back stack, which keeps
+ * the combination of its elements, and removed from the front stack, which keeps the
+ * combination of the elements above each position. When the front stack is empty, the back
+ * stack is moved onto it, so every element is combined a constant number of times.
+ *
+ * @tparam M 'Monoid' to combine with, whose 'value_type' must be constructible from 'T'.
+ * @tparam T type of the elements.
+ */
+template<Monoid M, typename T>
+class MonoidAggregation
+{
+public:
+    using value_type = typename M::value_type;
+
+    void add(const T& value)
+    {
+        back.push_back(value_type(value));
+        back_combined = M::combine(back_combined, back.back());
+    }
+
+    void remove(const T&)
+    {
+        if (front.empty())
+        {
+            value_type combined = M::identity();
+            for (auto it = back.rbegin(); it != back.rend(); ++it)
+            {
+                combined = M::combine(*it, combined);
+                front.push_back(combined);
+            }
+            back.clear();
+            back_combined = M::identity();
+        }
+        front.pop_back();
+    }
+
+    void clear()
+    {
+        front.clear();
+        back.clear();
+        back_combined = M::identity();
+    }
+
+    value_type value() const
+    {
+        if (front.empty())
+            return back_combined;
+        return M::combine(front.back(), back_combined);
+    }
+
+private:
+
+    /**
+     * Combination of each element with the elements added after it, oldest on top.
+     */
+    std::vector<value_type> front;
+
+    std::vector<value_type> back;
+
+    value_type back_combined = M::identity();
+};
+
+#endif //DATETIME_ROLLING_AGGREGATION_H
@@ -0,0 +1,223 @@
+#ifndef DATETIME_ROLLING_WINDOW_H
+#define DATETIME_ROLLING_WINDOW_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <fmt/format.h>
+#include "datetime/instant/instant.h"
+#include "datetime/series/rolling_aggregation.h"
+#include "datetime/timedelta/timedelta.h"
+#include "../../../src/util/macros.h"
+#include "../../../src/util/durations.h"
+
+/**
+ * Elements of a time series within 'width' of the latest 'Instant', such as the trades of the
+ * last 500 milliseconds, with 'Aggregations' kept up to date as elements enter and leave.
+ *
+ * Elements are stored in a ring buffer in the order they are pushed. Since 'Instants' only
+ * increase, expired elements are always at the front of the buffer, so each element is
+ * evicted once and pushing is amortized O(1).
+ *
+ * The window is the half-open range '(latest - width, latest]'.
+ *
+ * @tparam T type of the elements. Must be default constructible.
+ * @tparam Aggregations 'RollingAggregations' of 'T' to keep up to date.
+ *
+ * @example
+ * // Number of trades and highest price in the last 500 milliseconds.
+ * using PriceWindow = RollingWindow<double, CountAggregation<double>, MaxAggregation<double>>;
+ * PriceWindow window = PriceWindow(TimeDelta(0, 0, 0, 0, 500));
+ * window.push(trade.instant, trade.price);
+ * double high = window.get<MaxAggregation<double>>();
+ */
+template<typename T, RollingAggregation<T>... Aggregations>
+class RollingWindow
+{
+public:
+
+    /**
+     * Creates an empty 'RollingWindow' 'width' long.
+     *
+     * @param width duration of the window.
+     *
+     * @throws std::invalid_argument if 'width' is not positive.
+     */
+    explicit RollingWindow(TimeDelta width) :
+        width(positive_nanoseconds(width, "width")) {}
+
+    /**
+     * Adds 'value' at 'instant' and evicts the elements that are no longer within the window.
+     *
+     * @param instant 'Instant' of 'value', not before the latest 'Instant'.
+     * @param value element to add.
+     *
+     * @throws std::invalid_argument if 'instant' is before the latest 'Instant'.
+     */
+    void push(Instant instant, const T& value)
+    {
+        advance(instant);
+
+        if (count == capacity)
+            grow();
+        size_t slot = (head + count) & (capacity - 1);
+        instants[slot] = instant;
+        values[slot] = value;
+        count++;
+
+        std::apply([&value](auto&... aggregation) { (aggregation.add(value), ...); },
+                   aggregations);
+    }
+
+    /**
+     * Moves the end of the window to 'instant' without adding an element, evicting the elements
+     * that are no longer within the window.
+     *
+     * @param instant new latest 'Instant', not before the latest 'Instant'.
+     *
+     * @throws std::invalid_argument if 'instant' is before the latest 'Instant'.
+     */
+    void advance(Instant instant)
+    {
+        ASSERT(instant >= latest,
+               std::invalid_argument(fmt::format("instant '{}' is before the latest instant "
+                                                 "'{}'", instant.nanoseconds,
+                                                 latest.nanoseconds)));
+        latest = instant;
+
+        while (count > 0 && unsigned_distance(instant, instants[head]) >= width)
+        {
+            const T& value = values[head];
+            std::apply([&value](auto&... aggregation) { (aggregation.remove(value), ...); },
+                       aggregations);
+            head = (head + 1) & (capacity - 1);
+            count--;
+        }
+    }
+
+    /**
+     * Removes every element.
+     */
+    void clear()
+    {
+        head = 0;
+        count = 0;
+        std::apply([](auto&... aggregation) { (aggregation.clear(), ...); }, aggregations);
+    }
+
+    /**
+     * Gets the value of the aggregation 'Aggregation'.
+     *
+     * @tparam Aggregation one of 'Aggregations'.
+     *
+     * @return the value of 'Aggregation' over the elements in the window.
+     */
+    template<typename Aggregation>
+    decltype(auto) get() const
+    {
+        return std::get<Aggregation>(aggregations).value();
+    }
+
+    /**
+     * Gets the number of elements in the window.
+     *
+     * @return the number of elements.
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * Checks if the window has no elements.
+     *
+     * @return 'true' if the window is empty, 'false' otherwise.
+     */
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * Gets the 'index'th oldest element in the window.
+     *
+     * @param index index of the element, 0 being the oldest.
+     *
+     * @return the element.
+     */
+    const T& operator[](size_t index) const
+    {
+        return values[(head + index) & (capacity - 1)];
+    }
+
+    /**
+     * Gets the 'Instant' of the 'index'th oldest element in the window.
+     *
+     * @param index index of the element, 0 being the oldest.
+     *
+     * @return the 'Instant' of the element.
+     */
+    Instant instant(size_t index) const
+    {
+        return instants[(head + index) & (capacity - 1)];
+    }
+
+    /**
+     * Gets the latest 'Instant' pushed or advanced to.
+     *
+     * @return the end of the window.
+     */
+    Instant end() const
+    {
+        return latest;
+    }
+
+private:
+
+    uint64_t width;
+
+    Instant latest = Instant(std::numeric_limits<int64_t>::min());
+
+    std::unique_ptr<Instant[]> instants;
+
+    std::unique_ptr<T[]> values;
+
+    /**
+     * Size of the buffers, always a power of 2 so positions wrap with a mask.
+     */
+    size_t capacity = 0;
+
+    /**
+     * Position of the oldest element.
+     */
+    size_t head = 0;
+
+    size_t count = 0;
+
+    std::tuple<Aggregations...> aggregations;
+
+    /**
+     * Doubles the capacity, moving the elements to the start of the new buffers.
+     */
+    void grow()
+    {
+        size_t new_capacity = capacity == 0 ? 16 : capacity * 2;
+        auto new_instants = std::make_unique<Instant[]>(new_capacity);
+        auto new_values = std::make_unique<T[]>(new_capacity);
+        for (size_t i = 0; i < count; ++i)
+        {
+            new_instants[i] = instants[(head + i) & (capacity - 1)];
+            new_values[i] = std::move(values[(head + i) & (capacity - 1)]);
+        }
+        instants = std::move(new_instants);
+        values = std::move(new_values);
+        capacity = new_capacity;
+        head = 0;
+    }
+};
+
+#endif //DATETIME_ROLLING_WINDOW_H
@@ -0,0 +1,145 @@
+#ifndef DATETIME_TIME_INDEX_H
+#define DATETIME_TIME_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+#include "datetime/datetime/datetime_range.h"
+#include "datetime/instant/instant.h"
+
+/**
+ * Sorted column of 'Instants' that answers bound and range queries faster than a binary
+ * search.
+ *
+ * Timestamps of a day are spread almost uniformly, so the position of an 'Instant' is first
+ * guessed by linear interpolation between the ends of the searched interval. The guess is
+ * then corrected by galloping away from it, which brackets the answer in a few probes even
+ * when the spread is not uniform. A binary search finishes the bracketed interval.
+ *
+ * Every 'SAMPLE_STRIDE'th 'Instant' is also copied to a small sample, which is searched the
+ * same way first so the probes into the column stay within a single block.
+ *
+ * @example
+ * TimeIndex index = TimeIndex(std::move(trade_instants));
+ * auto [first, last] = index.range(DatetimeRange(Datetime(2022, 1, 3, 9, 30),
+ *                                                Datetime(2022, 1, 3, 10)));
+ */
+class TimeIndex
+{
+public:
+
+    /**
+     * Number of 'Instants' between two sampled 'Instants'.
+     */
+    static constexpr size_t SAMPLE_STRIDE = 4096;
+
+    /**
+     * Creates a 'TimeIndex' over 'instants'.
+     *
+     * @param instants 'Instants' sorted in ascending order.
+     * @param sample whether to build the sample of every 'SAMPLE_STRIDE'th 'Instant'.
+     * (default true)
+     *
+     * @throws std::invalid_argument if 'instants' is not sorted.
+     */
+    explicit TimeIndex(std::vector<Instant> instants, bool sample = true);
+
+    /**
+     * Gets the number of 'Instants' in the index.
+     *
+     * @return the number of 'Instants'.
+     */
+    size_t size() const
+    {
+        return keys.size();
+    }
+
+    /**
+     * Checks if the index has no 'Instants'.
+     *
+     * @return 'true' if the index is empty, 'false' otherwise.
+     */
+    bool empty() const
+    {
+        return keys.empty();
+    }
+
+    /**
+     * Gets the 'Instant' at 'index'.
+     *
+     * @param index index of the 'Instant'.
+     *
+     * @return the 'Instant' at 'index'.
+     */
+    Instant operator[](size_t index) const
+    {
+        return keys[index];
+    }
+
+    /**
+     * Gets the indexed 'Instants'.
+     *
+     * @return the 'Instants' in ascending order.
+     */
+    std::span<const Instant> instants() const
+    {
+        return keys;
+    }
+
+    /**
+     * Gets the index of the first 'Instant' that is not before 'instant'.
+     *
+     * @param instant 'Instant' to search for.
+     *
+     * @return index of the first 'Instant' at or after 'instant', or 'size()' if there is none.
+     */
+    size_t lower_bound(Instant instant) const;
+
+    /**
+     * Gets the index of the first 'Instant' that is after 'instant'.
+     *
+     * @param instant 'Instant' to search for.
+     *
+     * @return index of the first 'Instant' after 'instant', or 'size()' if there is none.
+     */
+    size_t upper_bound(Instant instant) const;
+
+    /**
+     * Gets the indexes of the 'Instants' from 'start' to 'end', both included.
+     *
+     * @param start first 'Instant' of the range.
+     * @param end last 'Instant' of the range.
+     *
+     * @return '[first, last)' indexes of the 'Instants' in range.
+     */
+    std::pair<size_t, size_t> range(Instant start, Instant end) const;
+
+    /**
+     * Gets the indexes of the 'Instants' in 'datetime_range'.
+     *
+     * @param datetime_range range to get the 'Instants' of.
+     *
+     * @return '[first, last)' indexes of the 'Instants' in range.
+     */
+    std::pair<size_t, size_t> range(const DatetimeRange& datetime_range) const;
+
+private:
+
+    std::vector<Instant> keys;
+
+    /**
+     * Every 'SAMPLE_STRIDE'th of 'keys', starting with the first, or empty if not sampled.
+     */
+    std::vector<Instant> samples;
+
+    /**
+     * Gets the first index of 'keys' whose 'Instant' is not before 'instant', or not at or
+     * before it if 'upper'.
+     */
+    template<bool upper>
+    size_t search(Instant instant) const;
+};
+
+#endif //DATETIME_TIME_INDEX_H
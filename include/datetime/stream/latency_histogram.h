@@ -0,0 +1,191 @@
+#ifndef DATETIME_LATENCY_HISTOGRAM_H
+#define DATETIME_LATENCY_HISTOGRAM_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <vector>
+#include <fmt/format.h>
+#include "datetime/timedelta/timedelta.h"
+#include "../../../src/util/macros.h"
+
+/**
+ * Histogram of latencies, such as tick to trade times, with a bounded relative error.
+ *
+ * Latencies below '2^precision_bits' nanoseconds are counted exactly. Above that, every power
+ * of 2 is split into '2^(precision_bits - 1)' buckets of equal width, so a latency is reported
+ * within a relative error of '2^(1 - precision_bits)' across the whole range of 'TimeDelta'.
+ * The bucket of a latency is computed from the position of its highest bit, and recording it
+ * is a single relaxed atomic increment, so any number of threads can record without waiting.
+ *
+ * To avoid contention on hot buckets, each thread can record into its own histogram and the
+ * histograms can be merged when reporting.
+ *
+ * @example
+ * LatencyHistogram tick_to_trade = LatencyHistogram();
+ * tick_to_trade.record(order.sent - tick.received);
+ * TimeDelta p99 = tick_to_trade.percentile(99);
+ */
+class LatencyHistogram
+{
+public:
+
+    /**
+     * Creates an empty 'LatencyHistogram'.
+     *
+     * @param precision_bits number of significant bits a latency is counted with, between 1
+     * and 16. (default 8, an error below 1%)
+     *
+     * @throws std::invalid_argument if 'precision_bits' is out of range.
+     */
+    explicit LatencyHistogram(uint32_t precision_bits = 8);
+
+    /**
+     * Records a latency of 'latency'.
+     *
+     * @param latency latency to record.
+     *
+     * @throws std::invalid_argument if 'latency' is negative.
+     */
+    void record(TimeDelta latency)
+    {
+        record_nanoseconds(latency.total_nanoseconds());
+    }
+
+    /**
+     * Records a latency of 'nanoseconds' nanoseconds.
+     *
+     * @param nanoseconds latency to record.
+     *
+     * @throws std::invalid_argument if 'nanoseconds' is negative.
+     */
+    void record_nanoseconds(int64_t nanoseconds)
+    {
+        ASSERT(nanoseconds >= 0,
+               std::invalid_argument(fmt::format("latency '{}' must not be negative",
+                                                 nanoseconds)));
+        counts[bucket_of(static_cast<uint64_t>(nanoseconds))].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Adds every latency recorded in 'other'.
+     *
+     * @param other histogram to add.
+     *
+     * @throws std::invalid_argument if 'other' has a different precision.
+     */
+    void merge(const LatencyHistogram& other);
+
+    /**
+     * Removes every recorded latency.
+     */
+    void reset();
+
+    /**
+     * Gets the number of recorded latencies.
+     *
+     * @return the number of recorded latencies.
+     */
+    uint64_t count() const;
+
+    /**
+     * Gets the smallest recorded latency.
+     *
+     * @return the lowest latency in the bucket of the smallest latency, or 0 if none was
+     * recorded.
+     */
+    TimeDelta min() const;
+
+    /**
+     * Gets the largest recorded latency.
+     *
+     * @return the highest latency in the bucket of the largest latency, or 0 if none was
+     * recorded.
+     */
+    TimeDelta max() const;
+
+    /**
+     * Gets the mean of the recorded latencies, using the middle of each bucket.
+     *
+     * @return the mean latency, or 0 if none was recorded.
+     */
+    TimeDelta mean() const;
+
+    /**
+     * Gets the latency 'percentile' percent of the recorded latencies are at or below.
+     *
+     * @param percentile percentage of latencies, between 0 and 100.
+     *
+     * @return the highest latency in the bucket of the latency at 'percentile', or 0 if none
+     * was recorded.
+     *
+     * @throws std::invalid_argument if 'percentile' is out of range.
+     */
+    TimeDelta percentile(double percentile) const;
+
+    /**
+     * Gets the number of significant bits latencies are counted with.
+     *
+     * @return the precision in bits.
+     */
+    uint32_t precision() const
+    {
+        return precision_bits;
+    }
+
+    /**
+     * Encodes the histogram, where runs of empty buckets are stored as their length and every
+     * count as a variable length integer.
+     *
+     * @return the encoded histogram.
+     */
+    std::vector<uint8_t> serialize() const;
+
+    /**
+     * Decodes a histogram encoded by 'serialize'.
+     *
+     * @param bytes encoded histogram.
+     *
+     * @return the decoded histogram.
+     *
+     * @throws std::invalid_argument if 'bytes' is not a valid encoded histogram.
+     */
+    static LatencyHistogram deserialize(std::span<const uint8_t> bytes);
+
+private:
+
+    uint32_t precision_bits;
+
+    size_t bucket_count;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> counts;
+
+    /**
+     * Gets the bucket of 'value', where bucket 'e * 2^(precision_bits - 1) + m' holds the
+     * values whose top 'precision_bits' bits are 'm' after dropping 'e' low bits.
+     */
+    size_t bucket_of(uint64_t value) const
+    {
+        uint32_t exponent = std::max(static_cast<uint32_t>(std::bit_width(value)), precision_bits)
+            - precision_bits;
+        return (size_t(exponent) << (precision_bits - 1)) + (value >> exponent);
+    }
+
+    /**
+     * Gets the lowest value in 'bucket'.
+     */
+    uint64_t lowest_of(size_t bucket) const;
+
+    /**
+     * Gets the highest value in 'bucket'.
+     */
+    uint64_t highest_of(size_t bucket) const;
+};
+
+#endif //DATETIME_LATENCY_HISTOGRAM_H
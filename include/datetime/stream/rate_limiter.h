@@ -0,0 +1,231 @@
+#ifndef DATETIME_RATE_LIMITER_H
+#define DATETIME_RATE_LIMITER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "datetime/instant/instant.h"
+#include "datetime/timedelta/timedelta.h"
+
+/**
+ * Token bucket that allows 'permits' per 'period' on average and bursts of up to 'burst'
+ * permits, such as an exchange throttle of 100 messages per second.
+ *
+ * Implemented as a generic cell rate algorithm: instead of a token count that is refilled,
+ * the limiter stores the theoretical arrival time of the next permit, which advances by
+ * 'period' / 'permits' for each acquired permit and never falls behind the current time.
+ * A batch of permits is acquired if the new arrival time is within 'burst' permits of now,
+ * so acquiring is a single compare and swap of an 'std::atomic<int64_t>', without locks,
+ * from any number of threads.
+ *
+ * Time is read with 'Instant::monotonic_now()', so the limiter runs against a simulated clock
+ * when 'Instant::mock_instant' is set, or is passed explicitly. If an explicitly passed clock
+ * steps back, such as on an NTP correction, the bucket is emptied at the earlier time, so
+ * permits resume at the rate instead of after the step and the limiter still never allows more
+ * than its rate. Arrival
+ * times past the last 'Instant' are clamped to it instead of overflowing.
+ *
+ * A token bucket allows up to 'burst' plus 'permits' in a period that starts with a full
+ * bucket. Use a 'SlidingWindowRateLimiter' for limits on every rolling period.
+ *
+ * @example
+ * RateLimiter throttle = RateLimiter(100, TimeDelta(0, 0, 0, 1));
+ * if (throttle.try_acquire())
+ *     send(order);
+ * ...
+ * co_await loop.at(throttle.available_at(orders.size()));
+ */
+class RateLimiter
+{
+public:
+
+    /**
+     * Creates a 'RateLimiter' with a full bucket.
+     *
+     * @param permits number of permits per 'period'.
+     * @param period duration 'permits' are allowed in.
+     * @param burst number of permits that can be acquired at once.
+     *
+     * @throws std::invalid_argument if 'permits' or 'burst' is 0, or if 'period' is not
+     * positive.
+     */
+    RateLimiter(uint64_t permits, const TimeDelta& period, uint64_t burst);
+
+    /**
+     * Creates a 'RateLimiter' with a full bucket and a burst of 'permits'.
+     *
+     * @see RateLimiter(uint64_t, const TimeDelta&, uint64_t)
+     */
+    RateLimiter(uint64_t permits, const TimeDelta& period) :
+        RateLimiter(permits, period, permits) {}
+
+    /**
+     * Acquires 'permits' permits at 'now' if they are available.
+     *
+     * @param permits number of permits to acquire together.
+     * @param now current time.
+     *
+     * @return 'true' if the permits were acquired, 'false' otherwise.
+     *
+     * @throws std::invalid_argument if 'permits' is more than the burst.
+     */
+    bool try_acquire(uint64_t permits, Instant now);
+
+    /**
+     * Acquires 'permits' permits at 'Instant::monotonic_now()' if they are available.
+     *
+     * @see try_acquire(uint64_t, Instant)
+     */
+    bool try_acquire(uint64_t permits = 1)
+    {
+        return try_acquire(permits, Instant::monotonic_now());
+    }
+
+    /**
+     * Gets the earliest time 'permits' permits can be acquired, if none are acquired before.
+     *
+     * @param permits number of permits.
+     * @param now current time.
+     *
+     * @return 'now' if the permits are available, the time they are available at otherwise.
+     *
+     * @throws std::invalid_argument if 'permits' is more than the burst.
+     */
+    Instant available_at(uint64_t permits, Instant now) const;
+
+    /**
+     * @see available_at(uint64_t, Instant)
+     */
+    Instant available_at(uint64_t permits = 1) const
+    {
+        return available_at(permits, Instant::monotonic_now());
+    }
+
+private:
+
+    /**
+     * Nanoseconds per permit, rounded up so the rate is never exceeded.
+     */
+    int64_t interval;
+
+    uint64_t burst;
+
+    /**
+     * Nanoseconds the arrival time may be ahead of now, 'burst' intervals.
+     */
+    int64_t tolerance;
+
+    /**
+     * Nanoseconds since the Unix epoch of the theoretical arrival time of the next permit,
+     * on its own cache line so threads acquiring permits do not contend with other data.
+     */
+    alignas(64) std::atomic<int64_t> arrival;
+};
+
+/**
+ * Limiter that allows at most 'permits' in every rolling 'period', such as an exchange
+ * throttle of "100 messages per rolling second".
+ *
+ * The times of the permits acquired in the last 'period' are kept in a ring buffer of
+ * 'permits' entries, and a batch is acquired if it fits next to the entries that have not
+ * expired. Unlike a 'RateLimiter', no burst can exceed the limit in any window, but a
+ * 'SlidingWindowRateLimiter' is not thread safe.
+ *
+ * If the clock steps back, the permits acquired after the earlier time are treated as
+ * acquired at it, so they expire a period later instead of after the step.
+ *
+ * @example
+ * SlidingWindowRateLimiter throttle = SlidingWindowRateLimiter(100, TimeDelta(0, 0, 0, 1));
+ * if (throttle.try_acquire(orders.size()))
+ *     send(orders);
+ */
+class SlidingWindowRateLimiter
+{
+public:
+
+    /**
+     * Creates a 'SlidingWindowRateLimiter' with no acquired permits.
+     *
+     * @param permits number of permits allowed in every rolling 'period'.
+     * @param period duration of the window.
+     *
+     * @throws std::invalid_argument if 'permits' is 0 or 'period' is not positive.
+     */
+    SlidingWindowRateLimiter(uint64_t permits, const TimeDelta& period);
+
+    /**
+     * Acquires 'permits' permits at 'now' if acquiring them keeps at most the limit in the
+     * window that ends at 'now'.
+     *
+     * @param permits number of permits to acquire together.
+     * @param now current time.
+     *
+     * @return 'true' if the permits were acquired, 'false' otherwise.
+     *
+     * @throws std::invalid_argument if 'permits' is more than the limit.
+     */
+    bool try_acquire(uint64_t permits, Instant now);
+
+    /**
+     * Acquires 'permits' permits at 'Instant::monotonic_now()' if they are available.
+     *
+     * @see try_acquire(uint64_t, Instant)
+     */
+    bool try_acquire(uint64_t permits = 1)
+    {
+        return try_acquire(permits, Instant::monotonic_now());
+    }
+
+    /**
+     * Gets the earliest time 'permits' permits can be acquired, if none are acquired before.
+     *
+     * @param permits number of permits.
+     * @param now current time.
+     *
+     * @return 'now' if the permits are available, the time they are available at otherwise.
+     *
+     * @throws std::invalid_argument if 'permits' is more than the limit.
+     */
+    Instant available_at(uint64_t permits, Instant now) const;
+
+    /**
+     * @see available_at(uint64_t, Instant)
+     */
+    Instant available_at(uint64_t permits = 1) const
+    {
+        return available_at(permits, Instant::monotonic_now());
+    }
+
+private:
+
+    int64_t period;
+
+    /**
+     * Nanoseconds since the Unix epoch of the acquired permits, oldest first from 'oldest'.
+     */
+    std::vector<int64_t> times;
+
+    size_t oldest = 0;
+
+    size_t count = 0;
+
+    /**
+     * Gets the time of the 'i'-th oldest acquired permit.
+     */
+    int64_t time_at(size_t i) const
+    {
+        return times[index_of(i)];
+    }
+
+    /**
+     * Gets the index in 'times' of the 'i'-th oldest acquired permit.
+     */
+    size_t index_of(size_t i) const
+    {
+        size_t index = oldest + i;
+        return index < times.size() ? index : index - times.size();
+    }
+};
+
+#endif //DATETIME_RATE_LIMITER_H
@@ -0,0 +1,302 @@
+#ifndef DATETIME_REORDER_BUFFER_H
+#define DATETIME_REORDER_BUFFER_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <fmt/format.h>
+#include "datetime/instant/instant.h"
+#include "datetime/timedelta/timedelta.h"
+#include "../../../src/util/macros.h"
+#include "../../../src/util/math.h"
+#include "../../../src/util/durations.h"
+
+/**
+ * Buffer that puts a nearly sorted stream of timestamped items back in order, such as packets
+ * read from several queues of a network card.
+ *
+ * An item is released once the latest pushed 'Instant' is at least 'max_disorder' after it,
+ * since no earlier item is expected after that. Items pushed after an item with a later
+ * 'Instant' was released are rejected as late.
+ *
+ * Items are kept in a calendar queue: a ring of buckets that each cover 'bucket_width' of
+ * time, kept sorted within each bucket. For a nearly sorted stream an item is inserted at or
+ * near the end of its bucket, and the next item to release is at the front of the current
+ * bucket, so pushing and popping are amortized O(1).
+ *
+ * @tparam T type of the items.
+ *
+ * @example
+ * ReorderBuffer<Packet> buffer = ReorderBuffer<Packet>(TimeDelta(0, 0, 0, 0, 0, 100));
+ * buffer.push(packet.instant, packet);
+ * buffer.drain([](Instant instant, Packet& packet) { process(packet); });
+ */
+template<typename T>
+class ReorderBuffer
+{
+public:
+
+    /**
+     * Item with its 'Instant'.
+     */
+    struct Item
+    {
+        Instant instant;
+        T value;
+    };
+
+    /**
+     * Creates an empty 'ReorderBuffer'.
+     *
+     * @param max_disorder how much earlier than the latest pushed 'Instant' an item may
+     * arrive.
+     * @param bucket_width time covered by each bucket. (default 'max_disorder' / 16)
+     *
+     * @throws std::invalid_argument if 'max_disorder' is negative or 'bucket_width' is
+     * negative.
+     */
+    explicit ReorderBuffer(TimeDelta max_disorder, TimeDelta bucket_width = TimeDelta()) :
+        max_disorder(static_cast<int64_t>(non_negative_nanoseconds(max_disorder,
+                                                                   "max_disorder"))),
+        width(static_cast<int64_t>(non_negative_nanoseconds(bucket_width, "bucket_width")))
+    {
+        if (width == 0)
+            width = std::max<int64_t>(this->max_disorder / 16, 1);
+
+        // Enough buckets that the unreleased items rarely share a bucket with later ones.
+        auto span = static_cast<uint64_t>(this->max_disorder / width) + 2;
+        buckets.resize(std::bit_ceil(span));
+    }
+
+    /**
+     * Adds 'value' at 'instant'.
+     *
+     * @param instant 'Instant' of 'value'.
+     * @param value item to add.
+     *
+     * @return 'true' if 'value' was added, 'false' if it is late and was rejected.
+     */
+    bool push(Instant instant, T value)
+    {
+        if (released && instant < *released)
+        {
+            late++;
+            return false;
+        }
+
+        int64_t bucket = floor_div(instant.nanoseconds, width);
+        if (count == 0 || bucket < cursor)
+            cursor = bucket;
+        if (!latest || instant > *latest)
+            latest = instant;
+
+        // Equal 'Instants' keep the order they were pushed in.
+        Bucket& items = buckets[slot(bucket)];
+        auto position = items.items.end();
+        while (position != items.items.begin() + static_cast<std::ptrdiff_t>(items.head)
+            && (position - 1)->instant > instant)
+            --position;
+        items.items.insert(position, Item{instant, std::move(value)});
+        count++;
+        return true;
+    }
+
+    /**
+     * Removes the earliest item if it is at least 'max_disorder' before the latest pushed
+     * 'Instant'.
+     *
+     * @return the earliest item, or 'std::nullopt' if there is no item to release.
+     */
+    std::optional<Item> pop()
+    {
+        return pop_earliest(true);
+    }
+
+    /**
+     * Removes every item that can be released, earliest first.
+     *
+     * @param callback called with the 'Instant' and the item of every released item.
+     *
+     * @return number of released items.
+     */
+    template<typename Callback>
+    size_t drain(Callback&& callback)
+    {
+        size_t drained = 0;
+        while (std::optional<Item> item = pop_earliest(true))
+        {
+            callback(item->instant, item->value);
+            drained++;
+        }
+        return drained;
+    }
+
+    /**
+     * Removes every item, earliest first, such as at the end of the stream.
+     *
+     * @param callback called with the 'Instant' and the item of every item.
+     *
+     * @return number of removed items.
+     */
+    template<typename Callback>
+    size_t flush(Callback&& callback)
+    {
+        size_t flushed = 0;
+        while (std::optional<Item> item = pop_earliest(false))
+        {
+            callback(item->instant, item->value);
+            flushed++;
+        }
+        return flushed;
+    }
+
+    /**
+     * Gets the number of buffered items.
+     *
+     * @return the number of items.
+     */
+    size_t size() const
+    {
+        return count;
+    }
+
+    /**
+     * Checks if no items are buffered.
+     *
+     * @return 'true' if the buffer is empty, 'false' otherwise.
+     */
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    /**
+     * Gets the number of rejected late items.
+     *
+     * @return the number of items pushed before an already released item.
+     */
+    uint64_t late_count() const
+    {
+        return late;
+    }
+
+    /**
+     * Gets the latest pushed 'Instant'.
+     *
+     * @return the latest pushed 'Instant', or 'std::nullopt' if nothing was pushed.
+     */
+    std::optional<Instant> latest_instant() const
+    {
+        return latest;
+    }
+
+private:
+
+    /**
+     * Items of a bucket sorted by 'Instant', of which the first 'head' were already removed.
+     */
+    struct Bucket
+    {
+        std::vector<Item> items;
+
+        size_t head = 0;
+
+        bool empty() const
+        {
+            return head == items.size();
+        }
+
+        const Item& front() const
+        {
+            return items[head];
+        }
+    };
+
+    int64_t max_disorder;
+
+    int64_t width;
+
+    /**
+     * Ring of buckets, where bucket 'b' covers from 'b * width' to '(b + 1) * width'. Its size
+     * is a power of 2 so positions wrap with a mask.
+     */
+    std::vector<Bucket> buckets;
+
+    /**
+     * Bucket of the earliest item, or before it.
+     */
+    int64_t cursor = 0;
+
+    size_t count = 0;
+
+    uint64_t late = 0;
+
+    std::optional<Instant> latest;
+
+    /**
+     * 'Instant' of the latest released item.
+     */
+    std::optional<Instant> released;
+
+    size_t slot(int64_t bucket) const
+    {
+        return static_cast<size_t>(bucket) & (buckets.size() - 1);
+    }
+
+    /**
+     * Removes the earliest item, if 'only_ready' only when it is at least 'max_disorder'
+     * before the latest pushed 'Instant'.
+     */
+    std::optional<Item> pop_earliest(bool only_ready)
+    {
+        if (count == 0)
+            return std::nullopt;
+
+        // A bucket may also hold items a whole ring later, which sort after the items of
+        // the 'cursor' bucket.
+        size_t steps = 0;
+        while (steps < buckets.size())
+        {
+            const Bucket& bucket = buckets[slot(cursor)];
+            if (!bucket.empty() && floor_div(bucket.front().instant.nanoseconds, width) == cursor)
+                break;
+            cursor++;
+            steps++;
+        }
+
+        // Every item is more than a ring ahead, so jump to the bucket of the earliest.
+        if (steps == buckets.size())
+        {
+            std::optional<Instant> earliest;
+            for (const Bucket& bucket : buckets)
+            {
+                if (!bucket.empty() && (!earliest || bucket.front().instant < *earliest))
+                    earliest = bucket.front().instant;
+            }
+            cursor = floor_div(earliest->nanoseconds, width);
+        }
+
+        Bucket& bucket = buckets[slot(cursor)];
+        Instant instant = bucket.front().instant;
+        if (only_ready && unsigned_distance(*latest, instant) < static_cast<uint64_t>(max_disorder))
+            return std::nullopt;
+
+        std::optional<Item> item = std::move(bucket.items[bucket.head++]);
+        if (bucket.empty())
+        {
+            bucket.items.clear();
+            bucket.head = 0;
+        }
+        count--;
+        released = instant;
+        return item;
+    }
+};
+
+#endif //DATETIME_REORDER_BUFFER_H
@@ -0,0 +1,263 @@
+#ifndef DATETIME_TIMESTAMP_MERGER_H
+#define DATETIME_TIMESTAMP_MERGER_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <fmt/format.h>
+#include "datetime/instant/instant.h"
+#include "datetime/stream/timestamp_stream.h"
+#include "../../../src/util/macros.h"
+
+/**
+ * Merges sorted 'TimestampStreams' into a single stream in global 'Instant' order, such as to
+ * replay the files of many symbols.
+ *
+ * The streams are the leaves of a loser tree, where every node holds the stream that lost the
+ * comparison there and the root holds the overall winner. Taking the winner replays only the
+ * path from its leaf to the root, so each item costs log k integer comparisons against the
+ * stored losers. Items with equal 'Instants' are taken in the order of their streams.
+ *
+ * Each stream is read 'batch_size' items at a time into a buffer, so the virtual 'read' is
+ * called once per batch rather than once per item.
+ *
+ * @tparam T type of the items.
+ *
+ * @example
+ * std::vector<TimestampStream<Trade>*> files = ...;
+ * TimestampMerger<Trade> merger = TimestampMerger<Trade>(files);
+ * while (auto item = merger.next())
+ *     replay(item->source, item->value);
+ */
+template<typename T>
+class TimestampMerger
+{
+public:
+
+    /**
+     * Item of the merged stream with the index of its stream.
+     */
+    struct Item
+    {
+        Instant instant;
+        size_t source;
+        T value;
+    };
+
+    /**
+     * Creates a 'TimestampMerger' of 'streams', which must outlive it.
+     *
+     * @param streams streams to merge, each sorted by 'Instant'.
+     * @param batch_size number of items read from a stream at a time. (default 256)
+     *
+     * @throws std::invalid_argument if 'batch_size' is 0 or a stream is null.
+     */
+    explicit TimestampMerger(std::vector<TimestampStream<T>*> streams, size_t batch_size = 256) :
+        streams(std::move(streams)),
+        leaves(std::bit_ceil(std::max<size_t>(this->streams.size(), 1))),
+        batch_size(batch_size),
+        heads(leaves, std::numeric_limits<int64_t>::max()),
+        ended(leaves, true),
+        buffers(this->streams.size()),
+        losers(leaves)
+    {
+        ASSERT(batch_size > 0, std::invalid_argument("batch_size must be positive"));
+        for (size_t s = 0; s < this->streams.size(); ++s)
+        {
+            ASSERT(this->streams[s] != nullptr,
+                   std::invalid_argument(fmt::format("stream '{}' is null", s)));
+            buffers[s].instants.resize(batch_size);
+            buffers[s].values.resize(batch_size);
+            ended[s] = false;
+            refill(s);
+        }
+        build();
+    }
+
+    /**
+     * Removes the earliest item of every stream.
+     *
+     * @return the earliest item, or 'std::nullopt' once every stream has ended.
+     *
+     * @throws std::invalid_argument if a stream is not sorted.
+     */
+    std::optional<Item> next()
+    {
+        size_t source = losers[0];
+        if (ended[source])
+            return std::nullopt;
+
+        Buffer& buffer = buffers[source];
+        std::optional<Item> item = Item{buffer.instants[buffer.position], source,
+                                        std::move(buffer.values[buffer.position])};
+        buffer.position++;
+        advance(source);
+        return item;
+    }
+
+    /**
+     * Removes every item in order.
+     *
+     * @param callback called with the 'Instant', stream index and value of every item.
+     *
+     * @return number of items.
+     *
+     * @throws std::invalid_argument if a stream is not sorted.
+     */
+    template<typename Callback>
+    size_t drain(Callback&& callback)
+    {
+        size_t count = 0;
+        for (size_t source = losers[0]; !ended[source]; source = losers[0])
+        {
+            Buffer& buffer = buffers[source];
+            callback(buffer.instants[buffer.position], source, buffer.values[buffer.position]);
+            buffer.position++;
+            advance(source);
+            count++;
+        }
+        return count;
+    }
+
+    /**
+     * Checks if every stream has ended.
+     *
+     * @return 'true' if there are no more items, 'false' otherwise.
+     */
+    bool empty() const
+    {
+        return ended[losers[0]];
+    }
+
+private:
+
+    /**
+     * Items of a stream read but not yet merged.
+     */
+    struct Buffer
+    {
+        std::vector<Instant> instants;
+
+        std::vector<T> values;
+
+        size_t position = 0;
+
+        size_t size = 0;
+    };
+
+    std::vector<TimestampStream<T>*> streams;
+
+    /**
+     * Number of leaves, the number of streams rounded up to a power of 2. Leaves past the
+     * streams are ended.
+     */
+    size_t leaves;
+
+    size_t batch_size;
+
+    /**
+     * Nanoseconds of the next 'Instant' of each stream, the greatest value once it has ended.
+     */
+    std::vector<int64_t> heads;
+
+    std::vector<uint8_t> ended;
+
+    std::vector<Buffer> buffers;
+
+    /**
+     * Stream that lost at each node, where node 'i' has children '2 * i' and '2 * i + 1' and
+     * node 'leaves + s' is stream 's'. Node 0 holds the winner.
+     */
+    std::vector<size_t> losers;
+
+    /**
+     * Checks if the next item of stream 'lhs' comes before the next item of stream 'rhs'.
+     */
+    bool before(size_t lhs, size_t rhs) const
+    {
+        // Ended streams have the greatest head, so 'ended' is only checked on a tie.
+        if (heads[lhs] != heads[rhs])
+            return heads[lhs] < heads[rhs];
+        if (ended[lhs] != ended[rhs])
+            return ended[rhs];
+        return lhs < rhs;
+    }
+
+    /**
+     * Reads the next batch of stream 'source' if its buffer is used up, ending it if the
+     * stream has ended.
+     */
+    void refill(size_t source)
+    {
+        Buffer& buffer = buffers[source];
+        if (buffer.position < buffer.size)
+            return;
+
+        buffer.position = 0;
+        buffer.size = streams[source]->read(buffer.instants, buffer.values);
+        if (buffer.size == 0)
+            ended[source] = true;
+    }
+
+    /**
+     * Moves stream 'source' to its next item and replays its path to the root.
+     */
+    void advance(size_t source)
+    {
+        int64_t previous = heads[source];
+        refill(source);
+        if (!ended[source])
+        {
+            Buffer& buffer = buffers[source];
+            heads[source] = buffer.instants[buffer.position].nanoseconds;
+            ASSERT(heads[source] >= previous,
+                   std::invalid_argument(fmt::format("stream '{}' is not sorted", source)));
+        }
+        else
+        {
+            heads[source] = std::numeric_limits<int64_t>::max();
+        }
+
+        size_t winner = source;
+        for (size_t node = (leaves + source) / 2; node > 0; node /= 2)
+        {
+            if (before(losers[node], winner))
+                std::swap(losers[node], winner);
+        }
+        losers[0] = winner;
+    }
+
+    /**
+     * Builds the tree from the first item of every stream.
+     */
+    void build()
+    {
+        for (size_t s = 0; s < streams.size(); ++s)
+        {
+            if (!ended[s])
+                heads[s] = buffers[s].instants[0].nanoseconds;
+        }
+
+        // Winner of the subtree of each node, leaves being their own winners.
+        std::vector<size_t> winners(2 * leaves);
+        for (size_t s = 0; s < leaves; ++s)
+            winners[leaves + s] = s;
+        for (size_t node = leaves - 1; node > 0; --node)
+        {
+            size_t left = winners[2 * node];
+            size_t right = winners[2 * node + 1];
+            bool left_wins = before(left, right);
+            winners[node] = left_wins ? left : right;
+            losers[node] = left_wins ? right : left;
+        }
+        losers[0] = winners[1];
+    }
+};
+
+#endif //DATETIME_TIMESTAMP_MERGER_H
@@ -0,0 +1,85 @@
+#ifndef DATETIME_TIMESTAMP_STREAM_H
+#define DATETIME_TIMESTAMP_STREAM_H
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <fmt/format.h>
+#include "datetime/instant/instant.h"
+#include "../../../src/util/macros.h"
+
+/**
+ * Source of items sorted by 'Instant' that is read in batches, such as a file of one symbol.
+ *
+ * @tparam T type of the items.
+ *
+ * @see TimestampMerger
+ */
+template<typename T>
+class TimestampStream
+{
+public:
+
+    virtual ~TimestampStream() = default;
+
+    /**
+     * Reads the next items of the stream.
+     *
+     * @param instants set to the 'Instants' of the read items, in ascending order.
+     * @param values set to the read items, the same size as 'instants'.
+     *
+     * @return number of items read, at most 'instants.size()', or 0 once the stream has
+     * ended.
+     */
+    virtual size_t read(std::span<Instant> instants, std::span<T> values) = 0;
+};
+
+/**
+ * 'TimestampStream' over columns of 'Instants' and items already in memory.
+ *
+ * @tparam T type of the items.
+ */
+template<typename T>
+class SpanStream : public TimestampStream<T>
+{
+public:
+
+    /**
+     * Creates a 'SpanStream' over 'instants' and 'values', which must outlive it.
+     *
+     * @param instants 'Instants' of the items, sorted in ascending order.
+     * @param values items of the stream.
+     *
+     * @throws std::invalid_argument if 'instants' and 'values' have different sizes.
+     */
+    SpanStream(std::span<const Instant> instants, std::span<const T> values) :
+        instants(instants), values(values)
+    {
+        ASSERT(instants.size() == values.size(),
+               std::invalid_argument(fmt::format("instants with size '{}' and values with size "
+                                                 "'{}' must have the same size",
+                                                 instants.size(), values.size())));
+    }
+
+    size_t read(std::span<Instant> instants_out, std::span<T> values_out) override
+    {
+        size_t size = std::min({instants_out.size(), values_out.size(),
+                                instants.size() - position});
+        std::copy_n(instants.begin() + static_cast<std::ptrdiff_t>(position), size,
+                    instants_out.begin());
+        std::copy_n(values.begin() + static_cast<std::ptrdiff_t>(position), size,
+                    values_out.begin());
+        position += size;
+        return size;
+    }
+
+private:
+    std::span<const Instant> instants;
+
+    std::span<const T> values;
+
+    size_t position = 0;
+};
+
+#endif //DATETIME_TIMESTAMP_STREAM_H
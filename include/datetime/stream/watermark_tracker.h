@@ -0,0 +1,146 @@
+#ifndef DATETIME_WATERMARK_TRACKER_H
+#define DATETIME_WATERMARK_TRACKER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include "datetime/instant/instant.h"
+#include "datetime/timedelta/timedelta.h"
+
+/**
+ * Event time watermark of several out of order sources, the 'Instant' no event is expected to
+ * be older than, such as to close the bars of a merged feed.
+ *
+ * Each source's watermark is its latest event time minus the allowed lateness, and the
+ * watermark is the minimum over the sources. The latest event time of each source is a leaf
+ * of a tree where every node holds the minimum of its children, so an event updates O(log k)
+ * nodes and the watermark is read from the root.
+ *
+ * Each source must be observed by a single thread at a time, but different sources can be
+ * observed and the watermark read from any number of threads without locks. Nodes only
+ * increase, and each is raised with a compare and swap to the minimum of its children read
+ * after the child was written, so the root always reaches the minimum of the leaves.
+ *
+ * @example
+ * WatermarkTracker tracker = WatermarkTracker(venues.size(), TimeDelta(0, 0, 0, 0, 50));
+ * tracker.observe(venue, event.instant);
+ * if (std::optional<Instant> watermark = tracker.watermark())
+ *     close_bars_before(*watermark);
+ */
+class WatermarkTracker
+{
+public:
+
+    /**
+     * Creates a 'WatermarkTracker' of 'source_count' sources with no events.
+     *
+     * @param source_count number of sources.
+     * @param allowed_lateness how much older than its latest event an event of the same
+     * source may be.
+     *
+     * @throws std::invalid_argument if 'source_count' is 0 or 'allowed_lateness' is negative.
+     */
+    WatermarkTracker(size_t source_count, TimeDelta allowed_lateness);
+
+    /**
+     * Records an event of 'source' at 'event_time'.
+     *
+     * @param source index of the source.
+     * @param event_time time of the event.
+     *
+     * @return 'false' if the event is late, older than the watermark, 'true' otherwise.
+     *
+     * @throws std::invalid_argument if 'source' is not less than the number of sources.
+     */
+    bool observe(size_t source, Instant event_time);
+
+    /**
+     * Gets the watermark.
+     *
+     * @return the minimum over the sources of their latest event time minus the allowed
+     * lateness, or 'std::nullopt' until every source has had an event.
+     */
+    std::optional<Instant> watermark() const;
+
+    /**
+     * Gets the latest event time of 'source'.
+     *
+     * @param source index of the source.
+     *
+     * @return the latest event time, or 'std::nullopt' if 'source' has had no events.
+     *
+     * @throws std::invalid_argument if 'source' is not less than the number of sources.
+     */
+    std::optional<Instant> latest_event_time(size_t source) const;
+
+    /**
+     * Gets the number of late events of 'source'.
+     *
+     * @param source index of the source.
+     *
+     * @return the number of events of 'source' that were older than the watermark.
+     *
+     * @throws std::invalid_argument if 'source' is not less than the number of sources.
+     */
+    uint64_t late_events(size_t source) const;
+
+    /**
+     * Gets the number of late events of every source.
+     *
+     * @return the number of events that were older than the watermark.
+     */
+    uint64_t late_events() const;
+
+    /**
+     * Gets the number of sources.
+     *
+     * @return the number of sources.
+     */
+    size_t source_count() const
+    {
+        return sources;
+    }
+
+private:
+
+    /**
+     * State written by the thread of a single source, on its own cache line so sources do not
+     * contend.
+     */
+    struct alignas(64) Source
+    {
+        /**
+         * Nanoseconds of the latest event, or the minimum 'int64_t' if there was none.
+         */
+        std::atomic<int64_t> latest;
+
+        std::atomic<uint64_t> late;
+    };
+
+    size_t sources;
+
+    int64_t allowed_lateness;
+
+    /**
+     * Number of leaves of the tree, the number of sources rounded up to a power of 2.
+     */
+    size_t leaves;
+
+    std::unique_ptr<Source[]> source_states;
+
+    /**
+     * Internal nodes of the tree, where node 'i' has children '2 * i' and '2 * i + 1', and
+     * node 'leaves + s' is source 's'. Node 0 is unused.
+     */
+    std::unique_ptr<std::atomic<int64_t>[]> nodes;
+
+    /**
+     * Gets the value of the node 'index', where leaves past the sources never limit the
+     * minimum.
+     */
+    int64_t node_value(size_t index) const;
+};
+
+#endif //DATETIME_WATERMARK_TRACKER_H
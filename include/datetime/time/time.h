@@ -1,7 +1,6 @@
 #ifndef TIME_TIME_H
 #define TIME_TIME_H
 
-#include <boost/functional/hash.hpp>
 #include <fmt/ranges.h>
 #include "datetime/time/components/hours.h"
 #include "datetime/time/components/minutes.h"
@@ -11,7 +10,9 @@
 #include "datetime/time/timezone.h"
 #include "datetime/time/components/milliseconds.h"
 #include "stringhelpers/stringhelpers.h"
+#include "../src/util/hash.h"
 #include "../src/util/macros.h"
+#include "../src/util/math.h"
 #include "../../../src/time/basic_time.h"
 #include "datetime/timedelta/timedelta.h"
 #include <optional>
@@ -718,17 +719,19 @@ Time::Time(std::string_view string, Component... time_components)
            std::invalid_argument(fmt::format("Time '{}' is invalid", Time::to_string())));
 }
 
+/**
+ * Hashes 'time' by its nanoseconds since midnight in UTC, so equal 'Times' in different
+ * timezones have the same hash.
+ */
 inline size_t hash_value(const Time& time)
 {
-    size_t seed = 0;
-    boost::hash_combine(seed, time.hour);
-    boost::hash_combine(seed, time.minute);
-    boost::hash_combine(seed, time.second);
-    boost::hash_combine(seed, time.millisecond);
-    boost::hash_combine(seed, time.microsecond);
-    boost::hash_combine(seed, time.nanosecond);
-    boost::hash_combine(seed, time.timezone.utc_offset);
-    return seed;
+    constexpr int64_t nanoseconds_per_hour = 3'600'000'000'000;
+    constexpr int64_t nanoseconds_per_day = 24 * nanoseconds_per_hour;
+
+    int64_t utc = floor_mod(time.total_nanoseconds()
+                            + time.timezone.utc_offset * nanoseconds_per_hour,
+                            nanoseconds_per_day);
+    return static_cast<size_t>(mix_hash(static_cast<uint64_t>(utc)));
 }
 
 namespace std
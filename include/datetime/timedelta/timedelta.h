@@ -33,6 +33,18 @@ public:
               uint16_t millisecond = 0, uint16_t microsecond = 0, uint16_t nanosecond = 0) :
         days(days), BasicTime(hour, minute, second, millisecond, microsecond, nanosecond) {}
 
+    /**
+     * Creates a 'TimeDelta' that spans 'nanoseconds'.
+     *
+     * Negative spans are represented the same way as the result of subtracting a later
+     * 'Time' from an earlier one: 'days' is negative and the remaining components are positive.
+     *
+     * @param nanoseconds number of nanoseconds the 'TimeDelta' will span.
+     *
+     * @return 'TimeDelta' that spans 'nanoseconds'.
+     */
+    static TimeDelta from_nanoseconds(int64_t nanoseconds);
+
     /**
      * Sets 'days' to the absolute value of 'days'.
      *
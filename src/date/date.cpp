@@ -340,24 +340,44 @@ Date Date::tomorrow(Timezone timezone)
 
 size_t Date::get_total_days() const
 {
-    size_t ret = 0;
-
-    // Years.
-    for (uint16_t y = EPOCH.year; y < year; ++y)
-    {
-        ret += (is_leap_year(y) ? DAYS_PER_LEAP_YEAR : DAYS_PER_NON_LEAP_YEAR);
-    }
-
-    // Months.
-    for (uint8_t m = 1; m < month; ++m)
-    {
-        ret += max_days_in_month(m, year);
-    }
+    return static_cast<size_t>(days_since_epoch());
+}
 
-    // Days.
-    ret += day - 1;
+// Uses the constant time civil calendar conversions of the proleptic Gregorian calendar
+// which count 400 year eras starting at 0000-03-01, so leap days fall at the end of a year.
+int64_t Date::days_since_epoch() const
+{
+    int64_t y = year - (month <= 2 ? 1 : 0);
+    int64_t era = y / 400;
+    int64_t year_of_era = y - era * 400;
+    int64_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+
+    // 719468 is the number of days from 0000-03-01 to 1970-01-01.
+    return era * 146097 + day_of_era - 719468;
+}
 
-    return ret;
+Date Date::from_days_since_epoch(int64_t days)
+{
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t day_of_era = days - era * 146097;
+    int64_t year_of_era =
+        (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    int64_t month_index = (5 * day_of_year + 2) / 153;
+
+    int64_t day = day_of_year - (153 * month_index + 2) / 5 + 1;
+    int64_t month = month_index < 10 ? month_index + 3 : month_index - 9;
+    int64_t year = year_of_era + era * 400 + (month <= 2 ? 1 : 0);
+
+    ASSERT(year >= EPOCH.year && year <= 2100,
+           std::invalid_argument(fmt::format("'{}' days since epoch is an invalid date",
+                                             days - 719468)));
+
+    return Date(static_cast<uint16_t>(year),
+                static_cast<uint8_t>(month),
+                static_cast<uint8_t>(day));
 }
 
 TimeDelta operator-(Date date, Date other)
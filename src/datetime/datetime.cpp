@@ -398,6 +398,24 @@ size_t Datetime::to_ms(Timezone timezone) const
     return ret;
 }
 
+Datetime Datetime::from_instant(Instant instant, Timezone timezone)
+{
+    // Shift to the wall clock of 'timezone' before splitting into days.
+    TimeDelta since_epoch = TimeDelta::from_nanoseconds(
+        instant.nanoseconds - timezone.utc_offset * static_cast<int64_t>(NANOSECONDS_PER_HOUR));
+
+    return Datetime(Date::from_days_since_epoch(since_epoch.days), Time(since_epoch, timezone));
+}
+
+Instant Datetime::to_instant() const
+{
+    const auto nanoseconds_per_hour = static_cast<int64_t>(NANOSECONDS_PER_HOUR);
+
+    return Instant(days_since_epoch() * nanoseconds_per_hour * HOURS_PER_DAY
+                   + BasicTime::total_nanoseconds()
+                   + timezone.utc_offset * nanoseconds_per_hour);
+}
+
 const size_t Datetime::MILLISECONDS_PER_DAY = MILLISECONDS_PER_HOUR * 24;
 const size_t Datetime::MILLISECONDS_PER_NON_LEAP_YEAR = MILLISECONDS_PER_DAY * 365;
 const size_t Datetime::MILLISECONDS_PER_LEAP_YEAR = MILLISECONDS_PER_NON_LEAP_YEAR + MILLISECONDS_PER_DAY;
@@ -0,0 +1,79 @@
+#include "datetime/datetime/datetime_range.h"
+#include <algorithm>
+#include "../util/durations.h"
+
+namespace
+{
+/**
+ * 'Instants' from 'start' to 'start' + 'width', checked with a single unsigned comparison since
+ * 'Instants' before 'start' wrap around to distances larger than 'width'.
+ */
+struct Span
+{
+    Instant start;
+    uint64_t width;
+
+    bool contains(Instant instant) const
+    {
+        return unsigned_distance(instant, start) <= width;
+    }
+};
+
+/**
+ * Gets the 'Span' of the 'Instants' from 'start' to 'end'.
+ */
+Span to_span(const Datetime& start, const Datetime& end)
+{
+    Instant first = start.to_instant();
+    return {first, unsigned_distance(end.to_instant(), first)};
+}
+}
+
+void DatetimeRange::mask(std::span<const Instant> instants, std::span<uint8_t> out) const
+{
+    ASSERT(out.size() >= instants.size(),
+           std::invalid_argument(fmt::format("out with size '{}' is smaller than instants with "
+                                             "size '{}'", out.size(), instants.size())));
+
+    const Span span = to_span(start, end);
+
+    for (size_t i = 0; i < instants.size(); ++i)
+        out[i] = span.contains(instants[i]);
+}
+
+void DatetimeRange::mask_bits(std::span<const Instant> instants, std::span<uint64_t> out) const
+{
+    ASSERT(out.size() * 64 >= instants.size(),
+           std::invalid_argument(fmt::format("out with '{}' bits is smaller than instants with "
+                                             "size '{}'", out.size() * 64, instants.size())));
+
+    const Span span = to_span(start, end);
+
+    size_t word_idx = 0;
+    for (size_t i = 0; i < instants.size(); i += 64, ++word_idx)
+    {
+        size_t word_size = std::min<size_t>(64, instants.size() - i);
+        uint64_t word = 0;
+        for (size_t bit = 0; bit < word_size; ++bit)
+            word |= static_cast<uint64_t>(span.contains(instants[i + bit])) << bit;
+        out[word_idx] = word;
+    }
+}
+
+size_t DatetimeRange::count_in_range(std::span<const Instant> instants) const
+{
+    const Span span = to_span(start, end);
+
+    size_t ret = 0;
+    for (const Instant& instant : instants)
+        ret += span.contains(instant);
+    return ret;
+}
+
+std::pair<size_t, size_t> DatetimeRange::sorted_bounds(std::span<const Instant> instants) const
+{
+    auto first = std::lower_bound(instants.begin(), instants.end(), start.to_instant());
+    auto last = std::upper_bound(first, instants.end(), end.to_instant());
+    return {static_cast<size_t>(first - instants.begin()),
+            static_cast<size_t>(last - instants.begin())};
+}
@@ -0,0 +1,32 @@
+#include "datetime/instant/instant.h"
+#include <chrono>
+#include <utility>
+#include "datetime/datetime/datetime.h"
+
+std::optional<Instant> Instant::mock_instant;
+
+Instant Instant::now()
+{
+    if (mock_instant.has_value())
+        return mock_instant.value();
+
+    // Agree with 'Datetime::now' when the clock is mocked through 'Date' or 'Time'.
+    if (Date::mock_date.has_value() || Time::mock_time.has_value())
+        return Datetime::now().to_instant();
+
+    auto since_epoch = std::chrono::system_clock::now().time_since_epoch();
+    return Instant(std::chrono::duration_cast<std::chrono::nanoseconds>(since_epoch).count());
+}
+
+Instant Instant::monotonic_now()
+{
+    if (mock_instant.has_value() || Date::mock_date.has_value() || Time::mock_time.has_value())
+        return now();
+
+    // The system clock is only read once, later readings add the time elapsed on the steady
+    // clock, which never steps back.
+    static const auto anchor = std::pair(now(), std::chrono::steady_clock::now());
+    auto elapsed = std::chrono::steady_clock::now() - anchor.second;
+    return Instant(anchor.first.nanoseconds
+                   + std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+}
@@ -0,0 +1,325 @@
+#include "datetime/schedule/cron_schedule.h"
+#include <array>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <span>
+#include <string>
+#include <vector>
+#include <fmt/format.h>
+#include "../util/math.h"
+
+namespace
+{
+constexpr int64_t NANOSECONDS_PER_MINUTE = 60'000'000'000;
+
+constexpr int64_t MINUTES_PER_DAY = 24 * 60;
+
+constexpr std::array<std::string_view, 12> MONTH_NAMES = {
+    "JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
+
+constexpr std::array<std::string_view, 7> WEEKDAY_NAMES = {
+    "SUN", "MON", "TUE", "WED", "THU", "FRI", "SAT"};
+
+/**
+ * Field of a cron expression.
+ */
+struct Field
+{
+    std::string_view name;
+
+    uint32_t min;
+
+    uint32_t max;
+
+    /**
+     * Names of the values from 'min', if any.
+     */
+    std::span<const std::string_view> names;
+};
+
+constexpr Field MINUTE_FIELD = {"minute", 0, 59, {}};
+
+constexpr Field HOUR_FIELD = {"hour", 0, 23, {}};
+
+constexpr Field DAY_FIELD = {"day of month", 1, 31, {}};
+
+constexpr Field MONTH_FIELD = {"month", 1, 12, MONTH_NAMES};
+
+// 7 is also Sunday.
+constexpr Field WEEKDAY_FIELD = {"day of week", 0, 7, WEEKDAY_NAMES};
+
+bool equals_ignore_case(std::string_view lhs, std::string_view rhs)
+{
+    return lhs.size() == rhs.size()
+        && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char l, char r)
+                      {
+                          return std::toupper(static_cast<unsigned char>(l)) == r;
+                      });
+}
+
+uint32_t parse_number(std::string_view text, std::string_view name)
+{
+    uint32_t value = 0;
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    ASSERT(!text.empty() && error == std::errc() && end == text.data() + text.size(),
+           std::invalid_argument(fmt::format("'{}' is not a valid {}", text, name)));
+    return value;
+}
+
+uint32_t parse_value(std::string_view text, const Field& field)
+{
+    for (size_t i = 0; i < field.names.size(); ++i)
+    {
+        if (equals_ignore_case(text, field.names[i]))
+            return field.min + static_cast<uint32_t>(i);
+    }
+
+    uint32_t value = parse_number(text, field.name);
+    ASSERT(value >= field.min && value <= field.max,
+           std::invalid_argument(fmt::format("{} '{}' is not between '{}' and '{}'", field.name,
+                                             value, field.min, field.max)));
+    return value;
+}
+
+/**
+ * Parses a comma separated list of values, ranges and steps into a bitmask of the values.
+ */
+uint64_t parse_field(std::string_view text, const Field& field)
+{
+    uint64_t mask = 0;
+    size_t start = 0;
+    while (true)
+    {
+        size_t comma = text.find(',', start);
+        std::string_view item = text.substr(start, comma - start);
+
+        size_t slash = item.find('/');
+        std::string_view range = item.substr(0, slash);
+        uint32_t step = 1;
+        if (slash != std::string_view::npos)
+        {
+            step = parse_number(item.substr(slash + 1), "step");
+            ASSERT(step > 0, std::invalid_argument(fmt::format("step of '{}' must be positive",
+                                                               item)));
+        }
+
+        uint32_t first = field.min;
+        uint32_t last = field.max;
+        if (range != "*")
+        {
+            size_t dash = range.find('-');
+            first = parse_value(range.substr(0, dash), field);
+            if (dash != std::string_view::npos)
+                last = parse_value(range.substr(dash + 1), field);
+            else if (slash == std::string_view::npos)
+                last = first;
+            ASSERT(first <= last,
+                   std::invalid_argument(fmt::format("range '{}' of {} is empty", range,
+                                                     field.name)));
+        }
+
+        for (uint32_t value = first; value <= last; value += step)
+            mask |= uint64_t(1) << value;
+
+        if (comma == std::string_view::npos)
+            return mask;
+        start = comma + 1;
+    }
+}
+
+/**
+ * Gets the expression a macro such as '@daily' stands for.
+ */
+std::string_view expand_macro(std::string_view macro)
+{
+    if (macro == "@yearly" || macro == "@annually")
+        return "0 0 1 1 *";
+    if (macro == "@monthly")
+        return "0 0 1 * *";
+    if (macro == "@weekly")
+        return "0 0 * * 0";
+    if (macro == "@daily" || macro == "@midnight")
+        return "0 0 * * *";
+    if (macro == "@hourly")
+        return "0 * * * *";
+    throw std::invalid_argument(fmt::format("'{}' is not a valid cron macro", macro));
+}
+
+std::vector<std::string_view> split_fields(std::string_view expression)
+{
+    std::vector<std::string_view> fields;
+    size_t start = 0;
+    while (start < expression.size())
+    {
+        if (std::isspace(static_cast<unsigned char>(expression[start])))
+        {
+            start++;
+            continue;
+        }
+        size_t end = start;
+        while (end < expression.size()
+               && !std::isspace(static_cast<unsigned char>(expression[end])))
+            end++;
+        fields.push_back(expression.substr(start, end - start));
+        start = end;
+    }
+    return fields;
+}
+
+/**
+ * Gets the day of the week of the day 'day' days after 'Date::EPOCH', where Sunday is 0.
+ */
+uint32_t weekday_of(int64_t day)
+{
+    // 'Date::EPOCH' is a Thursday.
+    return static_cast<uint32_t>(floor_mod(day + 4, 7));
+}
+}
+
+CronSchedule::CronSchedule(std::string_view expression)
+{
+    std::vector<std::string_view> fields = split_fields(expression);
+    if (fields.size() == 1 && fields[0].starts_with('@'))
+        fields = split_fields(expand_macro(fields[0]));
+    ASSERT(fields.size() == 5,
+           std::invalid_argument(fmt::format("cron expression '{}' must have 5 fields",
+                                             expression)));
+
+    minutes = parse_field(fields[0], MINUTE_FIELD);
+    hours = static_cast<uint32_t>(parse_field(fields[1], HOUR_FIELD));
+    days = static_cast<uint32_t>(parse_field(fields[2], DAY_FIELD));
+    months = static_cast<uint16_t>(parse_field(fields[3], MONTH_FIELD));
+    uint64_t weekday_mask = parse_field(fields[4], WEEKDAY_FIELD);
+    weekdays = static_cast<uint8_t>((weekday_mask | weekday_mask >> 7) & 0x7F);
+    match_both_days = fields[2].starts_with('*') || fields[4].starts_with('*');
+
+    // Every day of the month falls on every day of the week in some year, so only the days
+    // of the month need to exist in one of the months.
+    bool has_day = !match_both_days;
+    for (uint32_t month = 1; month <= 12 && !has_day; ++month)
+    {
+        auto max_days = static_cast<uint32_t>(Date::max_days_in_month(static_cast<uint8_t>(month),
+                                                                      2000));
+        has_day = (months >> month & 1) && (days & ((uint32_t(2) << max_days) - 2)) != 0;
+    }
+    ASSERT(has_day, std::invalid_argument(fmt::format("cron expression '{}' never matches a day",
+                                                      expression)));
+}
+
+Instant CronSchedule::next_after(Instant instant, Timezone timezone) const
+{
+    int64_t offset = timezone.utc_offset * Instant::NANOSECONDS_PER_HOUR;
+    int64_t minute_of_epoch = floor_div(instant.nanoseconds - offset, NANOSECONDS_PER_MINUTE) + 1;
+    int64_t day = floor_div(minute_of_epoch, MINUTES_PER_DAY);
+    auto minute_of_day = static_cast<uint32_t>(minute_of_epoch - day * MINUTES_PER_DAY);
+
+    Date date = Date::from_days_since_epoch(day);
+    uint32_t hour = minute_of_day / 60;
+    uint32_t minute = minute_of_day % 60;
+    while (true)
+    {
+        if (!(months >> date.month & 1))
+        {
+            auto later = static_cast<uint32_t>(months) & ~uint32_t(0) << (date.month + 1);
+            if (later != 0)
+                date = Date(date.year, static_cast<uint8_t>(std::countr_zero(later)), 1);
+            else
+                date = Date(date.year + 1, static_cast<uint8_t>(std::countr_zero(months)), 1);
+            hour = 0;
+            minute = 0;
+        }
+
+        uint32_t next = next_day(date);
+        if (next == 0)
+        {
+            date = date.month == 12 ? Date(date.year + 1, 1, 1)
+                                    : Date(date.year, date.month + 1, 1);
+            hour = 0;
+            minute = 0;
+            continue;
+        }
+        if (next != date.day)
+        {
+            date.day = static_cast<uint8_t>(next);
+            hour = 0;
+            minute = 0;
+        }
+
+        uint32_t later_hours = hours & ~uint32_t(0) << hour;
+        if (later_hours == 0)
+        {
+            date = Date::from_days_since_epoch(date.days_since_epoch() + 1);
+            hour = 0;
+            minute = 0;
+            continue;
+        }
+        auto next_hour = static_cast<uint32_t>(std::countr_zero(later_hours));
+        if (next_hour != hour)
+        {
+            hour = next_hour;
+            minute = 0;
+        }
+
+        uint64_t later_minutes = minutes & ~uint64_t(0) << minute;
+        if (later_minutes == 0)
+        {
+            // 'hours' has no bit 24, so the next day is reached through 'later_hours'.
+            hour++;
+            minute = 0;
+            continue;
+        }
+        minute = static_cast<uint32_t>(std::countr_zero(later_minutes));
+
+        return Instant((date.days_since_epoch() * MINUTES_PER_DAY + hour * 60 + minute)
+                       * NANOSECONDS_PER_MINUTE + offset);
+    }
+}
+
+Datetime CronSchedule::next_after(const Datetime& datetime, Timezone timezone) const
+{
+    return Datetime::from_instant(next_after(datetime.to_instant(), timezone), timezone);
+}
+
+bool CronSchedule::matches(Instant instant, Timezone timezone) const
+{
+    int64_t minute_of_epoch = floor_div(instant.nanoseconds
+                                        - timezone.utc_offset * Instant::NANOSECONDS_PER_HOUR,
+                                        NANOSECONDS_PER_MINUTE);
+    int64_t day = floor_div(minute_of_epoch, MINUTES_PER_DAY);
+    int64_t minute_of_day = minute_of_epoch - day * MINUTES_PER_DAY;
+
+    Date date = Date::from_days_since_epoch(day);
+    return (months >> date.month & 1) && next_day(date) == date.day
+        && (hours >> (minute_of_day / 60) & 1) && (minutes >> (minute_of_day % 60) & 1);
+}
+
+bool CronSchedule::matches(const Datetime& datetime) const
+{
+    return matches(datetime.to_instant(), datetime.timezone);
+}
+
+CronSchedule::FireTimes CronSchedule::fire_times(const Datetime& after, Timezone timezone) const
+{
+    return FireTimes(this, after.to_instant(), timezone);
+}
+
+uint32_t CronSchedule::next_day(const Date& date) const
+{
+    auto max_days = static_cast<uint32_t>(Date::max_days_in_month(date.month, date.year));
+    uint32_t month_days = (uint32_t(2) << max_days) - 2;
+    uint32_t first_weekday = weekday_of(date.days_since_epoch() - (date.day - 1));
+
+    // Days 1 + k, 8 + k, ... fall on the same day of the week as day 1 + k.
+    uint64_t weekday_days = 0;
+    for (uint32_t k = 0; k < 7; ++k)
+    {
+        if (weekdays >> ((first_weekday + k) % 7) & 1)
+            weekday_days |= uint64_t(0x10204081) << (k + 1);
+    }
+
+    auto weekday_bits = static_cast<uint32_t>(weekday_days);
+    uint32_t candidates = match_both_days ? days & weekday_bits : days | weekday_bits;
+    candidates &= month_days & ~uint32_t(0) << date.day;
+    return candidates == 0 ? 0 : static_cast<uint32_t>(std::countr_zero(candidates));
+}
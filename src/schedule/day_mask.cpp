@@ -0,0 +1,133 @@
+#include "datetime/schedule/day_mask.h"
+#include <algorithm>
+#include <bit>
+#include <fmt/format.h>
+
+namespace
+{
+uint64_t slot_nanoseconds(const TimeDelta& resolution)
+{
+    int64_t nanoseconds = resolution.total_nanoseconds();
+    ASSERT(nanoseconds > 0 && Instant::NANOSECONDS_PER_DAY % nanoseconds == 0,
+           std::invalid_argument(fmt::format("resolution '{}' must be positive and divide a day "
+                                             "evenly", nanoseconds)));
+    return static_cast<uint64_t>(nanoseconds);
+}
+}
+
+DayMask::DayMask(std::span<const TimeRange> ranges, Timezone timezone, TimeDelta resolution) :
+    timezone(timezone),
+    slot_divider(slot_nanoseconds(resolution)),
+    slot_count(static_cast<size_t>(Instant::NANOSECONDS_PER_DAY
+                                   / static_cast<int64_t>(slot_divider.get_divisor()))),
+    words((slot_count + 63) / 64)
+{
+    for (const TimeRange& range : ranges)
+    {
+        size_t first = slot_of(offset_of(range.start));
+        size_t last = slot_of(offset_of(range.end));
+        if (first <= last)
+        {
+            set(first, last);
+        }
+        else
+        {
+            // The range wraps around midnight in 'timezone'.
+            set(first, slot_count - 1);
+            set(0, last);
+        }
+    }
+}
+
+std::optional<Time> DayMask::next_set(Time time) const
+{
+    int64_t offset = offset_of(time);
+    size_t slot = slot_of(offset);
+    if (!test(slot))
+    {
+        slot = find_next(slot + 1);
+        if (slot == slot_count)
+            return std::nullopt;
+        offset = static_cast<int64_t>(slot * slot_divider.get_divisor());
+    }
+
+    TimeDelta time_of_day = TimeDelta::from_nanoseconds(offset);
+    return Time(time_of_day, timezone);
+}
+
+std::optional<Instant> DayMask::next_set(Instant instant) const
+{
+    int64_t offset = offset_of(instant);
+    size_t slot = slot_of(offset);
+    if (test(slot))
+        return instant;
+
+    int64_t midnight = instant.nanoseconds - offset;
+    slot = find_next(slot + 1);
+    if (slot == slot_count)
+    {
+        // The next set slot is on the next day, if any slot is set.
+        slot = find_next(0);
+        if (slot == slot_count)
+            return std::nullopt;
+        midnight += Instant::NANOSECONDS_PER_DAY;
+    }
+    return Instant(midnight + static_cast<int64_t>(slot * slot_divider.get_divisor()));
+}
+
+void DayMask::mask(std::span<const Instant> instants, std::span<uint8_t> out) const
+{
+    ASSERT(out.size() >= instants.size(),
+           std::invalid_argument(fmt::format("out with size '{}' is smaller than instants with "
+                                             "size '{}'", out.size(), instants.size())));
+
+    for (size_t i = 0; i < instants.size(); ++i)
+        out[i] = contains(instants[i]);
+}
+
+void DayMask::mask_bits(std::span<const Instant> instants, std::span<uint64_t> out) const
+{
+    ASSERT(out.size() * 64 >= instants.size(),
+           std::invalid_argument(fmt::format("out with '{}' bits is smaller than instants with "
+                                             "size '{}'", out.size() * 64, instants.size())));
+
+    size_t word_idx = 0;
+    for (size_t i = 0; i < instants.size(); i += 64, ++word_idx)
+    {
+        size_t word_size = std::min<size_t>(64, instants.size() - i);
+        uint64_t word = 0;
+        for (size_t bit = 0; bit < word_size; ++bit)
+            word |= static_cast<uint64_t>(contains(instants[i + bit])) << bit;
+        out[word_idx] = word;
+    }
+}
+
+bool DayMask::empty() const
+{
+    return std::all_of(words.begin(), words.end(), [](uint64_t word) { return word == 0; });
+}
+
+void DayMask::set(size_t first, size_t last)
+{
+    size_t slot = first;
+    while (slot <= last)
+    {
+        size_t bit = slot % 64;
+        size_t length = std::min<size_t>(64 - bit, last - slot + 1);
+        uint64_t bits = length == 64 ? ~uint64_t(0) : ((uint64_t(1) << length) - 1) << bit;
+        words[slot / 64] |= bits;
+        slot += length;
+    }
+}
+
+size_t DayMask::find_next(size_t slot) const
+{
+    while (slot < slot_count)
+    {
+        uint64_t word = words[slot / 64] >> (slot % 64);
+        if (word != 0)
+            return slot + static_cast<size_t>(std::countr_zero(word));
+        slot = (slot / 64 + 1) * 64;
+    }
+    return slot_count;
+}
@@ -0,0 +1,90 @@
+#include "datetime/schedule/event_loop.h"
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <utility>
+
+namespace
+{
+/**
+ * Checks if 'Instant::now' reads a simulated clock.
+ */
+bool clock_is_mocked()
+{
+    return Instant::mock_instant.has_value() || Date::mock_date.has_value()
+           || Time::mock_time.has_value();
+}
+}
+
+thread_local std::exception_ptr EventLoop::task_exception;
+
+EventLoop::EventLoop(TimeDelta resolution) :
+    wheel(resolution, Instant::monotonic_now()) {}
+
+EventLoop::~EventLoop()
+{
+    wheel.tick(Instant(std::numeric_limits<int64_t>::max()),
+               [](std::coroutine_handle<> handle) { handle.destroy(); });
+}
+
+void EventLoop::run()
+{
+    run_until(Instant(std::numeric_limits<int64_t>::max()));
+}
+
+void EventLoop::run_until(Instant end)
+{
+    // Tasks that threw before their first 'co_await'.
+    rethrow_task_exception();
+
+    while (true)
+    {
+        wheel.tick(std::min(Instant::monotonic_now(), end), [](std::coroutine_handle<> handle)
+        {
+            try
+            {
+                handle.resume();
+            }
+            catch (...)
+            {
+                // A coroutine other than a 'Task' that throws is left suspended at its final
+                // suspend point.
+                handle.destroy();
+                throw;
+            }
+            rethrow_task_exception();
+        });
+
+        std::optional<Instant> next = wheel.next_expiry();
+        if (!next.has_value() || *next > end)
+            break;
+        wait_until(*next);
+    }
+
+    bool bounded = end.nanoseconds != std::numeric_limits<int64_t>::max();
+    if (clock_is_mocked() && bounded)
+        Instant::mock_instant = std::max(Instant::now(), end);
+}
+
+void EventLoop::rethrow_task_exception()
+{
+    if (task_exception)
+        std::rethrow_exception(std::exchange(task_exception, nullptr));
+}
+
+void EventLoop::wait_until(Instant deadline)
+{
+    if (clock_is_mocked())
+    {
+        // 'Instant::mock_instant' takes precedence, so setting it advances a clock mocked
+        // through 'Date::mock_date' or 'Time::mock_time' as well.
+        Instant::mock_instant = std::max(Instant::now(), deadline);
+        return;
+    }
+
+    Instant now = Instant::monotonic_now();
+    if (deadline > now)
+        std::this_thread::sleep_for(std::chrono::nanoseconds(deadline.nanoseconds
+                                                             - now.nanoseconds));
+}
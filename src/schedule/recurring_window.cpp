@@ -0,0 +1,132 @@
+#include "datetime/schedule/recurring_window.h"
+#include "../util/math.h"
+#include <algorithm>
+
+namespace
+{
+/**
+ * Gets the nanoseconds after the start of the day of 'time' in 'timezone'.
+ */
+int64_t offset_in(Time time, Timezone timezone)
+{
+    time.set_timezone(timezone);
+    return time.total_nanoseconds();
+}
+
+/**
+ * Gets the 'Date::DayOfWeek' of the day 'day' days after 'Date::EPOCH', a Thursday.
+ */
+size_t day_of_week(int64_t day)
+{
+    return static_cast<size_t>(floor_mod(day + Date::THURSDAY, 7));
+}
+}
+
+const RecurringWindow::Days RecurringWindow::EVERY_DAY = Days(0b1111111);
+
+const RecurringWindow::Days RecurringWindow::WEEKDAYS = Days(0b0011111);
+
+RecurringWindow::RecurringWindow(const TimeRange& time_range, Timezone timezone, Days days) :
+    start_offset(offset_in(time_range.start, timezone)),
+    end_offset(offset_in(time_range.end, timezone)),
+    timezone(timezone),
+    days(days)
+{
+    ASSERT(days.any(), std::invalid_argument("days must have at least one day"));
+}
+
+bool RecurringWindow::contains(const Datetime& datetime) const
+{
+    return contains(datetime.to_instant());
+}
+
+bool RecurringWindow::contains(Instant instant) const
+{
+    int64_t local = instant.nanoseconds - timezone.utc_offset * Instant::NANOSECONDS_PER_HOUR;
+    int64_t day = floor_div(local, Instant::NANOSECONDS_PER_DAY);
+    int64_t offset = local - day * Instant::NANOSECONDS_PER_DAY;
+
+    if (start_offset <= end_offset)
+        return offset >= start_offset && offset <= end_offset && starts_on(day);
+
+    // The window ends on the day after it starts.
+    return (offset >= start_offset && starts_on(day))
+        || (offset <= end_offset && starts_on(day - 1));
+}
+
+Datetime RecurringWindow::next_start(const Datetime& datetime) const
+{
+    return Datetime::from_instant(next_start(datetime.to_instant()), timezone);
+}
+
+Instant RecurringWindow::next_start(Instant instant) const
+{
+    int64_t local = instant.nanoseconds - timezone.utc_offset * Instant::NANOSECONDS_PER_HOUR;
+    int64_t day = floor_div(local, Instant::NANOSECONDS_PER_DAY);
+    if (local - day * Instant::NANOSECONDS_PER_DAY > start_offset)
+        day++;
+
+    return at(next_start_day(day), start_offset);
+}
+
+RecurringWindow::Occurrences RecurringWindow::occurrences(const DateRange& date_range) const
+{
+    return Occurrences(this, date_range.start.days_since_epoch(),
+                       date_range.end.days_since_epoch());
+}
+
+bool RecurringWindow::starts_on(int64_t day) const
+{
+    return days.test(day_of_week(day));
+}
+
+int64_t RecurringWindow::next_start_day(int64_t day) const
+{
+    // At most 6 steps since 'days' has at least one day.
+    while (!starts_on(day))
+        day++;
+    return day;
+}
+
+Instant RecurringWindow::at(int64_t day, int64_t offset) const
+{
+    return Instant(day * Instant::NANOSECONDS_PER_DAY + offset
+                   + timezone.utc_offset * Instant::NANOSECONDS_PER_HOUR);
+}
+
+RecurringWindow::Occurrences::Occurrences(const RecurringWindow* window, int64_t first_day,
+                                          int64_t last_day) :
+    window(window),
+    first_day(std::min(window->next_start_day(first_day), last_day + 1)),
+    end_day(last_day + 1) {}
+
+RecurringWindow::Occurrences::Iterator RecurringWindow::Occurrences::begin() const
+{
+    return Iterator(window, first_day, end_day);
+}
+
+RecurringWindow::Occurrences::Iterator RecurringWindow::Occurrences::end() const
+{
+    return Iterator(window, end_day, end_day);
+}
+
+DatetimeRange RecurringWindow::Occurrences::Iterator::operator*() const
+{
+    int64_t end_day = window->start_offset <= window->end_offset ? day : day + 1;
+    return DatetimeRange(
+        Datetime::from_instant(window->at(day, window->start_offset), window->timezone),
+        Datetime::from_instant(window->at(end_day, window->end_offset), window->timezone));
+}
+
+RecurringWindow::Occurrences::Iterator& RecurringWindow::Occurrences::Iterator::operator++()
+{
+    day = std::min(window->next_start_day(day + 1), end_day);
+    return *this;
+}
+
+RecurringWindow::Occurrences::Iterator RecurringWindow::Occurrences::Iterator::operator++(int)
+{
+    Iterator ret = *this;
+    ++(*this);
+    return ret;
+}
@@ -0,0 +1,96 @@
+#include "datetime/series/align_to_grid.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <fmt/format.h>
+#include "asof_match.h"
+#include "../util/macros.h"
+#include "../util/durations.h"
+#include "../util/parallel.h"
+
+namespace
+{
+void align(const TimeGrid& grid, std::span<const Instant> series, uint64_t tolerance,
+           AsofDirection direction, std::span<size_t> out)
+{
+    ASSERT(out.size() >= grid.size(),
+           std::invalid_argument(fmt::format("out with size '{}' is smaller than grid with "
+                                             "size '{}'", out.size(), grid.size())));
+
+    asof_match([&grid](size_t idx) { return grid[idx]; }, grid.size(), series, tolerance,
+               direction, 0, out);
+}
+}
+
+TimeGrid::TimeGrid(Instant start, TimeDelta step, size_t size) :
+    start(start), step(static_cast<int64_t>(positive_nanoseconds(step, "step"))), count(size) {}
+
+TimeGrid::TimeGrid(const DatetimeRange& range, TimeDelta step) :
+    start(range.start.to_instant()),
+    step(static_cast<int64_t>(positive_nanoseconds(step, "step")))
+{
+    count = static_cast<size_t>(unsigned_distance(range.end.to_instant(), start)
+                                / static_cast<uint64_t>(this->step)) + 1;
+}
+
+std::vector<size_t> align_to_grid(const TimeGrid& grid, std::span<const Instant> series,
+                                  TimeDelta tolerance, AsofDirection direction)
+{
+    std::vector<size_t> out(grid.size());
+    align(grid, series, non_negative_nanoseconds(tolerance, "tolerance"), direction, out);
+    return out;
+}
+
+std::vector<size_t> align_to_grid(const TimeGrid& grid, std::span<const Instant> series,
+                                  AsofDirection direction)
+{
+    std::vector<size_t> out(grid.size());
+    align(grid, series, std::numeric_limits<uint64_t>::max(), direction, out);
+    return out;
+}
+
+void align_to_grid(const TimeGrid& grid, std::span<const Instant> series, TimeDelta tolerance,
+                   AsofDirection direction, std::span<size_t> out)
+{
+    align(grid, series, non_negative_nanoseconds(tolerance, "tolerance"), direction, out);
+}
+
+std::vector<std::vector<size_t>> align_to_grid(
+    const TimeGrid& grid, std::span<const std::span<const Instant>> series, TimeDelta tolerance,
+    AsofDirection direction, unsigned thread_count)
+{
+    ASSERT(thread_count > 0, std::invalid_argument("thread_count must be positive"));
+    uint64_t tolerance_ns = non_negative_nanoseconds(tolerance, "tolerance");
+
+    std::vector<std::vector<size_t>> out(series.size(), std::vector<size_t>(grid.size()));
+    auto threads = static_cast<unsigned>(std::min<size_t>(thread_count, series.size()));
+    if (threads <= 1)
+    {
+        for (size_t s = 0; s < series.size(); ++s)
+            align(grid, series[s], tolerance_ns, direction, out[s]);
+        return out;
+    }
+
+    // Series can differ a lot in size, so each thread takes the next one when it is done.
+    std::atomic<size_t> next = 0;
+    std::vector<std::exception_ptr> errors(threads);
+    run_parallel(threads, [&](unsigned t)
+    {
+        try
+        {
+            for (size_t s = next++; s < series.size(); s = next++)
+                align(grid, series[s], tolerance_ns, direction, out[s]);
+        }
+        catch (...)
+        {
+            errors[t] = std::current_exception();
+        }
+    });
+
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+    return out;
+}
@@ -0,0 +1,113 @@
+#include "datetime/series/asof_join.h"
+#include <algorithm>
+#include <exception>
+#include <fmt/format.h>
+#include <thread>
+#include "asof_match.h"
+#include "../util/macros.h"
+#include "../util/durations.h"
+
+namespace
+{
+/**
+ * Gets a 'LeftKey' for 'asof_match' that reads the 'Instants' of 'left'.
+ */
+auto left_at(std::span<const Instant> left)
+{
+    return [left](size_t idx) { return left[idx]; };
+}
+
+/**
+ * Gets the first index in 'right' the search for 'instant' may start at.
+ */
+size_t start_position(std::span<const Instant> right, Instant instant)
+{
+    return static_cast<size_t>(std::lower_bound(right.begin(), right.end(), instant)
+                               - right.begin());
+}
+
+/**
+ * Joins 'left' against 'right' in 'thread_count' partitions of 'left'.
+ */
+void join(std::span<const Instant> left, std::span<const Instant> right, uint64_t tolerance,
+          AsofDirection direction, unsigned thread_count, std::span<size_t> out)
+{
+    ASSERT(thread_count > 0, std::invalid_argument("thread_count must be positive"));
+    ASSERT(out.size() >= left.size(),
+           std::invalid_argument(fmt::format("out with size '{}' is smaller than left with "
+                                             "size '{}'", out.size(), left.size())));
+
+    size_t partitions = std::min<size_t>(thread_count, left.size());
+    if (partitions <= 1)
+    {
+        asof_match(left_at(left), left.size(), right, tolerance, direction, 0, out);
+        return;
+    }
+
+    std::vector<size_t> starts(partitions + 1);
+    for (size_t p = 0; p <= partitions; ++p)
+        starts[p] = left.size() * p / partitions;
+
+    // Partitions other than the first must be sorted after the previous one, which is
+    // checked here since each partition only checks its own 'Instants'.
+    for (size_t p = 1; p < partitions; ++p)
+    {
+        ASSERT(left[starts[p]] >= left[starts[p] - 1],
+               std::invalid_argument(fmt::format("left is not sorted at index '{}'", starts[p])));
+    }
+
+    std::vector<std::exception_ptr> errors(partitions);
+    std::vector<std::thread> threads;
+    threads.reserve(partitions);
+    for (size_t p = 0; p < partitions; ++p)
+    {
+        threads.emplace_back([&, p]()
+        {
+            try
+            {
+                size_t size = starts[p + 1] - starts[p];
+                std::span<const Instant> part = left.subspan(starts[p], size);
+                asof_match(left_at(part), part.size(), right, tolerance, direction,
+                           start_position(right, part.front()), out.subspan(starts[p], size));
+            }
+            catch (...)
+            {
+                errors[p] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (const std::exception_ptr& error : errors)
+    {
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+}
+
+std::vector<size_t> asof_join(std::span<const Instant> left, std::span<const Instant> right,
+                              TimeDelta tolerance, AsofDirection direction,
+                              unsigned thread_count)
+{
+    std::vector<size_t> out(left.size());
+    asof_join(left, right, tolerance, direction, thread_count, out);
+    return out;
+}
+
+std::vector<size_t> asof_join(std::span<const Instant> left, std::span<const Instant> right,
+                              AsofDirection direction, unsigned thread_count)
+{
+    std::vector<size_t> out(left.size());
+    join(left, right, std::numeric_limits<uint64_t>::max(), direction, thread_count, out);
+    return out;
+}
+
+void asof_join(std::span<const Instant> left, std::span<const Instant> right,
+               TimeDelta tolerance, AsofDirection direction, unsigned thread_count,
+               std::span<size_t> out)
+{
+    join(left, right, non_negative_nanoseconds(tolerance, "tolerance"), direction, thread_count,
+         out);
+}
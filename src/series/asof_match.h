@@ -0,0 +1,104 @@
+#ifndef DATETIME_ASOFMATCH_H
+#define DATETIME_ASOFMATCH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <fmt/format.h>
+#include "datetime/instant/instant.h"
+#include "datetime/series/asof_direction.h"
+#include "datetime/series/asof_join.h"
+#include "../util/macros.h"
+#include "../util/durations.h"
+
+/**
+ * Gets the first index at or after 'from' in 'right' whose 'Instant' fails 'before', where
+ * 'before' holds for a prefix of 'right'.
+ *
+ * Steps 1, 2, 4, ... ahead of 'from' until 'before' fails and then binary searches the last
+ * step, so the cost grows with the log of the distance moved rather than the size of 'right'.
+ */
+template<typename Predicate>
+size_t gallop(std::span<const Instant> right, size_t from, Predicate before)
+{
+    size_t low = from;
+    size_t step = 1;
+    while (low + step <= right.size() && before(right[low + step - 1]))
+    {
+        low += step;
+        step *= 2;
+    }
+
+    size_t high = std::min(low + step, right.size());
+    return static_cast<size_t>(std::partition_point(right.begin() + low, right.begin() + high,
+                                                    before) - right.begin());
+}
+
+/**
+ * Matches each of the 'left_size' left 'Instants' with the nearest of 'right' in 'direction',
+ * starting the search in 'right' at 'from'.
+ *
+ * Both sides are swept once together, galloping through 'right' between matches.
+ *
+ * @tparam LeftKey callable that gets the left 'Instant' at an index, so the left side can be
+ * computed instead of stored, like the 'Instants' of a 'TimeGrid'.
+ *
+ * @param left gets the left 'Instant' at each index below 'left_size'.
+ * @param left_size number of left 'Instants'.
+ * @param right 'Instants' to match against, sorted in ascending order.
+ * @param tolerance largest distance between a left 'Instant' and its match.
+ * @param direction direction to search for a match in.
+ * @param from first index in 'right' the search may start at.
+ * @param out set to the index in 'right' of the match of each left 'Instant', or
+ * 'ASOF_NO_MATCH'.
+ *
+ * @throws std::invalid_argument if the left 'Instants' are not sorted.
+ */
+template<typename LeftKey>
+void asof_match(LeftKey left, size_t left_size, std::span<const Instant> right,
+                uint64_t tolerance, AsofDirection direction, size_t from, std::span<size_t> out)
+{
+    Instant previous = left_size == 0 ? Instant() : left(0);
+    size_t position = from;
+    for (size_t i = 0; i < left_size; ++i)
+    {
+        Instant instant = left(i);
+        ASSERT(instant >= previous,
+               std::invalid_argument(fmt::format("left is not sorted at index '{}'", i)));
+        previous = instant;
+
+        size_t match = ASOF_NO_MATCH;
+        if (direction == AsofDirection::FORWARD)
+        {
+            // 'position' is the first of 'right' at or after 'instant'.
+            position = gallop(right, position, [instant](Instant x) { return x < instant; });
+            if (position < right.size()
+                && unsigned_distance(right[position], instant) <= tolerance)
+            {
+                match = position;
+            }
+        }
+        else
+        {
+            // 'position' is the first of 'right' after 'instant'.
+            position = gallop(right, position, [instant](Instant x) { return x <= instant; });
+            if (position > 0 && unsigned_distance(instant, right[position - 1]) <= tolerance)
+                match = position - 1;
+
+            if (direction == AsofDirection::NEAREST && position < right.size())
+            {
+                uint64_t forward = unsigned_distance(right[position], instant);
+                if (forward <= tolerance
+                    && (match == ASOF_NO_MATCH
+                        || forward < unsigned_distance(instant, right[match])))
+                {
+                    match = position;
+                }
+            }
+        }
+        out[i] = match;
+    }
+}
+
+#endif //DATETIME_ASOFMATCH_H
@@ -0,0 +1,204 @@
+#include "datetime/series/compressed_timestamp_column.h"
+#include <algorithm>
+#include <bit>
+#include <fmt/format.h>
+#include "../util/macros.h"
+
+namespace
+{
+/**
+ * Length in bits of the prefix selecting each payload width, by the number of leading ones
+ * of the prefix.
+ */
+constexpr uint32_t PREFIX_BITS[] = {1, 2, 3, 4, 4};
+
+/**
+ * Width in bits of the payload following each prefix.
+ */
+constexpr uint32_t PAYLOAD_BITS[] = {0, 8, 16, 32, 64};
+
+constexpr uint64_t PAYLOAD_MASKS[] = {0, 0xFF, 0xFFFF, 0xFFFFFFFF, ~uint64_t(0)};
+
+/**
+ * Number of consecutive unchanged deltas worth decoding as a run.
+ */
+constexpr size_t MIN_RUN = 8;
+
+/**
+ * Maps a signed difference to an unsigned number that is small when the difference is close
+ * to 0, so 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+ */
+uint64_t zigzag_encode(uint64_t difference)
+{
+    auto value = static_cast<int64_t>(difference);
+    return static_cast<uint64_t>(value) << 1 ^ static_cast<uint64_t>(value >> 63);
+}
+
+uint64_t zigzag_decode(uint64_t value)
+{
+    return value >> 1 ^ (0 - (value & 1));
+}
+}
+
+CompressedTimestampColumn::CompressedTimestampColumn(std::span<const Instant> instants)
+{
+    append(instants);
+}
+
+void CompressedTimestampColumn::append(Instant instant)
+{
+    // Differences are computed modulo 2^64 so 'Instants' far apart do not overflow.
+    auto value = static_cast<uint64_t>(instant.nanoseconds);
+    if (count % BLOCK_SIZE == 0)
+    {
+        blocks.push_back({instant, bit_size});
+        previous_delta = 0;
+    }
+    else
+    {
+        uint64_t delta = value - previous;
+        uint64_t encoded = zigzag_encode(delta - previous_delta);
+        if (encoded == 0)
+            write(0b0, 1);
+        else if (encoded <= PAYLOAD_MASKS[1])
+            write(0b01 | encoded << 2, 10);
+        else if (encoded <= PAYLOAD_MASKS[2])
+            write(0b011 | encoded << 3, 19);
+        else if (encoded <= PAYLOAD_MASKS[3])
+            write(0b0111 | encoded << 4, 36);
+        else
+        {
+            write(0b1111, 4);
+            write(encoded, 64);
+        }
+        previous_delta = delta;
+    }
+    previous = value;
+    count++;
+}
+
+void CompressedTimestampColumn::append(std::span<const Instant> instants)
+{
+    for (Instant instant : instants)
+        append(instant);
+}
+
+Instant CompressedTimestampColumn::at(size_t index) const
+{
+    ASSERT(index < count,
+           std::invalid_argument(fmt::format("index '{}' is out of range for size '{}'",
+                                             index, count)));
+
+    Instant block[BLOCK_SIZE];
+    decode(blocks[index / BLOCK_SIZE], index % BLOCK_SIZE + 1, block);
+    return block[index % BLOCK_SIZE];
+}
+
+size_t CompressedTimestampColumn::decode_block(size_t block, std::span<Instant> out) const
+{
+    ASSERT(block < blocks.size(),
+           std::invalid_argument(fmt::format("block '{}' is out of range for '{}' blocks",
+                                             block, blocks.size())));
+    size_t size = std::min(BLOCK_SIZE, count - block * BLOCK_SIZE);
+    ASSERT(out.size() >= size,
+           std::invalid_argument(fmt::format("out with size '{}' is smaller than the block with "
+                                             "size '{}'", out.size(), size)));
+
+    decode(blocks[block], size, out.data());
+    return size;
+}
+
+void CompressedTimestampColumn::decode(std::span<Instant> out) const
+{
+    ASSERT(out.size() >= count,
+           std::invalid_argument(fmt::format("out with size '{}' is smaller than the column "
+                                             "with size '{}'", out.size(), count)));
+
+    for (size_t block = 0; block < blocks.size(); ++block)
+    {
+        decode(blocks[block], std::min(BLOCK_SIZE, count - block * BLOCK_SIZE),
+               out.data() + block * BLOCK_SIZE);
+    }
+}
+
+std::vector<Instant> CompressedTimestampColumn::decode() const
+{
+    std::vector<Instant> ret(count);
+    decode(ret);
+    return ret;
+}
+
+size_t CompressedTimestampColumn::compressed_bytes() const
+{
+    return words.size() * sizeof(uint64_t) + blocks.size() * sizeof(Block);
+}
+
+double CompressedTimestampColumn::compression_ratio() const
+{
+    if (count == 0)
+        return 0;
+    return static_cast<double>(count * sizeof(Instant)) / static_cast<double>(compressed_bytes());
+}
+
+void CompressedTimestampColumn::write(uint64_t value, uint32_t bits)
+{
+    while (words.size() < (bit_size + bits) / 64 + 2)
+        words.push_back(0);
+
+    size_t word = bit_size / 64;
+    uint32_t offset = bit_size % 64;
+    words[word] |= value << offset;
+    if (offset + bits > 64)
+        words[word + 1] |= value >> (64 - offset);
+    bit_size += bits;
+}
+
+void CompressedTimestampColumn::decode(const Block& header, size_t size, Instant* out) const
+{
+    // Gets the next 64 bits of the stream from 'position', the zeroed word after the stream
+    // keeps the read in bounds.
+    auto peek = [this](uint64_t position)
+    {
+        size_t word = position / 64;
+        uint32_t offset = position % 64;
+        return words[word] >> offset | (words[word + 1] << 1) << (63 - offset);
+    };
+
+    auto value = static_cast<uint64_t>(header.first.nanoseconds);
+    uint64_t delta = 0;
+    uint64_t position = header.bit_offset;
+    out[0] = header.first;
+
+    size_t i = 1;
+    while (i < size)
+    {
+        uint64_t window = peek(position);
+
+        // A long run of '0' prefixes repeats the delta, so it is written without decoding
+        // each. Short runs take the general path to keep the branch predictable.
+        auto zeros = static_cast<size_t>(std::countr_zero(window));
+        if (zeros >= MIN_RUN)
+        {
+            size_t run = std::min(zeros, size - i);
+            for (size_t j = 0; j < run; ++j)
+            {
+                value += delta;
+                out[i + j] = Instant(static_cast<int64_t>(value));
+            }
+            i += run;
+            position += run;
+            continue;
+        }
+
+        // A '0' prefix has an empty payload mask, so it needs no branch of its own.
+        auto ones = static_cast<uint32_t>(std::min(std::countr_one(window), 4));
+        uint64_t encoded = window >> PREFIX_BITS[ones] & PAYLOAD_MASKS[ones];
+        if (ones == 4)
+            encoded = peek(position + PREFIX_BITS[ones]);
+        position += PREFIX_BITS[ones] + PAYLOAD_BITS[ones];
+
+        delta += zigzag_decode(encoded);
+        value += delta;
+        out[i++] = Instant(static_cast<int64_t>(value));
+    }
+}
@@ -0,0 +1,108 @@
+#include "datetime/series/gaps.h"
+#include <algorithm>
+#include <fmt/format.h>
+#include "../util/macros.h"
+#include "../util/durations.h"
+
+namespace
+{
+/**
+ * Number of differences checked together before looking for the position of a gap.
+ */
+constexpr size_t BLOCK_SIZE = 256;
+
+/**
+ * Gets 'end' minus 'start' in nanoseconds, wrapping instead of overflowing.
+ */
+int64_t difference(Instant start, Instant end)
+{
+    return static_cast<int64_t>(static_cast<uint64_t>(end.nanoseconds)
+                                - static_cast<uint64_t>(start.nanoseconds));
+}
+
+/**
+ * Appends the gaps among '[first, last)' of 'instants', where 'first' is at least 1.
+ */
+void append_gaps(std::span<const Instant> instants, size_t first, size_t last, int64_t max_gap,
+                 size_t index_offset, std::vector<Gap>& gaps)
+{
+    for (size_t i = first; i < last; ++i)
+    {
+        if (difference(instants[i - 1], instants[i]) > max_gap)
+            gaps.push_back({instants[i - 1], instants[i], index_offset + i});
+    }
+}
+
+/**
+ * Appends the gaps of 'instants', checking blocks for any gap first.
+ */
+void find_gaps(std::span<const Instant> instants, int64_t max_gap, size_t index_offset,
+               std::vector<Gap>& gaps)
+{
+    for (size_t first = 1; first < instants.size(); first += BLOCK_SIZE)
+    {
+        size_t last = std::min(first + BLOCK_SIZE, instants.size());
+
+        // No early exit, so the loop is a vectorizable reduction.
+        bool any_gap = false;
+        for (size_t i = first; i < last; ++i)
+            any_gap |= difference(instants[i - 1], instants[i]) > max_gap;
+
+        if (any_gap)
+            append_gaps(instants, first, last, max_gap, index_offset, gaps);
+    }
+}
+}
+
+void diff(std::span<const Instant> instants, std::span<int64_t> out)
+{
+    size_t size = instants.empty() ? 0 : instants.size() - 1;
+    ASSERT(out.size() >= size,
+           std::invalid_argument(fmt::format("out with size '{}' is smaller than the '{}' "
+                                             "differences", out.size(), size)));
+
+    for (size_t i = 0; i < size; ++i)
+        out[i] = difference(instants[i], instants[i + 1]);
+}
+
+std::vector<int64_t> diff(std::span<const Instant> instants)
+{
+    std::vector<int64_t> ret(instants.empty() ? 0 : instants.size() - 1);
+    diff(instants, ret);
+    return ret;
+}
+
+std::vector<Gap> find_gaps(std::span<const Instant> instants, TimeDelta max_gap)
+{
+    std::vector<Gap> gaps;
+    find_gaps(instants, static_cast<int64_t>(non_negative_nanoseconds(max_gap, "max_gap")), 0,
+              gaps);
+    return gaps;
+}
+
+GapDetector::GapDetector(TimeDelta max_gap) :
+    max_gap(static_cast<int64_t>(non_negative_nanoseconds(max_gap, "max_gap"))) {}
+
+std::optional<Gap> GapDetector::push(Instant instant)
+{
+    std::optional<Gap> gap;
+    if (count > 0 && difference(previous, instant) > max_gap)
+        gap = Gap{previous, instant, count};
+
+    previous = instant;
+    count++;
+    return gap;
+}
+
+void GapDetector::push(std::span<const Instant> instants, std::vector<Gap>& gaps)
+{
+    if (instants.empty())
+        return;
+
+    if (std::optional<Gap> gap = push(instants.front()))
+        gaps.push_back(*gap);
+
+    find_gaps(instants, max_gap, count - 1, gaps);
+    previous = instants.back();
+    count += instants.size() - 1;
+}
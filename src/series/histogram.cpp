@@ -0,0 +1,125 @@
+#include "datetime/series/histogram.h"
+#include <algorithm>
+#include <fmt/format.h>
+#include "../util/constant_divider.h"
+#include "../util/macros.h"
+#include "../util/durations.h"
+#include "../util/parallel.h"
+
+namespace
+{
+/**
+ * Size under which a partition is not worth a thread.
+ */
+constexpr size_t MIN_PARTITION_SIZE = 1 << 16;
+
+/**
+ * Buckets of a domain, with the end of the domain in the last bucket.
+ */
+struct Buckets
+{
+    Instant start;
+
+    /**
+     * Nanoseconds from 'start' to the end of the domain.
+     */
+    uint64_t width;
+
+    ConstantDivider divider;
+
+    size_t count;
+
+    Buckets(TimeDelta bucket_width, const DatetimeRange& domain) :
+        start(domain.start.to_instant()),
+        width(unsigned_distance(domain.end.to_instant(), start)),
+        divider(positive_nanoseconds(bucket_width, "bucket_width")),
+        count(std::max<size_t>(1, (width + divider.get_divisor() - 1) / divider.get_divisor())) {}
+};
+
+/**
+ * Adds 'weight(i)' of each of 'instants' in the domain to its bucket in 'out'.
+ */
+template<typename Weight, typename WeightOf>
+void accumulate(std::span<const Instant> instants, const Buckets& buckets, WeightOf weight_of,
+                std::span<Weight> out)
+{
+    // Sorted 'instants' mostly fall in the bucket of the previous one, so the run is summed in
+    // a register instead of a load and a store to 'out' per 'Instant'.
+    size_t current = 0;
+    Weight run = 0;
+    for (size_t i = 0; i < instants.size(); ++i)
+    {
+        // Values before 'start' wrap around to large unsigned values.
+        uint64_t offset = unsigned_distance(instants[i], buckets.start);
+        if (offset > buckets.width)
+            continue;
+
+        auto bucket = std::min<size_t>(buckets.divider.divide(offset), buckets.count - 1);
+        if (bucket != current)
+        {
+            out[current] += run;
+            current = bucket;
+            run = 0;
+        }
+        run += weight_of(i);
+    }
+    out[current] += run;
+}
+
+/**
+ * Adds 'weight_of(i)' of each of 'instants' to its bucket, in partial histograms summed at the
+ * end if there is more than one thread.
+ */
+template<typename Weight, typename WeightOf>
+std::vector<Weight> build(std::span<const Instant> instants, TimeDelta bucket_width,
+                          const DatetimeRange& domain, unsigned thread_count, WeightOf weight_of)
+{
+    ASSERT(thread_count > 0, std::invalid_argument("thread_count must be positive"));
+    Buckets buckets = Buckets(bucket_width, domain);
+    std::vector<Weight> out(buckets.count);
+
+    size_t partitions = std::min<size_t>(thread_count, instants.size() / MIN_PARTITION_SIZE);
+    if (partitions <= 1)
+    {
+        accumulate<Weight>(instants, buckets, weight_of, std::span<Weight>(out));
+        return out;
+    }
+
+    std::vector<std::vector<Weight>> partials(partitions);
+    run_parallel(static_cast<unsigned>(partitions), [&](unsigned p)
+    {
+        size_t first = instants.size() * p / partitions;
+        size_t last = instants.size() * (p + 1) / partitions;
+        partials[p].resize(buckets.count);
+        accumulate<Weight>(instants.subspan(first, last - first), buckets,
+                           [&weight_of, first](size_t i) { return weight_of(first + i); },
+                           std::span<Weight>(partials[p]));
+    });
+
+    for (const std::vector<Weight>& partial : partials)
+    {
+        for (size_t b = 0; b < buckets.count; ++b)
+            out[b] += partial[b];
+    }
+    return out;
+}
+}
+
+std::vector<uint64_t> histogram(std::span<const Instant> instants, TimeDelta bucket_width,
+                                const DatetimeRange& domain, unsigned thread_count)
+{
+    return build<uint64_t>(instants, bucket_width, domain, thread_count,
+                           [](size_t) { return uint64_t(1); });
+}
+
+std::vector<double> histogram(std::span<const Instant> instants, std::span<const double> weights,
+                              TimeDelta bucket_width, const DatetimeRange& domain,
+                              unsigned thread_count)
+{
+    ASSERT(weights.size() == instants.size(),
+           std::invalid_argument(fmt::format("weights with size '{}' and instants with size '{}' "
+                                             "must have the same size",
+                                             weights.size(), instants.size())));
+    return build<double>(instants, bucket_width, domain, thread_count,
+                         [weights](size_t i) { return weights[i]; });
+}
@@ -0,0 +1,250 @@
+#include "datetime/series/radix_sort.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <fmt/format.h>
+#include <utility>
+#include "../util/macros.h"
+#include "../util/parallel.h"
+
+namespace
+{
+/**
+ * Bits sorted by each least significant digit pass.
+ */
+constexpr uint32_t DIGIT_BITS = 11;
+
+constexpr size_t DIGIT_VALUES = size_t(1) << DIGIT_BITS;
+
+constexpr uint32_t PASSES = (64 + DIGIT_BITS - 1) / DIGIT_BITS;
+
+/**
+ * Bits split on by the parallel most significant digit pass.
+ */
+constexpr uint32_t BUCKET_BITS = 8;
+
+constexpr size_t BUCKETS = size_t(1) << BUCKET_BITS;
+
+/**
+ * Size under which a comparison sort is faster than counting every digit.
+ */
+constexpr size_t MIN_RADIX_SIZE = 256;
+
+/**
+ * Key with the index of its 'Instant', used to sort indexes.
+ */
+struct IndexedKey
+{
+    uint64_t key;
+    size_t index;
+};
+
+/**
+ * Maps the nanoseconds of 'instant' to an unsigned key with the same order.
+ */
+uint64_t to_key(Instant instant)
+{
+    return static_cast<uint64_t>(instant.nanoseconds) ^ (uint64_t(1) << 63);
+}
+
+Instant from_key(uint64_t key)
+{
+    return Instant(static_cast<int64_t>(key ^ (uint64_t(1) << 63)));
+}
+
+uint64_t key_of(uint64_t record)
+{
+    return record;
+}
+
+uint64_t key_of(const IndexedKey& record)
+{
+    return record.key;
+}
+
+/**
+ * Gets the bits that differ between any two of 'records'.
+ */
+template<typename Record>
+uint64_t varying_bits(std::span<const Record> records)
+{
+    uint64_t varying = 0;
+    for (const Record& record : records)
+        varying |= key_of(record) ^ key_of(records.front());
+    return varying;
+}
+
+/**
+ * Stably sorts 'records' by the bits of their keys below 'bits', using 'buffer' of the same
+ * size as scratch space.
+ */
+template<typename Record>
+void lsd_sort(std::span<Record> records, std::span<Record> buffer, uint32_t bits)
+{
+    if (records.size() < MIN_RADIX_SIZE)
+    {
+        uint64_t mask = bits >= 64 ? ~uint64_t(0) : (uint64_t(1) << bits) - 1;
+        std::stable_sort(records.begin(), records.end(),
+                         [mask](const Record& lhs, const Record& rhs)
+                         {
+                             return (key_of(lhs) & mask) < (key_of(rhs) & mask);
+                         });
+        return;
+    }
+
+    uint32_t passes = (bits + DIGIT_BITS - 1) / DIGIT_BITS;
+    std::vector<std::array<size_t, DIGIT_VALUES>> counts(passes);
+    for (const Record& record : records)
+    {
+        uint64_t key = key_of(record);
+        for (uint32_t pass = 0; pass < passes; ++pass)
+            counts[pass][key >> (pass * DIGIT_BITS) & (DIGIT_VALUES - 1)]++;
+    }
+
+    Record* source = records.data();
+    Record* destination = buffer.data();
+    for (uint32_t pass = 0; pass < passes; ++pass)
+    {
+        uint32_t shift = pass * DIGIT_BITS;
+        std::array<size_t, DIGIT_VALUES>& count = counts[pass];
+
+        // Every record has the same digit, so the pass would not move anything.
+        if (count[key_of(source[0]) >> shift & (DIGIT_VALUES - 1)] == records.size())
+            continue;
+
+        size_t offset = 0;
+        for (size_t& digit_count : count)
+            offset += std::exchange(digit_count, offset);
+
+        for (size_t i = 0; i < records.size(); ++i)
+            destination[count[key_of(source[i]) >> shift & (DIGIT_VALUES - 1)]++] = source[i];
+        std::swap(source, destination);
+    }
+
+    if (source != records.data())
+        std::copy(source, source + records.size(), records.data());
+}
+
+/**
+ * Stably sorts 'records' by their keys.
+ */
+template<typename Record>
+void sort_records(std::span<Record> records, unsigned thread_count)
+{
+    ASSERT(thread_count > 0, std::invalid_argument("thread_count must be positive"));
+    if (records.size() < 2)
+        return;
+
+    std::vector<Record> buffer(records.size());
+    auto bits = static_cast<uint32_t>(std::bit_width(varying_bits<Record>(records)));
+    if (bits == 0)
+        return;
+
+    size_t threads = std::min<size_t>(thread_count, records.size() / MIN_RADIX_SIZE);
+    if (threads <= 1 || bits <= BUCKET_BITS)
+    {
+        lsd_sort<Record>(records, buffer, bits);
+        return;
+    }
+
+    // Split on the highest varying digit so the buckets can be sorted independently.
+    uint32_t shift = bits - BUCKET_BITS;
+    auto bucket_of = [shift](const Record& record)
+    {
+        return static_cast<size_t>(key_of(record) >> shift & (BUCKETS - 1));
+    };
+
+    std::vector<size_t> chunks(threads + 1);
+    for (size_t t = 0; t <= threads; ++t)
+        chunks[t] = records.size() * t / threads;
+
+    std::vector<std::array<size_t, BUCKETS>> offsets(threads);
+    run_parallel(static_cast<unsigned>(threads), [&](unsigned t)
+    {
+        offsets[t].fill(0);
+        for (size_t i = chunks[t]; i < chunks[t + 1]; ++i)
+            offsets[t][bucket_of(records[i])]++;
+    });
+
+    // Each thread writes its records of a bucket after those of the threads before it, which
+    // keeps the pass stable.
+    std::array<size_t, BUCKETS + 1> bucket_starts{};
+    size_t offset = 0;
+    for (size_t b = 0; b < BUCKETS; ++b)
+    {
+        bucket_starts[b] = offset;
+        for (size_t t = 0; t < threads; ++t)
+            offset += std::exchange(offsets[t][b], offset);
+    }
+    bucket_starts[BUCKETS] = offset;
+
+    run_parallel(static_cast<unsigned>(threads), [&](unsigned t)
+    {
+        for (size_t i = chunks[t]; i < chunks[t + 1]; ++i)
+            buffer[offsets[t][bucket_of(records[i])]++] = records[i];
+    });
+
+    std::atomic<size_t> next_bucket = 0;
+    run_parallel(static_cast<unsigned>(threads), [&](unsigned)
+    {
+        for (size_t b = next_bucket++; b < BUCKETS; b = next_bucket++)
+        {
+            size_t start = bucket_starts[b];
+            size_t size = bucket_starts[b + 1] - start;
+            std::span<Record> bucket = std::span<Record>(buffer).subspan(start, size);
+            std::span<Record> scratch = records.subspan(start, size);
+            lsd_sort<Record>(bucket, scratch, shift);
+            std::copy(bucket.begin(), bucket.end(), scratch.begin());
+        }
+    });
+}
+
+/**
+ * Gets the keys of 'instants' with their indexes, sorted.
+ */
+std::vector<IndexedKey> sorted_indexed_keys(std::span<const Instant> instants,
+                                            unsigned thread_count)
+{
+    std::vector<IndexedKey> records(instants.size());
+    for (size_t i = 0; i < instants.size(); ++i)
+        records[i] = {to_key(instants[i]), i};
+    sort_records<IndexedKey>(records, thread_count);
+    return records;
+}
+}
+
+void radix_sort(std::span<Instant> instants, unsigned thread_count)
+{
+    std::vector<uint64_t> keys(instants.size());
+    std::transform(instants.begin(), instants.end(), keys.begin(), to_key);
+    sort_records<uint64_t>(keys, thread_count);
+    std::transform(keys.begin(), keys.end(), instants.begin(), from_key);
+}
+
+void radix_sort(std::span<Datetime> datetimes, unsigned thread_count)
+{
+    std::vector<size_t> order = argsort(std::span<const Datetime>(datetimes), thread_count);
+    std::vector<Datetime> sorted;
+    sorted.reserve(datetimes.size());
+    for (size_t index : order)
+        sorted.push_back(datetimes[index]);
+    std::copy(sorted.begin(), sorted.end(), datetimes.begin());
+}
+
+std::vector<size_t> argsort(std::span<const Instant> instants, unsigned thread_count)
+{
+    std::vector<IndexedKey> records = sorted_indexed_keys(instants, thread_count);
+    std::vector<size_t> order(records.size());
+    for (size_t i = 0; i < records.size(); ++i)
+        order[i] = records[i].index;
+    return order;
+}
+
+std::vector<size_t> argsort(std::span<const Datetime> datetimes, unsigned thread_count)
+{
+    std::vector<Instant> instants(datetimes.size());
+    for (size_t i = 0; i < datetimes.size(); ++i)
+        instants[i] = datetimes[i].to_instant();
+    return argsort(instants, thread_count);
+}
@@ -0,0 +1,100 @@
+#include "datetime/series/resample.h"
+#include <algorithm>
+#include <fmt/format.h>
+#include "../util/durations.h"
+
+BucketGrid::BucketGrid(TimeDelta width, Instant origin) :
+    origin(origin),
+    width_divider(positive_nanoseconds(width, "width")),
+    day_divider(Instant::NANOSECONDS_PER_DAY) {}
+
+BucketGrid::BucketGrid(TimeDelta width, Timezone timezone, TimeDelta day_offset) :
+    origin(Instant(timezone.utc_offset * Instant::NANOSECONDS_PER_HOUR
+                   + day_offset.total_nanoseconds())),
+    width_divider(positive_nanoseconds(width, "width")),
+    day_divider(Instant::NANOSECONDS_PER_DAY)
+{
+    auto width_ns = static_cast<int64_t>(width_divider.get_divisor());
+    buckets_per_day = (Instant::NANOSECONDS_PER_DAY + width_ns - 1) / width_ns;
+}
+
+void BucketGrid::bucket_ids(std::span<const Instant> instants, std::span<int64_t> out) const
+{
+    ASSERT(out.size() >= instants.size(),
+           std::invalid_argument(fmt::format("out with size '{}' is smaller than instants with "
+                                             "size '{}'", out.size(), instants.size())));
+
+    // Separate loops so the mode is not checked per element.
+    if (buckets_per_day == 0)
+    {
+        for (size_t i = 0; i < instants.size(); ++i)
+            out[i] = width_divider.floor_divide(instants[i].nanoseconds - origin.nanoseconds);
+    }
+    else
+    {
+        for (size_t i = 0; i < instants.size(); ++i)
+            out[i] = bucket_id(instants[i]);
+    }
+}
+
+Instant BucketGrid::bucket_start(int64_t id) const
+{
+    auto width_ns = static_cast<int64_t>(width_divider.get_divisor());
+    if (buckets_per_day == 0)
+        return Instant(origin.nanoseconds + id * width_ns);
+
+    int64_t day = id / buckets_per_day - (id % buckets_per_day < 0);
+    int64_t bucket_of_day = id - day * buckets_per_day;
+    return Instant(origin.nanoseconds + day * Instant::NANOSECONDS_PER_DAY
+                   + bucket_of_day * width_ns);
+}
+
+Instant BucketGrid::bucket_end(int64_t id) const
+{
+    if (buckets_per_day == 0)
+        return bucket_start(id + 1);
+
+    // The last bucket of a day ends at the start of the next day.
+    Instant end = Instant(bucket_start(id).nanoseconds
+                          + static_cast<int64_t>(width_divider.get_divisor()));
+    int64_t day = id / buckets_per_day - (id % buckets_per_day < 0);
+    return std::min(end, Instant(origin.nanoseconds + (day + 1) * Instant::NANOSECONDS_PER_DAY));
+}
+
+void bucket_ids(std::span<const Instant> instants, TimeDelta width, Instant origin,
+                std::span<int64_t> out)
+{
+    BucketGrid(width, origin).bucket_ids(instants, out);
+}
+
+bool Resampler::push(Instant instant)
+{
+    ASSERT(!has_bucket || instant >= last_instant,
+           std::invalid_argument(fmt::format("instant '{}' is before the previous instant '{}'",
+                                             instant.nanoseconds, last_instant.nanoseconds)));
+    last_instant = instant;
+
+    int64_t bucket = grid.bucket_id(instant);
+    if (has_bucket && bucket == current_bucket)
+        return false;
+
+    has_bucket = true;
+    current_bucket = bucket;
+    current_end = grid.bucket_end(bucket);
+    return true;
+}
+
+void Resampler::push(std::span<const Instant> instants, std::vector<size_t>& boundaries)
+{
+    for (size_t i = 0; i < instants.size(); ++i)
+    {
+        // Only compute the bucket once the current one has been passed.
+        if (has_bucket && instants[i] >= last_instant && instants[i] < current_end)
+        {
+            last_instant = instants[i];
+            continue;
+        }
+        if (push(instants[i]))
+            boundaries.push_back(i);
+    }
+}
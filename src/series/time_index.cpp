@@ -0,0 +1,132 @@
+#include "datetime/series/time_index.h"
+#include <algorithm>
+#include <fmt/format.h>
+#include "../util/macros.h"
+#include "../util/durations.h"
+
+namespace
+{
+/**
+ * Maximum number of interpolation probes before falling back to a binary search.
+ */
+constexpr int MAX_PROBES = 3;
+
+/**
+ * Size of an interval under which a binary search is cheaper than another probe.
+ */
+constexpr size_t MIN_PROBE_SIZE = 32;
+
+/**
+ * Gets the first index in '[low, high)' of 'keys' whose 'Instant' fails 'before', where
+ * 'before' holds for a prefix of 'keys' and the answer is known to be within '[low, high]'.
+ */
+template<typename Predicate>
+size_t interpolation_search(std::span<const Instant> keys, Instant instant, Predicate before,
+                            size_t low, size_t high)
+{
+    for (int probe = 0; probe < MAX_PROBES && high - low > MIN_PROBE_SIZE; ++probe)
+    {
+        Instant first = keys[low];
+        Instant last = keys[high - 1];
+        if (!before(first))
+            return low;
+        if (before(last))
+            return high;
+
+        uint64_t offset = unsigned_distance(instant, first);
+        uint64_t span = unsigned_distance(last, first);
+        auto guess = low + static_cast<size_t>(static_cast<double>(offset)
+            / static_cast<double>(span) * static_cast<double>(high - 1 - low));
+        guess = std::clamp(guess, low, high - 1);
+
+        // Gallop away from the guess until the answer is bracketed.
+        size_t step = 1;
+        if (before(keys[guess]))
+        {
+            low = guess + 1;
+            while (guess + step < high && before(keys[guess + step]))
+            {
+                low = guess + step + 1;
+                step *= 2;
+            }
+            high = std::min(high, guess + step);
+        }
+        else
+        {
+            high = guess;
+            while (guess >= low + step && !before(keys[guess - step]))
+            {
+                high = guess - step;
+                step *= 2;
+            }
+            if (guess >= low + step)
+                low = guess - step + 1;
+        }
+    }
+
+    auto it = std::partition_point(keys.begin() + static_cast<std::ptrdiff_t>(low),
+                                   keys.begin() + static_cast<std::ptrdiff_t>(high), before);
+    return static_cast<size_t>(it - keys.begin());
+}
+}
+
+TimeIndex::TimeIndex(std::vector<Instant> instants, bool sample) :
+    keys(std::move(instants))
+{
+    auto unsorted = std::is_sorted_until(keys.begin(), keys.end());
+    ASSERT(unsorted == keys.end(),
+           std::invalid_argument(fmt::format("instants are not sorted at index '{}'",
+                                             unsorted - keys.begin())));
+
+    if (sample)
+    {
+        samples.reserve(keys.size() / SAMPLE_STRIDE + 1);
+        for (size_t i = 0; i < keys.size(); i += SAMPLE_STRIDE)
+            samples.push_back(keys[i]);
+    }
+}
+
+size_t TimeIndex::lower_bound(Instant instant) const
+{
+    return search<false>(instant);
+}
+
+size_t TimeIndex::upper_bound(Instant instant) const
+{
+    return search<true>(instant);
+}
+
+std::pair<size_t, size_t> TimeIndex::range(Instant start, Instant end) const
+{
+    if (end < start)
+        return {0, 0};
+    return {lower_bound(start), upper_bound(end)};
+}
+
+std::pair<size_t, size_t> TimeIndex::range(const DatetimeRange& datetime_range) const
+{
+    return range(datetime_range.start.to_instant(), datetime_range.end.to_instant());
+}
+
+template<bool upper>
+size_t TimeIndex::search(Instant instant) const
+{
+    // 'before' holds for a prefix of 'keys', the answer is the length of that prefix.
+    auto before = [instant](Instant key)
+    {
+        if constexpr (upper)
+            return key <= instant;
+        else
+            return key < instant;
+    };
+
+    if (samples.empty())
+        return interpolation_search(keys, instant, before, 0, keys.size());
+
+    // The sampled 'Instants' are spread like 'keys', so they are searched the same way.
+    size_t block = interpolation_search(samples, instant, before, 0, samples.size());
+    if (block == 0)
+        return 0;
+    return interpolation_search(keys, instant, before, (block - 1) * SAMPLE_STRIDE + 1,
+                                std::min(block * SAMPLE_STRIDE, keys.size()));
+}
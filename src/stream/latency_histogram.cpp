@@ -0,0 +1,210 @@
+#include "datetime/stream/latency_histogram.h"
+#include <cmath>
+
+namespace
+{
+constexpr uint32_t MAX_PRECISION_BITS = 16;
+
+void write_varint(uint64_t value, std::vector<uint8_t>& out)
+{
+    while (value >= 0x80)
+    {
+        out.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(value));
+}
+
+/**
+ * Reads the variable length integer at 'position' in 'bytes' and moves 'position' past it.
+ */
+uint64_t read_varint(std::span<const uint8_t> bytes, size_t& position)
+{
+    uint64_t value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        ASSERT(position < bytes.size(), std::invalid_argument("bytes ends within a number"));
+        uint8_t byte = bytes[position++];
+        value |= uint64_t(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return value;
+    }
+    throw std::invalid_argument(fmt::format("number at byte '{}' is too long", position));
+}
+}
+
+LatencyHistogram::LatencyHistogram(uint32_t precision_bits) :
+    precision_bits(precision_bits)
+{
+    ASSERT(precision_bits >= 1 && precision_bits <= MAX_PRECISION_BITS,
+           std::invalid_argument(fmt::format("precision_bits '{}' must be between 1 and {}",
+                                             precision_bits, MAX_PRECISION_BITS)));
+
+    // The largest latency, 2^63 - 1 nanoseconds, has an exponent of 63 - 'precision_bits'.
+    bucket_count = size_t(65 - precision_bits) << (precision_bits - 1);
+    counts = std::make_unique<std::atomic<uint64_t>[]>(bucket_count);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram& other)
+{
+    ASSERT(other.precision_bits == precision_bits,
+           std::invalid_argument(fmt::format("other with precision '{}' must have precision '{}'",
+                                             other.precision_bits, precision_bits)));
+    for (size_t b = 0; b < bucket_count; ++b)
+    {
+        uint64_t count = other.counts[b].load(std::memory_order_relaxed);
+        if (count != 0)
+            counts[b].fetch_add(count, std::memory_order_relaxed);
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (size_t b = 0; b < bucket_count; ++b)
+        counts[b].store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    uint64_t total = 0;
+    for (size_t b = 0; b < bucket_count; ++b)
+        total += counts[b].load(std::memory_order_relaxed);
+    return total;
+}
+
+TimeDelta LatencyHistogram::min() const
+{
+    for (size_t b = 0; b < bucket_count; ++b)
+    {
+        if (counts[b].load(std::memory_order_relaxed) != 0)
+            return TimeDelta::from_nanoseconds(static_cast<int64_t>(lowest_of(b)));
+    }
+    return TimeDelta();
+}
+
+TimeDelta LatencyHistogram::max() const
+{
+    for (size_t b = bucket_count; b > 0; --b)
+    {
+        if (counts[b - 1].load(std::memory_order_relaxed) != 0)
+            return TimeDelta::from_nanoseconds(static_cast<int64_t>(highest_of(b - 1)));
+    }
+    return TimeDelta();
+}
+
+TimeDelta LatencyHistogram::mean() const
+{
+    long double sum = 0;
+    uint64_t total = 0;
+    for (size_t b = 0; b < bucket_count; ++b)
+    {
+        uint64_t count = counts[b].load(std::memory_order_relaxed);
+        if (count == 0)
+            continue;
+        long double middle = (static_cast<long double>(lowest_of(b))
+                              + static_cast<long double>(highest_of(b))) / 2;
+        sum += middle * static_cast<long double>(count);
+        total += count;
+    }
+    if (total == 0)
+        return TimeDelta();
+    return TimeDelta::from_nanoseconds(std::llround(sum / static_cast<long double>(total)));
+}
+
+TimeDelta LatencyHistogram::percentile(double percentile) const
+{
+    ASSERT(percentile >= 0 && percentile <= 100,
+           std::invalid_argument(fmt::format("percentile '{}' must be between 0 and 100",
+                                             percentile)));
+
+    uint64_t total = count();
+    if (total == 0)
+        return TimeDelta();
+
+    auto rank = static_cast<uint64_t>(std::ceil(percentile * static_cast<double>(total) / 100));
+    rank = std::clamp<uint64_t>(rank, 1, total);
+
+    uint64_t seen = 0;
+    for (size_t b = 0; b < bucket_count; ++b)
+    {
+        seen += counts[b].load(std::memory_order_relaxed);
+        if (seen >= rank)
+            return TimeDelta::from_nanoseconds(static_cast<int64_t>(highest_of(b)));
+    }
+
+    // Only reached if latencies were recorded while counting.
+    return max();
+}
+
+std::vector<uint8_t> LatencyHistogram::serialize() const
+{
+    std::vector<uint8_t> out;
+    out.push_back(static_cast<uint8_t>(precision_bits));
+
+    uint64_t zeros = 0;
+    for (size_t b = 0; b < bucket_count; ++b)
+    {
+        uint64_t count = counts[b].load(std::memory_order_relaxed);
+        if (count == 0)
+        {
+            zeros++;
+            continue;
+        }
+        if (zeros != 0)
+        {
+            write_varint(0, out);
+            write_varint(zeros, out);
+            zeros = 0;
+        }
+        write_varint(count, out);
+    }
+    return out;
+}
+
+LatencyHistogram LatencyHistogram::deserialize(std::span<const uint8_t> bytes)
+{
+    ASSERT(!bytes.empty(), std::invalid_argument("bytes must not be empty"));
+    LatencyHistogram histogram = LatencyHistogram(bytes[0]);
+
+    size_t bucket = 0;
+    size_t position = 1;
+    while (position < bytes.size())
+    {
+        uint64_t count = read_varint(bytes, position);
+        if (count == 0)
+        {
+            uint64_t zeros = read_varint(bytes, position);
+            ASSERT(zeros <= histogram.bucket_count - bucket,
+                   std::invalid_argument(fmt::format("run of '{}' empty buckets at bucket '{}' "
+                                                     "is past the last bucket", zeros, bucket)));
+            bucket += zeros;
+            continue;
+        }
+
+        ASSERT(bucket < histogram.bucket_count,
+               std::invalid_argument(fmt::format("count at byte '{}' is past the last bucket",
+                                                 position)));
+        histogram.counts[bucket++].store(count, std::memory_order_relaxed);
+    }
+    return histogram;
+}
+
+uint64_t LatencyHistogram::lowest_of(size_t bucket) const
+{
+    size_t half = size_t(1) << (precision_bits - 1);
+    if (bucket < 2 * half)
+        return bucket;
+
+    size_t exponent = bucket / half - 1;
+    return static_cast<uint64_t>(bucket - exponent * half) << exponent;
+}
+
+uint64_t LatencyHistogram::highest_of(size_t bucket) const
+{
+    size_t half = size_t(1) << (precision_bits - 1);
+    if (bucket < 2 * half)
+        return bucket;
+
+    size_t exponent = bucket / half - 1;
+    return (static_cast<uint64_t>(bucket - exponent * half + 1) << exponent) - 1;
+}
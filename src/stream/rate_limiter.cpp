@@ -0,0 +1,117 @@
+#include "datetime/stream/rate_limiter.h"
+#include <algorithm>
+#include <fmt/format.h>
+#include <limits>
+#include "../util/macros.h"
+#include "../util/durations.h"
+#include "../util/math.h"
+
+namespace
+{
+void check_batch(uint64_t permits, uint64_t limit)
+{
+    ASSERT(permits <= limit,
+           std::invalid_argument(fmt::format("permits '{}' must not be more than '{}'",
+                                             permits, limit)));
+}
+}
+
+RateLimiter::RateLimiter(uint64_t permits, const TimeDelta& period, uint64_t burst) :
+    interval(0),
+    burst(burst),
+    tolerance(0),
+    arrival(std::numeric_limits<int64_t>::min())
+{
+    ASSERT(permits > 0, std::invalid_argument("permits must be positive"));
+    ASSERT(burst > 0, std::invalid_argument("burst must be positive"));
+    auto nanoseconds = static_cast<int64_t>(positive_nanoseconds(period, "period"));
+
+    interval = (nanoseconds - 1) / static_cast<int64_t>(permits) + 1;
+    ASSERT(burst <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max() / interval),
+           std::invalid_argument(fmt::format("burst '{}' is too large", burst)));
+    tolerance = static_cast<int64_t>(burst) * interval;
+}
+
+bool RateLimiter::try_acquire(uint64_t permits, Instant now)
+{
+    check_batch(permits, burst);
+    auto cost = static_cast<uint64_t>(permits) * static_cast<uint64_t>(interval);
+    int64_t limit = saturating_add(now.nanoseconds, tolerance);
+    int64_t current = arrival.load();
+    while (true)
+    {
+        // The arrival time is only more than 'tolerance' ahead if the clock stepped back, in
+        // which case the bucket is emptied at 'now' instead of waiting out the step.
+        if (current > limit && !arrival.compare_exchange_weak(current, limit))
+            continue;
+        current = std::min(current, limit);
+
+        // The bucket is full when the arrival time has fallen behind now. Both the backlog and
+        // the cost are at most 'tolerance', so their unsigned sum does not overflow.
+        uint64_t backlog = current > now.nanoseconds ? unsigned_distance(Instant(current), now) : 0;
+        if (backlog + cost > static_cast<uint64_t>(tolerance))
+            return false;
+        int64_t next = saturating_add(now.nanoseconds, static_cast<int64_t>(backlog + cost));
+        if (arrival.compare_exchange_weak(current, next))
+            return true;
+    }
+}
+
+Instant RateLimiter::available_at(uint64_t permits, Instant now) const
+{
+    check_batch(permits, burst);
+    int64_t current = std::min(arrival.load(), saturating_add(now.nanoseconds, tolerance));
+    if (current <= now.nanoseconds)
+        return now;
+
+    uint64_t backlog = unsigned_distance(Instant(current), now);
+    auto cost = static_cast<uint64_t>(permits) * static_cast<uint64_t>(interval);
+    if (backlog + cost <= static_cast<uint64_t>(tolerance))
+        return now;
+    auto wait = static_cast<int64_t>(backlog + cost - static_cast<uint64_t>(tolerance));
+    return Instant(saturating_add(now.nanoseconds, wait));
+}
+
+SlidingWindowRateLimiter::SlidingWindowRateLimiter(uint64_t permits, const TimeDelta& period) :
+    period(static_cast<int64_t>(positive_nanoseconds(period, "period")))
+{
+    ASSERT(permits > 0, std::invalid_argument("permits must be positive"));
+    times.resize(permits);
+}
+
+bool SlidingWindowRateLimiter::try_acquire(uint64_t permits, Instant now)
+{
+    check_batch(permits, times.size());
+
+    // Permits after 'now' were acquired before the clock stepped back, so they are moved to
+    // 'now' to expire a period from now instead of waiting out the step.
+    for (size_t i = count; i > 0 && time_at(i - 1) > now.nanoseconds; --i)
+        times[index_of(i - 1)] = now.nanoseconds;
+
+    // Permits expire when they leave the window '(now - period, now]'. None are after 'now', so
+    // the unsigned distance to them does not wrap.
+    auto width = static_cast<uint64_t>(period);
+    while (count > 0 && unsigned_distance(now, Instant(time_at(0))) >= width)
+    {
+        oldest = oldest + 1 == times.size() ? 0 : oldest + 1;
+        count--;
+    }
+    if (count + permits > times.size())
+        return false;
+
+    for (uint64_t i = 0; i < permits; ++i)
+        times[index_of(count++)] = now.nanoseconds;
+    return true;
+}
+
+Instant SlidingWindowRateLimiter::available_at(uint64_t permits, Instant now) const
+{
+    check_batch(permits, times.size());
+    if (count + permits <= times.size())
+        return now;
+
+    // The permits fit when enough of the oldest acquired permits have expired.
+    size_t expired = count + permits - times.size();
+    int64_t time = std::min(time_at(expired - 1), now.nanoseconds);
+    return Instant(std::max(now.nanoseconds, saturating_add(time, period)));
+}
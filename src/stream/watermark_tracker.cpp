@@ -0,0 +1,121 @@
+#include "datetime/stream/watermark_tracker.h"
+#include <algorithm>
+#include <bit>
+#include <fmt/format.h>
+#include <limits>
+#include "../util/macros.h"
+#include "../util/durations.h"
+
+namespace
+{
+constexpr int64_t NO_EVENT = std::numeric_limits<int64_t>::min();
+
+constexpr int64_t NO_LIMIT = std::numeric_limits<int64_t>::max();
+
+/**
+ * Raises 'node' to 'value' if it is lower.
+ */
+void raise_to(std::atomic<int64_t>& node, int64_t value)
+{
+    int64_t current = node.load();
+    while (current < value && !node.compare_exchange_weak(current, value))
+    {
+    }
+}
+}
+
+WatermarkTracker::WatermarkTracker(size_t source_count, TimeDelta allowed_lateness) :
+    sources(source_count),
+    allowed_lateness(static_cast<int64_t>(non_negative_nanoseconds(allowed_lateness,
+                                                                   "allowed_lateness"))),
+    leaves(std::bit_ceil(std::max<size_t>(source_count, 1)))
+{
+    ASSERT(source_count > 0, std::invalid_argument("source_count must be positive"));
+
+    source_states = std::make_unique<Source[]>(sources);
+    for (size_t s = 0; s < sources; ++s)
+    {
+        source_states[s].latest.store(NO_EVENT);
+        source_states[s].late.store(0);
+    }
+
+    nodes = std::make_unique<std::atomic<int64_t>[]>(leaves);
+    for (size_t i = leaves - 1; i > 0; --i)
+        nodes[i].store(std::min(node_value(2 * i), node_value(2 * i + 1)));
+}
+
+bool WatermarkTracker::observe(size_t source, Instant event_time)
+{
+    ASSERT(source < sources,
+           std::invalid_argument(fmt::format("source '{}' is out of range for '{}' sources",
+                                             source, sources)));
+
+    std::optional<Instant> current = watermark();
+    if (current && event_time < *current)
+    {
+        source_states[source].late.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // Only this thread writes the source, so a plain load and store cannot lose an update.
+    std::atomic<int64_t>& latest = source_states[source].latest;
+    if (event_time.nanoseconds <= latest.load(std::memory_order_relaxed))
+        return true;
+    latest.store(event_time.nanoseconds);
+
+    // Sequentially consistent, so of two sources updated at once, at least one sees both
+    // writes and raises the shared parents to the true minimum.
+    for (size_t index = (leaves + source) / 2; index > 0; index /= 2)
+        raise_to(nodes[index], std::min(node_value(2 * index), node_value(2 * index + 1)));
+    return true;
+}
+
+std::optional<Instant> WatermarkTracker::watermark() const
+{
+    int64_t minimum = leaves == 1 ? node_value(1) : nodes[1].load();
+    if (minimum == NO_EVENT)
+        return std::nullopt;
+
+    // Saturate instead of overflowing for event times near the minimum.
+    if (minimum < NO_EVENT + allowed_lateness)
+        return Instant(NO_EVENT);
+    return Instant(minimum - allowed_lateness);
+}
+
+std::optional<Instant> WatermarkTracker::latest_event_time(size_t source) const
+{
+    ASSERT(source < sources,
+           std::invalid_argument(fmt::format("source '{}' is out of range for '{}' sources",
+                                             source, sources)));
+
+    int64_t latest = source_states[source].latest.load();
+    if (latest == NO_EVENT)
+        return std::nullopt;
+    return Instant(latest);
+}
+
+uint64_t WatermarkTracker::late_events(size_t source) const
+{
+    ASSERT(source < sources,
+           std::invalid_argument(fmt::format("source '{}' is out of range for '{}' sources",
+                                             source, sources)));
+
+    return source_states[source].late.load(std::memory_order_relaxed);
+}
+
+uint64_t WatermarkTracker::late_events() const
+{
+    uint64_t total = 0;
+    for (size_t s = 0; s < sources; ++s)
+        total += source_states[s].late.load(std::memory_order_relaxed);
+    return total;
+}
+
+int64_t WatermarkTracker::node_value(size_t index) const
+{
+    if (index < leaves)
+        return nodes[index].load();
+    if (index - leaves < sources)
+        return source_states[index - leaves].latest.load();
+    return NO_LIMIT;
+}
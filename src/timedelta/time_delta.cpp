@@ -75,3 +75,27 @@ TimeDelta &TimeDelta::abs()
     days = std::abs(days);
     return *this;
 }
+
+TimeDelta TimeDelta::from_nanoseconds(int64_t nanoseconds)
+{
+    const auto nanoseconds_per_hour = static_cast<int64_t>(NANOSECONDS_PER_HOUR);
+    const int64_t nanoseconds_per_day = nanoseconds_per_hour * HOURS_PER_DAY;
+
+    int64_t days = nanoseconds / nanoseconds_per_day;
+    int64_t remainder = nanoseconds % nanoseconds_per_day;
+    if (remainder < 0)
+    {
+        remainder += nanoseconds_per_day;
+        days--;
+    }
+
+    return TimeDelta(
+        days,
+        remainder / nanoseconds_per_hour,
+        remainder / static_cast<int64_t>(NANOSECONDS_PER_MINUTE) % MINUTES_PER_HOUR,
+        remainder / static_cast<int64_t>(NANOSECONDS_PER_SECOND) % SECONDS_PER_MINUTE,
+        remainder / static_cast<int64_t>(NANOSECONDS_PER_MILLISECOND) % MILLISECONDS_PER_SECOND,
+        remainder / static_cast<int64_t>(NANOSECONDS_PER_MICROSECOND) % MICROSECONDS_PER_MILLISECOND,
+        remainder % static_cast<int64_t>(NANOSECONDS_PER_MICROSECOND)
+    );
+}
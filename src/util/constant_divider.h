@@ -0,0 +1,136 @@
+#ifndef DATETIME_CONSTANT_DIVIDER_H
+#define DATETIME_CONSTANT_DIVIDER_H
+
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include "macros.h"
+
+/**
+ * Divides unsigned 64-bit numbers by a divisor fixed at construction.
+ *
+ * Replaces each division by a multiplication by a precomputed "magic" number, a subtraction,
+ * an addition and shifts, which is several times faster than a hardware division when the
+ * same divisor is used for a whole column.
+ *
+ * @see "Division by Invariant Integers using Multiplication", Granlund and Montgomery.
+ */
+class ConstantDivider
+{
+public:
+
+    /**
+     * Creates a 'ConstantDivider' that divides by 'divisor'.
+     *
+     * @param divisor number to divide by.
+     *
+     * @throws std::invalid_argument if 'divisor' is 0.
+     */
+    explicit ConstantDivider(uint64_t divisor) :
+        divisor(divisor)
+    {
+        ASSERT(divisor != 0, std::invalid_argument("divisor must not be 0"));
+
+        shift = static_cast<uint32_t>(std::bit_width(divisor) - 1);
+        if (std::has_single_bit(divisor))
+            return;
+
+        // magic = 2 * floor(2^(64 + shift) / divisor) + 1, rounded up once more if the
+        // remainder is at least half of 'divisor'.
+        uint64_t remainder = 0;
+        uint64_t quotient = 0;
+        for (int bit = 63 + static_cast<int>(shift) + 1; bit >= 0; --bit)
+        {
+            bool carry = remainder >> 63;
+            remainder = remainder << 1 | (bit == 64 + static_cast<int>(shift) ? 1 : 0);
+            quotient <<= 1;
+            if (carry || remainder >= divisor)
+            {
+                remainder -= divisor;
+                quotient |= 1;
+            }
+        }
+
+        magic = quotient + quotient;
+        uint64_t twice_remainder = remainder + remainder;
+        if (twice_remainder >= divisor || twice_remainder < remainder)
+            magic++;
+        magic++;
+    }
+
+    /**
+     * Divides 'dividend' by the divisor.
+     *
+     * @param dividend number to divide.
+     *
+     * @return 'dividend' divided by the divisor, rounded down.
+     */
+    uint64_t divide(uint64_t dividend) const
+    {
+        if (magic == 0)
+            return dividend >> shift;
+
+        uint64_t high = multiply_high(magic, dividend);
+        return (((dividend - high) >> 1) + high) >> shift;
+    }
+
+    /**
+     * Divides 'dividend' by the divisor, rounding towards negative infinity.
+     *
+     * @param dividend number to divide.
+     *
+     * @return 'dividend' divided by the divisor, rounded down.
+     */
+    int64_t floor_divide(int64_t dividend) const
+    {
+        // For negative 'dividend', floor(dividend / divisor) == ~(~dividend / divisor).
+        auto sign = static_cast<uint64_t>(dividend >> 63);
+        return static_cast<int64_t>(sign ^ divide(sign ^ static_cast<uint64_t>(dividend)));
+    }
+
+    /**
+     * Gets the divisor.
+     *
+     * @return the divisor.
+     */
+    uint64_t get_divisor() const
+    {
+        return divisor;
+    }
+
+private:
+
+    uint64_t divisor;
+
+    /**
+     * Magic number to multiply by, 0 if 'divisor' is a power of 2.
+     */
+    uint64_t magic = 0;
+
+    uint32_t shift = 0;
+
+    /**
+     * Gets the high 64 bits of the 128-bit product of 'lhs' and 'rhs'.
+     */
+    static uint64_t multiply_high(uint64_t lhs, uint64_t rhs)
+    {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<uint64_t>(static_cast<unsigned __int128>(lhs) * rhs >> 64);
+#else
+        uint64_t lhs_low = lhs & 0xFFFFFFFF;
+        uint64_t lhs_high = lhs >> 32;
+        uint64_t rhs_low = rhs & 0xFFFFFFFF;
+        uint64_t rhs_high = rhs >> 32;
+
+        uint64_t low_low = lhs_low * rhs_low;
+        uint64_t high_low = lhs_high * rhs_low;
+        uint64_t low_high = lhs_low * rhs_high;
+        uint64_t high_high = lhs_high * rhs_high;
+
+        uint64_t middle = (low_low >> 32) + (high_low & 0xFFFFFFFF) + low_high;
+        return high_high + (high_low >> 32) + (middle >> 32);
+#endif
+    }
+};
+
+#endif //DATETIME_CONSTANT_DIVIDER_H
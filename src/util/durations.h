@@ -0,0 +1,66 @@
+#ifndef DATETIME_DURATIONS_H
+#define DATETIME_DURATIONS_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <fmt/format.h>
+#include "datetime/instant/instant.h"
+#include "datetime/timedelta/timedelta.h"
+#include "macros.h"
+
+/**
+ * Gets the nanoseconds of 'delta', which must be positive.
+ *
+ * @param delta duration to get the nanoseconds of.
+ * @param name name of the argument 'delta' was passed as, for the error message.
+ *
+ * @return nanoseconds of 'delta'.
+ *
+ * @throws std::invalid_argument if 'delta' is not positive.
+ */
+inline uint64_t positive_nanoseconds(const TimeDelta& delta, std::string_view name)
+{
+    int64_t nanoseconds = delta.total_nanoseconds();
+    ASSERT(nanoseconds > 0,
+           std::invalid_argument(fmt::format("{} '{}' must be positive", name, nanoseconds)));
+    return static_cast<uint64_t>(nanoseconds);
+}
+
+/**
+ * Gets the nanoseconds of 'delta', which must not be negative.
+ *
+ * @param delta duration to get the nanoseconds of.
+ * @param name name of the argument 'delta' was passed as, for the error message.
+ *
+ * @return nanoseconds of 'delta'.
+ *
+ * @throws std::invalid_argument if 'delta' is negative.
+ */
+inline uint64_t non_negative_nanoseconds(const TimeDelta& delta, std::string_view name)
+{
+    int64_t nanoseconds = delta.total_nanoseconds();
+    ASSERT(nanoseconds >= 0,
+           std::invalid_argument(fmt::format("{} '{}' must not be negative", name,
+                                             nanoseconds)));
+    return static_cast<uint64_t>(nanoseconds);
+}
+
+/**
+ * Gets the nanoseconds from 'earlier' to 'later'.
+ *
+ * The subtraction is unsigned so the distance between the extremes does not overflow. If 'later'
+ * is before 'earlier' the distance wraps around to a value larger than any real distance, so a
+ * single comparison checks both bounds of a span.
+ *
+ * @param later later 'Instant'.
+ * @param earlier earlier 'Instant'.
+ *
+ * @return nanoseconds from 'earlier' to 'later'.
+ */
+inline uint64_t unsigned_distance(Instant later, Instant earlier)
+{
+    return static_cast<uint64_t>(later.nanoseconds) - static_cast<uint64_t>(earlier.nanoseconds);
+}
+
+#endif //DATETIME_DURATIONS_H
@@ -0,0 +1,26 @@
+#ifndef DATETIME_HASH_H
+#define DATETIME_HASH_H
+
+#include <cstdint>
+
+/**
+ * Mixes the bits of 'key' so that nearby keys, such as consecutive days or nanoseconds, are
+ * spread over every bit of the hash.
+ *
+ * @param key key to hash.
+ *
+ * @return hash of 'key'.
+ *
+ * @see the finalizer of "SplitMix64", Steele, Lea and Flood.
+ */
+inline uint64_t mix_hash(uint64_t key)
+{
+    key ^= key >> 30;
+    key *= 0xBF58476D1CE4E5B9;
+    key ^= key >> 27;
+    key *= 0x94D049BB133111EB;
+    key ^= key >> 31;
+    return key;
+}
+
+#endif //DATETIME_HASH_H
@@ -0,0 +1,52 @@
+#ifndef DATETIME_MATH_H
+#define DATETIME_MATH_H
+
+#include <cstdint>
+#include <limits>
+
+/**
+ * Divides 'dividend' by 'divisor', rounding towards negative infinity.
+ *
+ * @param dividend number to divide.
+ * @param divisor number to divide by. Must be positive.
+ *
+ * @return 'dividend' divided by 'divisor', rounded down.
+ */
+inline int64_t floor_div(int64_t dividend, int64_t divisor)
+{
+    int64_t quotient = dividend / divisor;
+    return quotient - (dividend % divisor < 0);
+}
+
+/**
+ * Gets the remainder of 'floor_div'.
+ *
+ * @param dividend number to divide.
+ * @param divisor number to divide by. Must be positive.
+ *
+ * @return remainder of 'dividend' divided by 'divisor', between 0 and 'divisor' - 1.
+ */
+inline int64_t floor_mod(int64_t dividend, int64_t divisor)
+{
+    int64_t remainder = dividend % divisor;
+    return remainder + (remainder < 0 ? divisor : 0);
+}
+
+/**
+ * Adds 'lhs' and 'rhs', clamping to the range of 'int64_t' instead of overflowing.
+ *
+ * @param lhs number to add to.
+ * @param rhs number to add.
+ *
+ * @return 'lhs' plus 'rhs', or the closest 'int64_t' to it.
+ */
+inline int64_t saturating_add(int64_t lhs, int64_t rhs)
+{
+    if (rhs > 0 && lhs > std::numeric_limits<int64_t>::max() - rhs)
+        return std::numeric_limits<int64_t>::max();
+    if (rhs < 0 && lhs < std::numeric_limits<int64_t>::min() - rhs)
+        return std::numeric_limits<int64_t>::min();
+    return lhs + rhs;
+}
+
+#endif //DATETIME_MATH_H
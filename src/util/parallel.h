@@ -0,0 +1,24 @@
+#ifndef DATETIME_PARALLEL_H
+#define DATETIME_PARALLEL_H
+
+#include <thread>
+#include <vector>
+
+/**
+ * Runs 'task(i)' for every 'i' below 'thread_count' on its own thread.
+ *
+ * @param thread_count number of threads to run.
+ * @param task function called with the index of its thread.
+ */
+template<typename Task>
+void run_parallel(unsigned thread_count, Task task)
+{
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count);
+    for (unsigned i = 0; i < thread_count; ++i)
+        threads.emplace_back(task, i);
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+#endif //DATETIME_PARALLEL_H
@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <random>
+#include "test_helpers.h"
+
+namespace
+{
+constexpr size_t NONE = ASOF_NO_MATCH;
+
+std::vector<Instant> materialize(const TimeGrid& grid)
+{
+    std::vector<Instant> ret;
+    for (size_t i = 0; i < grid.size(); ++i)
+        ret.push_back(grid[i]);
+    return ret;
+}
+}
+
+TEST(TimeGrid, constructor)
+{
+    TimeGrid grid = TimeGrid(Instant(5), TimeDelta::from_nanoseconds(10), 3);
+    EXPECT_EQ(materialize(grid), instants({5, 15, 25}));
+
+    EXPECT_THROW(TimeGrid(Instant(), TimeDelta(), 1), std::invalid_argument);
+}
+
+TEST(TimeGrid, from_range)
+{
+    Datetime start = Datetime(2022, 1, 3, 9, 30);
+    Datetime end = Datetime(2022, 1, 3, 9, 31);
+    std::vector<Datetime> expected = Datetime::range(start, end, Seconds(7));
+
+    TimeGrid grid = TimeGrid(DatetimeRange(start, end), TimeDelta(0, 0, 0, 7));
+    ASSERT_EQ(grid.size(), expected.size());
+    for (size_t i = 0; i < grid.size(); ++i)
+        EXPECT_EQ(grid[i], expected[i].to_instant());
+
+    EXPECT_EQ(TimeGrid(DatetimeRange(start, end), TimeDelta(0, 0, 1)).size(), 2);
+}
+
+TEST(AlignToGrid, directions)
+{
+    TimeGrid grid = TimeGrid(Instant(0), TimeDelta::from_nanoseconds(10), 5);
+    auto series = instants({3, 10, 10, 24, 26});
+
+    EXPECT_EQ(align_to_grid(grid, series), std::vector<size_t>({NONE, 2, 2, 4, 4}));
+    EXPECT_EQ(align_to_grid(grid, series, AsofDirection::FORWARD),
+              std::vector<size_t>({0, 1, 3, NONE, NONE}));
+    EXPECT_EQ(align_to_grid(grid, series, AsofDirection::NEAREST),
+              std::vector<size_t>({0, 2, 3, 4, 4}));
+    EXPECT_EQ(align_to_grid(grid, series, TimeDelta::from_nanoseconds(5)),
+              std::vector<size_t>({NONE, 2, NONE, 4, NONE}));
+
+    TimeDelta tolerance = TimeDelta::from_nanoseconds(4);
+    EXPECT_EQ(align_to_grid(grid, series, tolerance, AsofDirection::NEAREST),
+              std::vector<size_t>({0, 2, 3, 4, NONE}));
+    EXPECT_EQ(align_to_grid(grid, instants({})), std::vector<size_t>(5, NONE));
+}
+
+TEST(AlignToGrid, invalid)
+{
+    TimeGrid grid = TimeGrid(Instant(0), TimeDelta::from_nanoseconds(10), 3);
+    EXPECT_THROW(align_to_grid(grid, instants({1}), TimeDelta::from_nanoseconds(-1)),
+                 std::invalid_argument);
+
+    std::vector<size_t> too_small(2);
+    EXPECT_THROW(align_to_grid(grid, instants({1}), TimeDelta(), AsofDirection::BACKWARD,
+                               too_small),
+                 std::invalid_argument);
+}
+
+TEST(AlignToGrid, matches_asof_join)
+{
+    std::mt19937_64 rng(92);
+    std::vector<Instant> series;
+    int64_t nanoseconds = 0;
+    for (size_t i = 0; i < 1'000; ++i)
+    {
+        nanoseconds += static_cast<int64_t>(rng() % 40);
+        series.emplace_back(nanoseconds);
+    }
+
+    TimeGrid grid = TimeGrid(Instant(-100), TimeDelta::from_nanoseconds(17), 1'300);
+    std::vector<Instant> points = materialize(grid);
+    for (AsofDirection direction : {AsofDirection::BACKWARD, AsofDirection::FORWARD,
+                                    AsofDirection::NEAREST})
+    {
+        TimeDelta tolerance = TimeDelta::from_nanoseconds(12);
+        EXPECT_EQ(align_to_grid(grid, series, tolerance, direction),
+                  asof_join(points, series, tolerance, direction));
+        EXPECT_EQ(align_to_grid(grid, series, direction), asof_join(points, series, direction));
+    }
+}
+
+TEST(AlignToGrid, many_series)
+{
+    std::mt19937_64 rng(92);
+    std::vector<std::vector<Instant>> columns(9);
+    for (std::vector<Instant>& column : columns)
+    {
+        int64_t nanoseconds = static_cast<int64_t>(rng() % 100);
+        for (size_t i = rng() % 500; i > 0; --i)
+        {
+            nanoseconds += static_cast<int64_t>(rng() % 30);
+            column.emplace_back(nanoseconds);
+        }
+    }
+    std::vector<std::span<const Instant>> series(columns.begin(), columns.end());
+    TimeGrid grid = TimeGrid(Instant(0), TimeDelta::from_nanoseconds(25), 400);
+    TimeDelta tolerance = TimeDelta::from_nanoseconds(20);
+
+    for (unsigned thread_count : {1, 4})
+    {
+        auto aligned = align_to_grid(grid, series, tolerance, AsofDirection::NEAREST,
+                                     thread_count);
+        ASSERT_EQ(aligned.size(), columns.size());
+        for (size_t s = 0; s < columns.size(); ++s)
+            EXPECT_EQ(aligned[s], align_to_grid(grid, columns[s], tolerance,
+                                                AsofDirection::NEAREST));
+    }
+
+    EXPECT_THROW(align_to_grid(grid, series, tolerance, AsofDirection::BACKWARD, 0),
+                 std::invalid_argument);
+}
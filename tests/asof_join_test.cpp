@@ -0,0 +1,134 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <random>
+#include "test_helpers.h"
+
+namespace
+{
+/**
+ * Matches by scanning all of 'right' for each of 'left'.
+ */
+std::vector<size_t> naive_asof_join(const std::vector<Instant>& left,
+                                    const std::vector<Instant>& right, int64_t tolerance,
+                                    AsofDirection direction)
+{
+    std::vector<size_t> ret;
+    for (Instant instant : left)
+    {
+        size_t backward = ASOF_NO_MATCH;
+        size_t forward = ASOF_NO_MATCH;
+        for (size_t j = 0; j < right.size(); ++j)
+        {
+            if (right[j] <= instant && instant.nanoseconds - right[j].nanoseconds <= tolerance)
+                backward = j;
+            if (right[j] >= instant && right[j].nanoseconds - instant.nanoseconds <= tolerance
+                && forward == ASOF_NO_MATCH)
+                forward = j;
+        }
+
+        if (direction == AsofDirection::BACKWARD)
+            ret.push_back(backward);
+        else if (direction == AsofDirection::FORWARD)
+            ret.push_back(forward);
+        else if (backward == ASOF_NO_MATCH)
+            ret.push_back(forward);
+        else if (forward == ASOF_NO_MATCH)
+            ret.push_back(backward);
+        else
+            ret.push_back(right[forward].nanoseconds - instant.nanoseconds
+                          < instant.nanoseconds - right[backward].nanoseconds ? forward : backward);
+    }
+    return ret;
+}
+}
+
+const size_t NO = ASOF_NO_MATCH;
+
+TEST(AsofJoin, backward)
+{
+    auto left = instants({0, 5, 10, 10, 15, 30});
+    auto right = instants({1, 5, 5, 9, 20});
+    EXPECT_EQ(asof_join(left, right), std::vector<size_t>({NO, 2, 3, 3, 3, 4}));
+    EXPECT_EQ(asof_join(left, right, TimeDelta::from_nanoseconds(5)),
+              std::vector<size_t>({NO, 2, 3, 3, NO, NO}));
+}
+
+TEST(AsofJoin, forward)
+{
+    auto left = instants({0, 5, 10, 10, 15, 30});
+    auto right = instants({1, 5, 5, 9, 20});
+    EXPECT_EQ(asof_join(left, right, AsofDirection::FORWARD),
+              std::vector<size_t>({0, 1, 4, 4, 4, NO}));
+    EXPECT_EQ(asof_join(left, right, TimeDelta::from_nanoseconds(5), AsofDirection::FORWARD),
+              std::vector<size_t>({0, 1, NO, NO, 4, NO}));
+}
+
+TEST(AsofJoin, nearest)
+{
+    auto left = instants({0, 5, 7, 14, 15, 30});
+    auto right = instants({1, 5, 9, 20});
+    EXPECT_EQ(asof_join(left, right, AsofDirection::NEAREST),
+              std::vector<size_t>({0, 1, 1, 2, 3, 3}));
+    EXPECT_EQ(asof_join(left, right, TimeDelta::from_nanoseconds(2), AsofDirection::NEAREST),
+              std::vector<size_t>({0, 1, 1, NO, NO, NO}));
+}
+
+TEST(AsofJoin, empty)
+{
+    auto left = instants({1, 2});
+    auto none = instants({});
+    EXPECT_EQ(asof_join(left, none), std::vector<size_t>({NO, NO}));
+    EXPECT_TRUE(asof_join(none, left).empty());
+    EXPECT_TRUE(asof_join(none, left, AsofDirection::BACKWARD, 4).empty());
+}
+
+TEST(AsofJoin, extreme_distance)
+{
+    auto left = instants({std::numeric_limits<int64_t>::max()});
+    auto right = instants({std::numeric_limits<int64_t>::min()});
+    EXPECT_EQ(asof_join(left, right), std::vector<size_t>({0}));
+    EXPECT_EQ(asof_join(left, right, TimeDelta(1)), std::vector<size_t>({NO}));
+}
+
+TEST(AsofJoin, invalid)
+{
+    auto left = instants({1, 3, 2});
+    auto right = instants({1, 2});
+    EXPECT_THROW(asof_join(left, right), std::invalid_argument);
+    EXPECT_THROW(asof_join(left, right, AsofDirection::BACKWARD, 2), std::invalid_argument);
+    EXPECT_THROW(asof_join(right, left, AsofDirection::BACKWARD, 0), std::invalid_argument);
+    EXPECT_THROW(asof_join(right, left, TimeDelta::from_nanoseconds(-1)), std::invalid_argument);
+
+    std::vector<size_t> too_small(1);
+    EXPECT_THROW(asof_join(right, left, TimeDelta(), AsofDirection::BACKWARD, 1, too_small),
+                 std::invalid_argument);
+}
+
+TEST(AsofJoin, matches_naive)
+{
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int64_t> value(0, 200);
+    for (size_t right_size : {0, 1, 10, 100, 1000})
+    {
+        std::vector<Instant> left;
+        std::vector<Instant> right;
+        for (size_t i = 0; i < 100; ++i)
+            left.push_back(Instant(value(rng)));
+        for (size_t i = 0; i < right_size; ++i)
+            right.push_back(Instant(value(rng)));
+        std::sort(left.begin(), left.end());
+        std::sort(right.begin(), right.end());
+
+        for (AsofDirection direction : {AsofDirection::BACKWARD, AsofDirection::FORWARD,
+                                        AsofDirection::NEAREST})
+        {
+            for (unsigned threads : {1, 3, 8})
+            {
+                EXPECT_EQ(asof_join(left, right, TimeDelta::from_nanoseconds(10), direction,
+                                    threads),
+                          naive_asof_join(left, right, 10, direction))
+                    << right_size << " " << threads;
+            }
+        }
+    }
+}
@@ -0,0 +1,117 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <random>
+
+namespace
+{
+/**
+ * Checks that 'instants' decode unchanged through every decoding path.
+ */
+void expect_round_trip(const std::vector<Instant>& instants)
+{
+    CompressedTimestampColumn column = CompressedTimestampColumn(instants);
+    EXPECT_EQ(column.size(), instants.size());
+    EXPECT_EQ(column.decode(), instants);
+
+    for (size_t i = 0; i < instants.size(); i += 331)
+        EXPECT_EQ(column.at(i), instants[i]) << i;
+
+    std::vector<Instant> block(CompressedTimestampColumn::BLOCK_SIZE);
+    for (size_t b = 0; b < column.block_count(); ++b)
+    {
+        size_t size = column.decode_block(b, block);
+        for (size_t i = 0; i < size; ++i)
+            EXPECT_EQ(block[i], instants[b * CompressedTimestampColumn::BLOCK_SIZE + i]);
+    }
+}
+}
+
+TEST(CompressedTimestampColumn, empty)
+{
+    CompressedTimestampColumn column;
+    EXPECT_TRUE(column.empty());
+    EXPECT_EQ(column.block_count(), 0);
+    EXPECT_TRUE(column.decode().empty());
+    EXPECT_EQ(column.compression_ratio(), 0);
+    EXPECT_THROW(column.at(0), std::invalid_argument);
+}
+
+TEST(CompressedTimestampColumn, append)
+{
+    CompressedTimestampColumn column;
+    column.append(Instant(10));
+    EXPECT_EQ(column.decode(), std::vector<Instant>({Instant(10)}));
+
+    std::vector<Instant> more = {Instant(20), Instant(30), Instant(25), Instant(1'000'000)};
+    column.append(more);
+    EXPECT_EQ(column.size(), 5);
+    EXPECT_EQ(column.at(3), Instant(25));
+    EXPECT_EQ(column.decode(), std::vector<Instant>({Instant(10), Instant(20), Instant(30),
+                                                     Instant(25), Instant(1'000'000)}));
+}
+
+TEST(CompressedTimestampColumn, regular_ticks)
+{
+    std::vector<Instant> instants;
+    for (Datetime datetime : Datetime::range(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 16),
+                                             Seconds(1)))
+        instants.push_back(datetime.to_instant());
+
+    expect_round_trip(instants);
+    EXPECT_GT(CompressedTimestampColumn(instants).compression_ratio(), 40);
+}
+
+TEST(CompressedTimestampColumn, jittered_ticks)
+{
+    std::mt19937_64 rng(5);
+    std::exponential_distribution<double> gap(1e-6);
+    std::vector<Instant> instants;
+    int64_t nanoseconds = Datetime(2022, 1, 3, 9, 30).to_instant().nanoseconds;
+    for (size_t i = 0; i < 10'000; ++i)
+    {
+        nanoseconds += static_cast<int64_t>(gap(rng));
+        instants.push_back(Instant(nanoseconds));
+    }
+
+    expect_round_trip(instants);
+    EXPECT_GT(CompressedTimestampColumn(instants).compression_ratio(), 1.5);
+}
+
+TEST(CompressedTimestampColumn, every_payload_width)
+{
+    std::vector<Instant> instants = {Instant(0)};
+    for (int64_t step : {0L, 1L, -1L, 200L, -200L, 40'000L, -40'000L, 3'000'000'000L,
+                         -3'000'000'000L, 1L << 40, -(1L << 40)})
+    {
+        for (int i = 0; i < 3; ++i)
+            instants.push_back(instants.back() + TimeDelta::from_nanoseconds(step * (i + 1)));
+    }
+    instants.push_back(Instant(std::numeric_limits<int64_t>::max()));
+    instants.push_back(Instant(std::numeric_limits<int64_t>::min()));
+    instants.push_back(Instant(std::numeric_limits<int64_t>::max()));
+
+    expect_round_trip(instants);
+}
+
+TEST(CompressedTimestampColumn, random)
+{
+    std::mt19937_64 rng(9);
+    std::vector<Instant> instants;
+    for (size_t i = 0; i < 5'000; ++i)
+        instants.push_back(Instant(static_cast<int64_t>(rng())));
+
+    expect_round_trip(instants);
+}
+
+TEST(CompressedTimestampColumn, decode_block_invalid)
+{
+    std::vector<Instant> instants(CompressedTimestampColumn::BLOCK_SIZE + 1);
+    CompressedTimestampColumn column = CompressedTimestampColumn(instants);
+    EXPECT_EQ(column.block_count(), 2);
+
+    std::vector<Instant> small(1);
+    EXPECT_EQ(column.decode_block(1, small), 1);
+    EXPECT_THROW(column.decode_block(0, small), std::invalid_argument);
+    EXPECT_THROW(column.decode_block(2, small), std::invalid_argument);
+    EXPECT_THROW(column.decode(small), std::invalid_argument);
+}
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include <random>
+#include <ranges>
+#include <datetime/datetime.h>
+
+namespace
+{
+Datetime est(uint16_t year, uint8_t month, uint8_t day, uint8_t hour = 0, uint8_t minute = 0)
+{
+    return Datetime(year, month, day, hour, minute, 0, 0, 0, 0, TZ::EST);
+}
+}
+
+TEST(CronSchedule, constructor_invalid)
+{
+    std::vector<std::string_view> expressions = {"", "* * * *", "* * * * * *", "60 * * * *",
+                                                 "* 24 * * *", "* * 0 * *", "* * * 13 *",
+                                                 "* * * * 8", "*/0 * * * *", "5-1 * * * *",
+                                                 "a * * * *", "1,,2 * * * *", "* * * FOO *",
+                                                 "0 0 30 2 *", "0 0 31 4,6,9,11 *", "@never"};
+    for (std::string_view expression : expressions)
+        EXPECT_THROW(CronSchedule{expression}, std::invalid_argument) << expression;
+}
+
+TEST(CronSchedule, matches)
+{
+    CronSchedule weekdays = CronSchedule("30 9 * * MON-FRI");
+    EXPECT_TRUE(weekdays.matches(est(2022, 1, 3, 9, 30)));
+    EXPECT_TRUE(weekdays.matches(Datetime(2022, 1, 3, 9, 30, 59, 999, 0, 0, TZ::EST)));
+    EXPECT_FALSE(weekdays.matches(est(2022, 1, 3, 9, 31)));
+    EXPECT_FALSE(weekdays.matches(est(2022, 1, 8, 9, 30)));
+    EXPECT_TRUE(weekdays.matches(Datetime(2022, 1, 3, 14, 30, 0, 0, 0, 0, TZ::UTC).to_instant(),
+                                 TZ::EST));
+
+    CronSchedule steps = CronSchedule("5-20/5,45 */6 1,15 jan,Jul *");
+    EXPECT_TRUE(steps.matches(est(2022, 1, 15, 18, 10)));
+    EXPECT_TRUE(steps.matches(est(2022, 7, 1, 0, 45)));
+    EXPECT_TRUE(steps.matches(est(2022, 7, 1, 0, 20)));
+    EXPECT_FALSE(steps.matches(est(2022, 7, 1, 0, 25)));
+    EXPECT_FALSE(steps.matches(est(2022, 7, 1, 1, 5)));
+    EXPECT_FALSE(steps.matches(est(2022, 2, 1, 0, 5)));
+
+    // Either the day of month or the day of week matches when neither starts with '*'.
+    CronSchedule either = CronSchedule("0 12 13 * 5");
+    EXPECT_TRUE(either.matches(est(2022, 1, 7, 12)));
+    EXPECT_TRUE(either.matches(est(2022, 1, 13, 12)));
+    EXPECT_FALSE(either.matches(est(2022, 1, 12, 12)));
+
+    CronSchedule both = CronSchedule("0 12 */2 * 5");
+    EXPECT_TRUE(both.matches(est(2022, 1, 7, 12)));
+    EXPECT_FALSE(both.matches(est(2022, 1, 14, 12)));
+    EXPECT_FALSE(both.matches(est(2022, 1, 13, 12)));
+
+    CronSchedule sunday = CronSchedule("0 0 * * 7");
+    EXPECT_TRUE(sunday.matches(est(2022, 1, 9)));
+    EXPECT_TRUE(CronSchedule("0 0 * * 0").matches(est(2022, 1, 9)));
+}
+
+TEST(CronSchedule, next_after)
+{
+    CronSchedule quarterly = CronSchedule("0 0 1 */3 *");
+    EXPECT_EQ(quarterly.next_after(est(2022, 1, 3, 10), TZ::EST), est(2022, 4, 1));
+    EXPECT_EQ(quarterly.next_after(est(2022, 4, 1), TZ::EST), est(2022, 7, 1));
+    EXPECT_EQ(quarterly.next_after(est(2022, 10, 1, 0, 1), TZ::EST), est(2023, 1, 1));
+
+    CronSchedule open = CronSchedule("30 9 * * 1-5");
+    EXPECT_EQ(open.next_after(est(2022, 1, 7, 10), TZ::EST), est(2022, 1, 10, 9, 30));
+    EXPECT_EQ(open.next_after(est(2022, 1, 7, 9, 29), TZ::EST), est(2022, 1, 7, 9, 30));
+
+    CronSchedule every_15 = CronSchedule("*/15 * * * *");
+    EXPECT_EQ(every_15.next_after(est(2022, 1, 3, 10, 7), TZ::EST), est(2022, 1, 3, 10, 15));
+    EXPECT_EQ(every_15.next_after(est(2022, 1, 3, 10, 15), TZ::EST), est(2022, 1, 3, 10, 30));
+    EXPECT_EQ(every_15.next_after(Datetime(2022, 1, 3, 10, 14, 59, 999, 0, 0, TZ::EST), TZ::EST),
+              est(2022, 1, 3, 10, 15));
+    EXPECT_EQ(every_15.next_after(est(2022, 12, 31, 23, 50), TZ::EST), est(2023, 1, 1));
+
+    CronSchedule either = CronSchedule("0 12 13 * FRI");
+    EXPECT_EQ(either.next_after(est(2022, 1, 1), TZ::EST), est(2022, 1, 7, 12));
+    EXPECT_EQ(either.next_after(est(2022, 1, 7, 12), TZ::EST), est(2022, 1, 13, 12));
+    EXPECT_EQ(either.next_after(est(2022, 1, 13, 12), TZ::EST), est(2022, 1, 14, 12));
+
+    EXPECT_EQ(CronSchedule("0 0 29 2 *").next_after(est(2022, 3, 1), TZ::EST), est(2024, 2, 29));
+    EXPECT_EQ(CronSchedule("59 23 31 DEC *").next_after(est(2022, 12, 31, 23, 59), TZ::EST),
+              est(2023, 12, 31, 23, 59));
+    EXPECT_EQ(CronSchedule("@hourly").next_after(est(2022, 1, 3, 10, 7), TZ::EST),
+              est(2022, 1, 3, 11));
+    EXPECT_EQ(CronSchedule("@weekly").next_after(est(2022, 1, 3), TZ::EST), est(2022, 1, 9));
+}
+
+TEST(CronSchedule, next_after_timezone)
+{
+    CronSchedule schedule = CronSchedule("0 9 * * *");
+
+    // 12:00 UTC is 07:00 EST.
+    Datetime next = schedule.next_after(Datetime(2022, 1, 3, 12, 0, 0, 0, 0, 0, TZ::UTC),
+                                        TZ::EST);
+    EXPECT_EQ(next, est(2022, 1, 3, 9));
+    EXPECT_EQ(next.timezone, TZ::EST);
+
+    EXPECT_EQ(schedule.next_after(est(2022, 1, 3, 7), TZ::UTC),
+              Datetime(2022, 1, 4, 9, 0, 0, 0, 0, 0, TZ::UTC));
+}
+
+TEST(CronSchedule, next_after_matches_stepping)
+{
+    std::vector<std::string_view> expressions = {"*/7 * * * *", "0 */5 * * 1,3", "15 10 1-7 * MON",
+                                                 "0 0 1 */3 *", "0 0 29 2 *"};
+    std::mt19937_64 rng(3);
+    std::uniform_int_distribution<int64_t> offset(0, 3'000LL * Instant::NANOSECONDS_PER_DAY);
+    for (std::string_view expression : expressions)
+    {
+        CronSchedule schedule = CronSchedule(expression);
+        for (int i = 0; i < 20; ++i)
+        {
+            Instant start = Instant(est(2000, 1, 1).to_instant().nanoseconds + offset(rng));
+            Instant next = schedule.next_after(start, TZ::EST);
+            ASSERT_GT(next, start) << expression;
+            EXPECT_TRUE(schedule.matches(next, TZ::EST)) << expression << " " << next;
+            EXPECT_EQ(next.nanoseconds % 60'000'000'000, 0) << expression;
+
+            // No minute in between fires, checked for up to 10 days.
+            Instant minute = Instant(start.nanoseconds - start.nanoseconds % 60'000'000'000);
+            for (int step = 0; step < 14'400; ++step)
+            {
+                minute += TimeDelta(0, 0, 1);
+                if (minute >= next)
+                    break;
+                ASSERT_FALSE(schedule.matches(minute, TZ::EST)) << expression << " " << minute;
+            }
+        }
+    }
+}
+
+TEST(CronSchedule, fire_times)
+{
+    CronSchedule schedule = CronSchedule("0 0 1 */3 *");
+    std::vector<Datetime> fire_times;
+    for (Datetime fire_time : schedule.fire_times(est(2022, 1, 1), TZ::EST) | std::views::take(4))
+        fire_times.push_back(fire_time);
+
+    std::vector<Datetime> expected = {est(2022, 4, 1), est(2022, 7, 1), est(2022, 10, 1),
+                                      est(2023, 1, 1)};
+    EXPECT_EQ(fire_times, expected);
+}
@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <map>
+#include <random>
+
+namespace
+{
+// A function rather than a global, since 'Date' reads 'Date::EPOCH', which may not be
+// initialized before the globals of this file.
+DateRange year_2022()
+{
+    return DateRange(Date(2022, 1, 1), Date(2022, 12, 31));
+}
+
+template<typename Map>
+std::vector<std::pair<Date, int>> items(const Map& map)
+{
+    std::vector<std::pair<Date, int>> ret;
+    for (auto [date, value] : map)
+        ret.emplace_back(date, value);
+    return ret;
+}
+
+const std::vector<DateMapStorage> STORAGES = {DateMapStorage::DENSE, DateMapStorage::PAGED};
+}
+
+TEST(DateMap, insert_find_erase)
+{
+    for (DateMapStorage storage : STORAGES)
+    {
+        DateMap<int> map = DateMap<int>(year_2022(), storage);
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(map.find(Date(2022, 1, 3)), nullptr);
+
+        EXPECT_TRUE(map.insert_or_assign(Date(2022, 1, 3), 1));
+        EXPECT_FALSE(map.insert_or_assign(Date(2022, 1, 3), 2));
+        map[Date(2022, 12, 31)] += 5;
+        EXPECT_EQ(map.size(), 2);
+        EXPECT_EQ(*map.find(Date(2022, 1, 3)), 2);
+        EXPECT_EQ(map.at(Date(2022, 12, 31)), 5);
+        EXPECT_TRUE(map.contains(Date(2022, 12, 31)));
+        EXPECT_FALSE(map.contains(Date(2022, 1, 4)));
+        EXPECT_FALSE(map.contains(Date(2021, 12, 31)));
+        EXPECT_FALSE(map.contains(Date(2023, 1, 1)));
+        EXPECT_THROW(map.at(Date(2022, 1, 4)), std::invalid_argument);
+        EXPECT_THROW(map[Date(2023, 1, 1)], std::invalid_argument);
+
+        EXPECT_TRUE(map.erase(Date(2022, 1, 3)));
+        EXPECT_FALSE(map.erase(Date(2022, 1, 3)));
+        EXPECT_FALSE(map.erase(Date(1970, 1, 1)));
+        EXPECT_EQ(map.size(), 1);
+
+        // An erased day is default constructed when it is set again.
+        EXPECT_EQ(map[Date(2022, 1, 3)], 0);
+    }
+}
+
+TEST(DateMap, iterates_in_date_order)
+{
+    for (DateMapStorage storage : STORAGES)
+    {
+        DateMap<int> map = DateMap<int>(year_2022(), storage);
+        std::map<Date, int> expected;
+        std::mt19937_64 rng(94);
+        for (size_t i = 0; i < 100; ++i)
+        {
+            Date date = Date::from_days_since_epoch(Date(2022, 1, 1).days_since_epoch()
+                                                    + static_cast<int64_t>(rng() % 365));
+            map[date] = static_cast<int>(i);
+            expected[date] = static_cast<int>(i);
+        }
+
+        std::vector<std::pair<Date, int>> expected_items(expected.begin(), expected.end());
+        EXPECT_EQ(items(map), expected_items);
+        EXPECT_EQ(items(std::as_const(map)), expected_items);
+
+        for (auto [date, value] : map)
+            value *= 2;
+        EXPECT_EQ(map.at(expected.begin()->first), expected.begin()->second * 2);
+    }
+}
+
+TEST(DateMap, slice)
+{
+    for (DateMapStorage storage : STORAGES)
+    {
+        DateMap<int> map = DateMap<int>(year_2022(), storage);
+        map[Date(2022, 1, 1)] = 1;
+        map[Date(2022, 3, 1)] = 2;
+        map[Date(2022, 3, 31)] = 3;
+        map[Date(2022, 12, 31)] = 4;
+
+        std::vector<std::pair<Date, int>> march;
+        for (auto [date, value] : map.slice(DateRange(Date(2022, 3, 1), Date(2022, 3, 31))))
+            march.emplace_back(date, value);
+        EXPECT_EQ(march, (std::vector<std::pair<Date, int>>{{Date(2022, 3, 1), 2},
+                                                           {Date(2022, 3, 31), 3}}));
+
+        // Ranges past the map are clamped.
+        size_t count = 0;
+        for (auto item : std::as_const(map).slice(DateRange(Date(2021, 6, 1), Date(2023, 6, 1))))
+            count += item.second > 0;
+        EXPECT_EQ(count, 4);
+
+        auto after = map.slice(DateRange(Date(2023, 1, 1), Date(2023, 2, 1)));
+        EXPECT_TRUE(after.begin() == after.end());
+        auto before = map.slice(DateRange(Date(2021, 1, 1), Date(2021, 2, 1)));
+        EXPECT_TRUE(before.begin() == before.end());
+    }
+}
+
+TEST(DateMap, copy)
+{
+    for (DateMapStorage storage : STORAGES)
+    {
+        DateMap<int> map = DateMap<int>(year_2022(), storage);
+        map[Date(2022, 5, 5)] = 5;
+        DateMap<int> copy = map;
+        copy[Date(2022, 5, 5)] = 6;
+        copy[Date(2022, 5, 6)] = 7;
+
+        EXPECT_EQ(map.at(Date(2022, 5, 5)), 5);
+        EXPECT_EQ(map.size(), 1);
+        EXPECT_EQ(copy.size(), 2);
+
+        map = copy;
+        EXPECT_EQ(map.at(Date(2022, 5, 6)), 7);
+        EXPECT_EQ(map.range().start, Date(2022, 1, 1));
+        EXPECT_EQ(map.range().end, Date(2022, 12, 31));
+    }
+}
+
+TEST(DateMap, move)
+{
+    for (DateMapStorage storage : STORAGES)
+    {
+        DateMap<int> map = DateMap<int>(year_2022(), storage);
+        map[Date(2022, 5, 5)] = 5;
+        DateMap<int> moved = std::move(map);
+        EXPECT_EQ(moved.at(Date(2022, 5, 5)), 5);
+
+        // The moved-from map is empty and has no days.
+        EXPECT_TRUE(map.empty());
+        EXPECT_EQ(map.find(Date(2022, 5, 5)), nullptr);
+        EXPECT_FALSE(map.erase(Date(2022, 5, 5)));
+        EXPECT_THROW(map[Date(2022, 5, 5)], std::invalid_argument);
+        EXPECT_EQ(map.begin(), map.end());
+
+        map = std::move(moved);
+        EXPECT_EQ(map.at(Date(2022, 5, 5)), 5);
+        EXPECT_TRUE(moved.empty());
+        EXPECT_EQ(moved.find(Date(2022, 5, 5)), nullptr);
+    }
+}
+
+TEST(DateMap, flags)
+{
+    for (DateMapStorage storage : STORAGES)
+    {
+        DateMap<bool> holidays = DateMap<bool>(DateRange(Date(1970, 1, 1), Date(2100, 12, 31)),
+                                               storage);
+        holidays[Date(2022, 12, 25)] = true;
+        holidays[Date(2100, 12, 25)] = true;
+        EXPECT_TRUE(holidays.at(Date(2022, 12, 25)));
+        EXPECT_TRUE(holidays.contains(Date(2100, 12, 25)));
+        EXPECT_FALSE(holidays.contains(Date(2022, 12, 26)));
+    }
+}
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include <datetime/datetime.h>
+#include <unordered_set>
 
 TEST(Date, ostream)
 {
@@ -399,6 +400,14 @@ TEST(Date, tomorrow)
 TEST(Date, hash)
 {
     size_t hashed = std::hash<Date>{}(Date());
+    EXPECT_EQ(hashed, std::hash<Date>{}(Date(1970, 1, 1)));
+    EXPECT_NE(std::hash<Date>{}(Date(2022, 1, 3)), std::hash<Date>{}(Date(2022, 1, 4)));
+
+    std::unordered_set<Date> dates;
+    for (const Date& date : Date::range(Date(2022, 1, 1), Date(2022, 12, 31), Days(1)))
+        dates.insert(date);
+    EXPECT_EQ(dates.size(), 365);
+    EXPECT_TRUE(dates.contains(Date(2022, 6, 15)));
 }
 
 TEST(Date, range)
@@ -427,4 +436,30 @@ TEST(Date, to_string_delimeter)
     Date date = Date(2020, 1, 2);
     std::string date_str = date.to_string('/');
     EXPECT_EQ(date_str, "2020/01/02");
-}
\ No newline at end of file
+}
+
+TEST(Date, days_since_epoch)
+{
+    EXPECT_EQ(Date(1970, 1, 1).days_since_epoch(), 0);
+    EXPECT_EQ(Date(1970, 1, 11).days_since_epoch(), 10);
+    EXPECT_EQ(Date(2000, 3, 1).days_since_epoch(), 11017);
+    EXPECT_EQ(Date(2100, 12, 31).days_since_epoch(), 47846);
+}
+
+TEST(Date, from_days_since_epoch)
+{
+    EXPECT_EQ(Date::from_days_since_epoch(0), Date(1970, 1, 1));
+    EXPECT_EQ(Date::from_days_since_epoch(11016), Date(2000, 2, 29));
+    EXPECT_EQ(Date::from_days_since_epoch(47846), Date(2100, 12, 31));
+    EXPECT_THROW(Date::from_days_since_epoch(-1), std::invalid_argument);
+}
+
+TEST(Date, from_days_since_epoch_round_trip)
+{
+    Date date = Date(1970, 1, 1);
+    for (int64_t days = 0; days < 365 * 40; ++days, ++date)
+    {
+        EXPECT_EQ(date.days_since_epoch(), days);
+        EXPECT_EQ(Date::from_days_since_epoch(days), date);
+    }
+}
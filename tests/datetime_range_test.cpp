@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+
+namespace
+{
+std::vector<Instant> make_instants()
+{
+    std::vector<Instant> ret;
+    for (Datetime datetime : Datetime::range(Datetime(2022, 1, 3, 9), Datetime(2022, 1, 3, 17),
+                                             Minutes(1)))
+        ret.push_back(datetime.to_instant());
+    return ret;
+}
+}
+
+TEST(DatetimeRange, mask)
+{
+    DatetimeRange range = DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 16));
+    std::vector<Instant> instants = make_instants();
+    std::vector<uint8_t> out(instants.size());
+    range.mask(instants, out);
+
+    for (size_t i = 0; i < instants.size(); ++i)
+        EXPECT_EQ(out[i], range.in_range(Datetime::from_instant(instants[i]))) << i;
+}
+
+TEST(DatetimeRange, mask_other_timezone)
+{
+    DatetimeRange range = DatetimeRange(Datetime(2022, 1, 3, 14, 30, 0, 0, 0, 0, TZ::UTC),
+                                        Datetime(2022, 1, 3, 21, 0, 0, 0, 0, 0, TZ::UTC));
+    std::vector<Instant> instants = {Datetime(2022, 1, 3, 9, 29, 59, 999, 999, 999).to_instant(),
+                                     Datetime(2022, 1, 3, 9, 30).to_instant(),
+                                     Datetime(2022, 1, 3, 16).to_instant(),
+                                     Datetime(2022, 1, 3, 16, 0, 0, 0, 0, 1).to_instant()};
+    std::vector<uint8_t> out(instants.size());
+    range.mask(instants, out);
+    EXPECT_EQ(out, std::vector<uint8_t>({0, 1, 1, 0}));
+}
+
+TEST(DatetimeRange, mask_extreme_instants)
+{
+    DatetimeRange range = DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 16));
+    std::vector<Instant> instants = {Instant(std::numeric_limits<int64_t>::min()),
+                                     Instant(std::numeric_limits<int64_t>::max()),
+                                     Datetime(2022, 1, 3, 12).to_instant()};
+    std::vector<uint8_t> out(instants.size());
+    range.mask(instants, out);
+    EXPECT_EQ(out, std::vector<uint8_t>({0, 0, 1}));
+}
+
+TEST(DatetimeRange, mask_out_too_small)
+{
+    DatetimeRange range = DatetimeRange(Datetime(2022, 1, 3), Datetime(2022, 1, 4));
+    std::vector<Instant> instants = make_instants();
+    std::vector<uint8_t> out(instants.size() - 1);
+    EXPECT_THROW(range.mask(instants, out), std::invalid_argument);
+}
+
+TEST(DatetimeRange, mask_bits)
+{
+    DatetimeRange range = DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 16));
+    std::vector<Instant> instants = make_instants();
+    std::vector<uint64_t> out((instants.size() + 63) / 64);
+    range.mask_bits(instants, out);
+
+    for (size_t i = 0; i < instants.size(); ++i)
+        EXPECT_EQ(out[i / 64] >> (i % 64) & 1,
+                  range.in_range(Datetime::from_instant(instants[i]))) << i;
+}
+
+TEST(DatetimeRange, count_in_range)
+{
+    DatetimeRange range = DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 16));
+    std::vector<Instant> instants = make_instants();
+    EXPECT_EQ(range.count_in_range(instants), 391);
+    EXPECT_EQ(range.count_in_range({}), 0);
+}
+
+TEST(DatetimeRange, sorted_bounds)
+{
+    DatetimeRange range = DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 16));
+    std::vector<Instant> instants = make_instants();
+    EXPECT_EQ(range.sorted_bounds(instants), std::make_pair(size_t(30), size_t(421)));
+
+    DatetimeRange before = DatetimeRange(Datetime(2022, 1, 2), Datetime(2022, 1, 3));
+    EXPECT_EQ(before.sorted_bounds(instants), std::make_pair(size_t(0), size_t(0)));
+}
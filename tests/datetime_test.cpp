@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 
 #include <datetime/datetime.h>
+#include <unordered_map>
 
 
 TEST(Datetime, constructor_date_sets_members)
@@ -847,6 +848,21 @@ TEST(Datetime, operator_minus_datetime_datetime_year)
 TEST(Datetime, hash)
 {
     size_t hashed = std::hash<Date>{}(Date());
+
+    // Equal 'Datetimes' in different timezones have the same hash.
+    Datetime est = Datetime(2022, 1, 3, 22, 30, 0, 0, 0, 5, TZ::EST);
+    Datetime utc = Datetime(2022, 1, 4, 3, 30, 0, 0, 0, 5, TZ::UTC);
+    ASSERT_EQ(est, utc);
+    EXPECT_EQ(std::hash<Datetime>{}(est), std::hash<Datetime>{}(utc));
+    EXPECT_EQ(std::hash<Datetime>{}(est), std::hash<Instant>{}(est.to_instant()));
+    Datetime later = est + TimeDelta(0, 0, 0, 0, 0, 0, 1);
+    EXPECT_NE(std::hash<Datetime>{}(est), std::hash<Datetime>{}(later));
+
+    std::unordered_map<Datetime, int> counts;
+    counts[est]++;
+    counts[utc]++;
+    EXPECT_EQ(counts.size(), 1);
+    EXPECT_EQ(counts[Datetime(2022, 1, 3, 22, 30, 0, 0, 0, 5, TZ::EST)], 2);
 }
 
 TEST(Datetime, increment_days)
@@ -1124,4 +1140,39 @@ TEST(Datetime, floor)
     datetime = Datetime(2000, 1, 1, 1, 1, 1, 1, 1, 499);
     datetime.floor(TimeComponent::NANOSECOND);
     EXPECT_EQ(datetime, Datetime(2000, 1, 1, 1, 1, 1, 1, 1, 499));
-}
\ No newline at end of file
+}
+
+TEST(Datetime, to_instant)
+{
+    EXPECT_EQ(Datetime(1970, 1, 1, 0, 0, 0, 0, 0, 0, TZ::UTC).to_instant(), Instant(0));
+    EXPECT_EQ(Datetime(1970, 1, 1, 0, 0, 0, 0, 0, 1, TZ::EST).to_instant(),
+              Instant(5 * 3'600'000'000'000 + 1));
+    EXPECT_EQ(Datetime(2022, 1, 1, 6, 0, 0, 0, 0, 0, TZ::UTC).to_instant(),
+              Datetime(2022, 1, 1, 1, 0, 0, 0, 0, 0, TZ::EST).to_instant());
+    EXPECT_EQ(Datetime(2022, 1, 1, 1, 2, 3, 4, 5, 6, TZ::UTC).to_instant().nanoseconds / 1'000'000,
+              Datetime(2022, 1, 1, 1, 2, 3, 4, 5, 6, TZ::UTC).to_ms());
+}
+
+TEST(Datetime, from_instant)
+{
+    Datetime datetime = Datetime::from_instant(Instant(1'641'016'800'123'456'789), TZ::EST);
+    EXPECT_EQ(datetime.year, 2022);
+    EXPECT_EQ(datetime.month, 1);
+    EXPECT_EQ(datetime.day, 1);
+    EXPECT_EQ(datetime.hour, 1);
+    EXPECT_EQ(datetime.minute, 0);
+    EXPECT_EQ(datetime.second, 0);
+    EXPECT_EQ(datetime.millisecond, 123);
+    EXPECT_EQ(datetime.microsecond, 456);
+    EXPECT_EQ(datetime.nanosecond, 789);
+    EXPECT_EQ(datetime.timezone, TZ::EST);
+}
+
+TEST(Datetime, from_instant_round_trip)
+{
+    Datetime datetime = Datetime(2024, 2, 28, 23, 59, 59, 999, 999, 999, TZ::CST);
+    EXPECT_EQ(Datetime::from_instant(datetime.to_instant(), TZ::CST), datetime);
+    EXPECT_EQ(Datetime::from_instant(datetime.to_instant() + TimeDelta(0, 0, 0, 0, 0, 0, 1),
+                                     TZ::CST),
+              Datetime(2024, 2, 29, 0, 0, 0, 0, 0, 0, TZ::CST));
+}
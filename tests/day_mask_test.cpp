@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+
+namespace
+{
+std::vector<TimeRange> trading_windows()
+{
+    return {TimeRange(Time(9, 30, 0, 0, 0, 0, TZ::EST), Time(11, 0, 0, 0, 0, 0, TZ::EST)),
+            TimeRange(Time(14, 0, 0, 0, 0, 0, TZ::EST), Time(15, 59, 0, 0, 0, 0, TZ::EST))};
+}
+
+Instant est_instant(int day, uint8_t hour, uint8_t minute, uint8_t second = 0)
+{
+    return Datetime(2022, 1, day, hour, minute, second, 0, 0, 0, TZ::EST).to_instant();
+}
+}
+
+TEST(DayMask, constructor_invalid_resolution)
+{
+    std::vector<TimeRange> ranges = trading_windows();
+    EXPECT_THROW(DayMask(ranges, TZ::EST, TimeDelta()), std::invalid_argument);
+    EXPECT_THROW(DayMask(ranges, TZ::EST, TimeDelta(0, 0, 0, 7)), std::invalid_argument);
+}
+
+TEST(DayMask, contains_matches_time_ranges)
+{
+    std::vector<TimeRange> ranges = trading_windows();
+    DayMask mask = DayMask(ranges, TZ::EST);
+    for (int minute = 0; minute < 24 * 60; ++minute)
+    {
+        Time time = Time(minute / 60, minute % 60, 0, 0, 0, 0, TZ::EST);
+        bool expected = ranges[0].in_range(time) || ranges[1].in_range(time);
+        EXPECT_EQ(mask.contains(time), expected) << time;
+    }
+}
+
+TEST(DayMask, contains_rounds_to_resolution)
+{
+    std::vector<TimeRange> ranges = trading_windows();
+    DayMask minutes = DayMask(ranges, TZ::EST);
+    DayMask seconds = DayMask(ranges, TZ::EST, TimeDelta(0, 0, 0, 1));
+
+    // The first range ends at 11:00, so the whole slot of 11:00 is in the mask.
+    EXPECT_TRUE(minutes.contains(Time(11, 0, 30, 0, 0, 0, TZ::EST)));
+    EXPECT_FALSE(seconds.contains(Time(11, 0, 30, 0, 0, 0, TZ::EST)));
+    EXPECT_TRUE(seconds.contains(Time(11, 0, 0, 500, 0, 0, TZ::EST)));
+    EXPECT_FALSE(seconds.contains(Time(9, 29, 59, 999, 0, 0, TZ::EST)));
+}
+
+TEST(DayMask, contains_timezones)
+{
+    DayMask mask = DayMask(trading_windows(), TZ::EST);
+    EXPECT_TRUE(mask.contains(Time(14, 30, 0, 0, 0, 0, TZ::UTC)));
+    EXPECT_FALSE(mask.contains(Time(9, 30, 0, 0, 0, 0, TZ::UTC)));
+    EXPECT_TRUE(mask.contains(est_instant(3, 9, 30)));
+    EXPECT_FALSE(mask.contains(est_instant(3, 12, 0)));
+    EXPECT_TRUE(mask.contains(Datetime(2022, 1, 3, 19, 0, 0, 0, 0, 0, TZ::UTC).to_instant()));
+}
+
+TEST(DayMask, contains_wraps_midnight)
+{
+    // 18:00 to 20:00 EST is 23:00 to 01:00 UTC.
+    std::vector<TimeRange> ranges = {TimeRange(Time(18, 0, 0, 0, 0, 0, TZ::EST),
+                                               Time(20, 0, 0, 0, 0, 0, TZ::EST))};
+    DayMask mask = DayMask(ranges, TZ::UTC);
+    EXPECT_TRUE(mask.contains(Time(23, 30, 0, 0, 0, 0, TZ::UTC)));
+    EXPECT_TRUE(mask.contains(Time(19, 30, 0, 0, 0, 0, TZ::EST)));
+    EXPECT_FALSE(mask.contains(Time(1, 1, 0, 0, 0, 0, TZ::UTC)));
+    EXPECT_FALSE(mask.contains(Time(22, 59, 0, 0, 0, 0, TZ::UTC)));
+}
+
+TEST(DayMask, next_set_time)
+{
+    DayMask mask = DayMask(trading_windows(), TZ::EST);
+
+    EXPECT_EQ(mask.next_set(Time(8, 0, 0, 0, 0, 0, TZ::EST)), Time(9, 30, 0, 0, 0, 0, TZ::EST));
+    EXPECT_EQ(mask.next_set(Time(10, 15, 20, 0, 0, 0, TZ::EST)),
+              Time(10, 15, 20, 0, 0, 0, TZ::EST));
+    EXPECT_EQ(mask.next_set(Time(11, 1, 0, 0, 0, 0, TZ::EST)), Time(14, 0, 0, 0, 0, 0, TZ::EST));
+    EXPECT_EQ(mask.next_set(Time(16, 0, 0, 0, 0, 0, TZ::EST)), std::nullopt);
+
+    std::optional<Time> next = mask.next_set(Time(12, 0, 0, 0, 0, 0, TZ::UTC));
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->timezone, TZ::EST);
+    EXPECT_EQ(next->hour, 9);
+    EXPECT_EQ(next->minute, 30);
+}
+
+TEST(DayMask, next_set_instant)
+{
+    DayMask mask = DayMask(trading_windows(), TZ::EST);
+
+    EXPECT_EQ(mask.next_set(est_instant(3, 8, 0)), est_instant(3, 9, 30));
+    EXPECT_EQ(mask.next_set(est_instant(3, 10, 15, 20)), est_instant(3, 10, 15, 20));
+    EXPECT_EQ(mask.next_set(est_instant(3, 12, 0)), est_instant(3, 14, 0));
+    EXPECT_EQ(mask.next_set(est_instant(3, 17, 0)), est_instant(4, 9, 30));
+
+    std::vector<TimeRange> none;
+    DayMask empty = DayMask(none, TZ::EST);
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(mask.empty());
+    EXPECT_EQ(empty.next_set(est_instant(3, 8, 0)), std::nullopt);
+}
+
+TEST(DayMask, mask)
+{
+    DayMask day_mask = DayMask(trading_windows(), TZ::EST, TimeDelta(0, 0, 0, 1));
+
+    std::vector<Instant> instants;
+    for (int i = 0; i < 200; ++i)
+        instants.push_back(Instant(est_instant(3, 0, 0).nanoseconds
+                                   + i * 7 * Instant::NANOSECONDS_PER_HOUR / 31));
+
+    std::vector<uint8_t> out(instants.size());
+    day_mask.mask(instants, out);
+    std::vector<uint64_t> bits((instants.size() + 63) / 64);
+    day_mask.mask_bits(instants, bits);
+    for (size_t i = 0; i < instants.size(); ++i)
+    {
+        EXPECT_EQ(out[i], day_mask.contains(instants[i])) << i;
+        EXPECT_EQ(bits[i / 64] >> (i % 64) & 1, day_mask.contains(instants[i])) << i;
+    }
+
+    std::vector<uint8_t> small(instants.size() - 1);
+    EXPECT_THROW(day_mask.mask(instants, small), std::invalid_argument);
+    std::vector<uint64_t> small_bits(bits.size() - 1);
+    EXPECT_THROW(day_mask.mask_bits(instants, small_bits), std::invalid_argument);
+}
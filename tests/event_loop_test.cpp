@@ -0,0 +1,196 @@
+#include "gtest/gtest.h"
+#include <chrono>
+#include <memory>
+#include <datetime/datetime.h>
+
+namespace
+{
+// 2022-01-03 09:00 EST.
+const Instant START = Instant(1'641'218'400'000'000'000);
+
+using Wakeups = std::vector<std::pair<int, Instant>>;
+
+EventLoop::Task sleeper(EventLoop& loop, int id, TimeDelta delay, Wakeups& wakeups)
+{
+    co_await loop.after(delay);
+    wakeups.emplace_back(id, Instant::monotonic_now());
+}
+
+EventLoop::Task heartbeat(EventLoop& loop, TimeDelta interval, int& beats)
+{
+    while (true)
+    {
+        co_await loop.after(interval);
+        beats++;
+    }
+}
+
+/**
+ * Sets 'Instant::mock_instant' to 'START' for the duration of a test.
+ */
+class SimulatedClock
+{
+public:
+    SimulatedClock()
+    {
+        Instant::mock_instant = START;
+    }
+
+    ~SimulatedClock()
+    {
+        Instant::mock_instant.reset();
+    }
+};
+}
+
+TEST(EventLoop, after)
+{
+    SimulatedClock clock;
+    EventLoop loop = EventLoop();
+    Wakeups wakeups;
+    sleeper(loop, 1, TimeDelta(0, 1), wakeups);
+    sleeper(loop, 2, TimeDelta(0, 0, 0, 0, 5), wakeups);
+    sleeper(loop, 3, TimeDelta(30), wakeups);
+    EXPECT_EQ(loop.pending(), 3);
+
+    loop.run();
+    Wakeups expected = {{2, START + TimeDelta(0, 0, 0, 0, 5)}, {1, START + TimeDelta(0, 1)},
+                        {3, START + TimeDelta(30)}};
+    EXPECT_EQ(wakeups, expected);
+    EXPECT_EQ(loop.pending(), 0);
+}
+
+TEST(EventLoop, at)
+{
+    SimulatedClock clock;
+    EventLoop loop = EventLoop();
+    std::vector<Instant> wakeups;
+    auto task = [&]() -> EventLoop::Task
+    {
+        co_await loop.at(Datetime(2022, 1, 3, 16, 0, 0, 0, 0, 0, TZ::EST));
+        wakeups.push_back(Instant::now());
+        co_await loop.at(START + TimeDelta(0, 7, 0, 0, 0, 1));
+        wakeups.push_back(Instant::now());
+
+        // Deadlines that have been reached do not suspend.
+        co_await loop.at(START);
+        wakeups.push_back(Instant::now());
+    };
+    task();
+    loop.run();
+
+    Instant close = Datetime(2022, 1, 3, 16, 0, 0, 0, 0, 0, TZ::EST).to_instant();
+    std::vector<Instant> expected = {close, close + TimeDelta(0, 0, 0, 0, 1),
+                                     close + TimeDelta(0, 0, 0, 0, 1)};
+    EXPECT_EQ(wakeups, expected);
+}
+
+TEST(EventLoop, next_session_open)
+{
+    SimulatedClock clock;
+    Instant::mock_instant = Datetime(2022, 1, 8, 12, 0, 0, 0, 0, 0, TZ::EST).to_instant();
+    RecurringWindow regular_hours = RecurringWindow(TimeRange(Time(9, 30, 0, 0, 0, 0, TZ::EST),
+                                                              Time(16, 0, 0, 0, 0, 0, TZ::EST)),
+                                                    TZ::EST,
+                                                    RecurringWindow::WEEKDAYS);
+    EventLoop loop = EventLoop();
+    std::vector<Instant> opens;
+    auto task = [&]() -> EventLoop::Task
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            co_await loop.next_session_open(regular_hours);
+            opens.push_back(Instant::now());
+            co_await loop.after(TimeDelta(0, 1));
+        }
+    };
+    task();
+    loop.run();
+
+    std::vector<Instant> expected = {
+        Datetime(2022, 1, 10, 9, 30, 0, 0, 0, 0, TZ::EST).to_instant(),
+        Datetime(2022, 1, 11, 9, 30, 0, 0, 0, 0, TZ::EST).to_instant()};
+    EXPECT_EQ(opens, expected);
+}
+
+TEST(EventLoop, run_until)
+{
+    SimulatedClock clock;
+    int beats = 0;
+    {
+        EventLoop loop = EventLoop();
+        heartbeat(loop, TimeDelta(0, 0, 0, 30), beats);
+        loop.run_until(START + TimeDelta(0, 0, 5));
+        EXPECT_EQ(beats, 10);
+        EXPECT_EQ(Instant::now(), START + TimeDelta(0, 0, 5));
+        EXPECT_EQ(loop.pending(), 1);
+
+        loop.run_until(START + TimeDelta(0, 0, 5, 59));
+        EXPECT_EQ(beats, 11);
+
+        // The waiting heartbeat is destroyed with the loop.
+    }
+    EXPECT_EQ(beats, 11);
+}
+
+TEST(EventLoop, exception)
+{
+    SimulatedClock clock;
+    EventLoop loop = EventLoop();
+    auto task = [&]() -> EventLoop::Task
+    {
+        co_await loop.after(TimeDelta(0, 0, 0, 1));
+        throw std::runtime_error("failed");
+    };
+    task();
+    EXPECT_THROW(loop.run(), std::runtime_error);
+}
+
+TEST(EventLoop, exception_before_first_await)
+{
+    SimulatedClock clock;
+    EventLoop loop = EventLoop();
+    int destroyed = 0;
+    auto task = [&]() -> EventLoop::Task
+    {
+        // Counts the destruction of the frame of the task.
+        std::shared_ptr<int> frame(nullptr, [&destroyed](int*) { destroyed++; });
+        throw std::runtime_error("failed");
+        co_await loop.after(TimeDelta(0, 0, 0, 1));
+    };
+    EXPECT_NO_THROW(task());
+    EXPECT_EQ(destroyed, 1);
+    EXPECT_THROW(loop.run(), std::runtime_error);
+    EXPECT_NO_THROW(loop.run());
+}
+
+TEST(EventLoop, date_time_mock)
+{
+    Date::mock_date = Date(2022, 1, 3);
+    Time::mock_time = Time(9, 0, 0, 0, 0, 0, TZ::EST);
+    EventLoop loop = EventLoop();
+    Wakeups wakeups;
+    sleeper(loop, 1, TimeDelta(0, 1), wakeups);
+    loop.run();
+
+    Wakeups expected = {{1, START + TimeDelta(0, 1)}};
+    EXPECT_EQ(wakeups, expected);
+    Instant::mock_instant.reset();
+    Date::mock_date.reset();
+    Time::mock_time.reset();
+}
+
+TEST(EventLoop, monotonic_clock)
+{
+    EventLoop loop = EventLoop();
+    Wakeups wakeups;
+    Instant start = Instant::monotonic_now();
+    sleeper(loop, 1, TimeDelta(0, 0, 0, 0, 3), wakeups);
+    sleeper(loop, 2, TimeDelta(0, 0, 0, 0, 2), wakeups);
+    loop.run();
+
+    ASSERT_EQ(wakeups.size(), 2);
+    EXPECT_EQ(wakeups[0].first, 2);
+    EXPECT_GE(wakeups[0].second, start + TimeDelta(0, 0, 0, 0, 2));
+    EXPECT_GE(wakeups[1].second, start + TimeDelta(0, 0, 0, 0, 3));
+}
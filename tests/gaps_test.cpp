@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include "test_helpers.h"
+
+TEST(Gaps, diff)
+{
+    EXPECT_EQ(diff(instants({5, 7, 7, 3, 10})), std::vector<int64_t>({2, 0, -4, 7}));
+    EXPECT_TRUE(diff(instants({5})).empty());
+    EXPECT_TRUE(diff(instants({})).empty());
+
+    std::vector<int64_t> too_small(1);
+    EXPECT_THROW(diff(instants({1, 2, 3}), too_small), std::invalid_argument);
+}
+
+TEST(Gaps, diff_datetimes)
+{
+    std::vector<Instant> column = {Datetime(2022, 1, 1, 23, 59).to_instant(),
+                                   Datetime(2022, 1, 2, 0, 1).to_instant(),
+                                   Datetime(2022, 1, 2, 0, 1, 0, 0, 0, 5).to_instant()};
+    EXPECT_EQ(diff(column), std::vector<int64_t>({120'000'000'000, 5}));
+}
+
+TEST(Gaps, find_gaps)
+{
+    auto column = instants({0, 1, 2, 10, 11, 11, 30, 25, 26});
+    EXPECT_EQ(find_gaps(column, TimeDelta::from_nanoseconds(5)),
+              std::vector<Gap>({{Instant(2), Instant(10), 3}, {Instant(11), Instant(30), 6}}));
+    EXPECT_EQ(find_gaps(column, TimeDelta::from_nanoseconds(19)), std::vector<Gap>());
+    EXPECT_EQ(find_gaps(column, TimeDelta::from_nanoseconds(5))[1].duration(),
+              TimeDelta::from_nanoseconds(19));
+    EXPECT_THROW(find_gaps(column, TimeDelta::from_nanoseconds(-1)), std::invalid_argument);
+}
+
+TEST(Gaps, find_gaps_across_blocks)
+{
+    std::vector<Instant> column;
+    std::vector<Gap> expected;
+    int64_t nanoseconds = 0;
+    for (size_t i = 0; i < 2'000; ++i)
+    {
+        int64_t step = i % 257 == 0 || i == 256 || i == 257 ? 100 : 1;
+        if (i > 0 && step > 10)
+            expected.push_back({Instant(nanoseconds), Instant(nanoseconds + step), i});
+        nanoseconds += step;
+        column.push_back(Instant(nanoseconds));
+    }
+    EXPECT_EQ(find_gaps(column, TimeDelta::from_nanoseconds(10)), expected);
+}
+
+TEST(GapDetector, push)
+{
+    GapDetector detector = GapDetector(TimeDelta::from_nanoseconds(5));
+    EXPECT_EQ(detector.push(Instant(100)), std::nullopt);
+    EXPECT_EQ(detector.push(Instant(105)), std::nullopt);
+    EXPECT_EQ(detector.push(Instant(111)), Gap({Instant(105), Instant(111), 2}));
+    EXPECT_EQ(detector.size(), 3);
+    EXPECT_THROW(GapDetector(TimeDelta::from_nanoseconds(-1)), std::invalid_argument);
+}
+
+TEST(GapDetector, push_batches_match_find_gaps)
+{
+    auto column = instants({0, 1, 20, 21, 22, 40, 41, 60, 80, 81});
+    std::vector<Gap> expected = find_gaps(column, TimeDelta::from_nanoseconds(5));
+
+    GapDetector detector = GapDetector(TimeDelta::from_nanoseconds(5));
+    std::vector<Gap> gaps;
+    std::span<const Instant> all = column;
+    detector.push(all.subspan(0, 2), gaps);
+    detector.push(all.subspan(2, 0), gaps);
+    detector.push(all.subspan(2, 5), gaps);
+    detector.push(all.subspan(7), gaps);
+
+    EXPECT_EQ(gaps, expected);
+    EXPECT_EQ(detector.size(), column.size());
+}
@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <limits>
+#include <random>
+
+namespace
+{
+// A function rather than a global, since 'Datetime' reads 'Date::EPOCH' and
+// 'Time::default_timezone', which may not be initialized before the globals of this file.
+Datetime start()
+{
+    return Datetime(2022, 1, 3, 9, 30);
+}
+
+Instant at(int64_t seconds)
+{
+    return Instant(start().to_instant().nanoseconds + seconds * 1'000'000'000);
+}
+}
+
+TEST(Histogram, counts)
+{
+    std::vector<Instant> instants = {at(-1), at(0), at(0), at(59), at(60), at(150), at(180),
+                                     at(181), at(30)};
+    DatetimeRange domain = DatetimeRange(start(), Datetime(2022, 1, 3, 9, 33));
+
+    // The end of the domain is counted in the last bucket.
+    EXPECT_EQ(histogram(instants, TimeDelta(0, 0, 1), domain),
+              std::vector<uint64_t>({4, 1, 2}));
+    EXPECT_EQ(histogram(instants, TimeDelta(0, 0, 2), domain), std::vector<uint64_t>({5, 2}));
+}
+
+TEST(Histogram, empty_domain)
+{
+    std::vector<Instant> instants = {at(0), at(1)};
+    EXPECT_EQ(histogram(instants, TimeDelta(0, 0, 1), DatetimeRange(start(), start())),
+              std::vector<uint64_t>({1}));
+}
+
+TEST(Histogram, weights)
+{
+    std::vector<Instant> instants = {at(1), at(70), at(2), at(200)};
+    std::vector<double> weights = {1.5, 2, 3, 4};
+    DatetimeRange domain = DatetimeRange(start(), Datetime(2022, 1, 3, 9, 32));
+    EXPECT_EQ(histogram(instants, weights, TimeDelta(0, 0, 1), domain),
+              std::vector<double>({4.5, 2}));
+
+    std::vector<double> too_few = {1};
+    EXPECT_THROW(histogram(instants, too_few, TimeDelta(0, 0, 1), domain),
+                 std::invalid_argument);
+}
+
+TEST(Histogram, extreme_instants)
+{
+    std::vector<Instant> instants = {Instant(std::numeric_limits<int64_t>::min()), at(0),
+                                     Instant(std::numeric_limits<int64_t>::max())};
+    DatetimeRange domain = DatetimeRange(start(), Datetime(2022, 1, 3, 9, 32));
+    EXPECT_EQ(histogram(instants, TimeDelta(0, 0, 1), domain), std::vector<uint64_t>({1, 0}));
+}
+
+TEST(Histogram, invalid)
+{
+    std::vector<Instant> instants = {at(0)};
+    DatetimeRange domain = DatetimeRange(start(), Datetime(2022, 1, 3, 9, 32));
+    EXPECT_THROW(histogram(instants, TimeDelta(), domain), std::invalid_argument);
+    EXPECT_THROW(histogram(instants, TimeDelta(0, 0, 1), domain, 0), std::invalid_argument);
+}
+
+TEST(Histogram, parallel_matches_serial)
+{
+    std::mt19937_64 rng(90);
+    std::vector<Instant> instants;
+    std::vector<double> weights;
+    for (size_t i = 0; i < 300'000; ++i)
+    {
+        instants.push_back(at(static_cast<int64_t>(rng() % 4'000) - 100));
+        weights.push_back(static_cast<double>(rng() % 10));
+    }
+    std::sort(instants.begin(), instants.begin() + 100'000);
+
+    DatetimeRange domain = DatetimeRange(start(), Datetime(2022, 1, 3, 10, 30));
+    std::vector<uint64_t> expected(60);
+    std::vector<double> expected_weights(60);
+    for (size_t i = 0; i < instants.size(); ++i)
+    {
+        int64_t seconds = (instants[i].nanoseconds - at(0).nanoseconds) / 1'000'000'000;
+        if (seconds >= 0 && seconds <= 3'600)
+        {
+            auto bucket = static_cast<size_t>(std::min<int64_t>(seconds / 60, 59));
+            expected[bucket]++;
+            expected_weights[bucket] += weights[i];
+        }
+    }
+
+    for (unsigned thread_count : {1, 3})
+    {
+        EXPECT_EQ(histogram(instants, TimeDelta(0, 0, 1), domain, thread_count), expected);
+        EXPECT_EQ(histogram(instants, weights, TimeDelta(0, 0, 1), domain, thread_count),
+                  expected_weights);
+    }
+}
@@ -0,0 +1,208 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <random>
+
+namespace
+{
+std::vector<DatetimeRange> make_ranges()
+{
+    return {
+        DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 16)),
+        DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 9, 35)),
+        DatetimeRange(Datetime(2022, 1, 3, 12), Datetime(2022, 1, 3, 12, 5)),
+        DatetimeRange(Datetime(2022, 1, 3, 15, 50), Datetime(2022, 1, 4, 9, 30)),
+        DatetimeRange(Datetime(2022, 1, 3, 15, 0, 0, 0, 0, 0, TZ::UTC),
+                      Datetime(2022, 1, 3, 15, 0, 0, 0, 0, 0, TZ::UTC)),
+    };
+}
+
+std::vector<size_t> sorted(std::span<const size_t> ids)
+{
+    std::vector<size_t> ret(ids.begin(), ids.end());
+    std::sort(ret.begin(), ret.end());
+    return ret;
+}
+}
+
+TEST(IntervalIndex, containing)
+{
+    IntervalIndex<Datetime> index = IntervalIndex<Datetime>(make_ranges());
+    EXPECT_EQ(index.size(), 5);
+
+    EXPECT_EQ(index.containing(Datetime(2022, 1, 3, 9, 29)), std::vector<size_t>());
+    EXPECT_EQ(index.containing(Datetime(2022, 1, 3, 9, 30)), std::vector<size_t>({0, 1}));
+    EXPECT_EQ(index.containing(Datetime(2022, 1, 3, 9, 35)), std::vector<size_t>({0, 1}));
+    EXPECT_EQ(index.containing(Datetime(2022, 1, 3, 9, 35, 0, 0, 0, 1)),
+              std::vector<size_t>({0}));
+    EXPECT_EQ(index.containing(Datetime(2022, 1, 3, 10)), std::vector<size_t>({0, 4}));
+    EXPECT_EQ(index.containing(Datetime(2022, 1, 3, 16)), std::vector<size_t>({0, 3}));
+    EXPECT_EQ(index.containing(Datetime(2022, 1, 4, 9, 30)), std::vector<size_t>({3}));
+}
+
+TEST(IntervalIndex, containing_instant)
+{
+    IntervalIndex<Datetime> index = IntervalIndex<Datetime>(make_ranges());
+    Instant instant = Datetime(2022, 1, 3, 12, 1).to_instant();
+    EXPECT_EQ(index.containing(instant), std::vector<size_t>({0, 2}));
+}
+
+TEST(IntervalIndex, overlapping)
+{
+    IntervalIndex<Datetime> index = IntervalIndex<Datetime>(make_ranges());
+    EXPECT_EQ(index.overlapping(Datetime(2022, 1, 3, 9, 36), Datetime(2022, 1, 3, 11, 59)),
+              std::vector<size_t>({0, 4}));
+    EXPECT_EQ(index.overlapping(DatetimeRange(Datetime(2022, 1, 4), Datetime(2022, 1, 5))),
+              std::vector<size_t>({3}));
+    EXPECT_EQ(index.overlapping(Datetime(2022, 1, 5), Datetime(2022, 1, 6)),
+              std::vector<size_t>());
+    EXPECT_THROW(index.overlapping(Datetime(2022, 1, 6), Datetime(2022, 1, 5)),
+                 std::invalid_argument);
+}
+
+TEST(IntervalIndex, empty)
+{
+    IntervalIndex<Datetime> index = IntervalIndex<Datetime>(std::vector<DatetimeRange>());
+    EXPECT_EQ(index.containing(Datetime(2022, 1, 3)), std::vector<size_t>());
+    EXPECT_EQ(index.containing_sorted(std::vector<Instant>({Instant(1)})).size(), 1);
+}
+
+TEST(IntervalIndex, date)
+{
+    std::vector<DateRange> ranges = {DateRange(Date(2022, 1, 1), Date(2022, 1, 31)),
+                                     DateRange(Date(2022, 1, 31), Date(2022, 2, 1))};
+    IntervalIndex<Date> index = IntervalIndex<Date>(ranges);
+    EXPECT_EQ(index.containing(Date(2022, 1, 31)), std::vector<size_t>({0, 1}));
+    EXPECT_EQ(index.containing(Date(2022, 2, 2)), std::vector<size_t>());
+}
+
+TEST(IntervalIndex, containing_sorted)
+{
+    IntervalIndex<Datetime> index = IntervalIndex<Datetime>(make_ranges());
+    std::vector<Instant> points;
+    for (Datetime datetime : Datetime::range(Datetime(2022, 1, 3, 9), Datetime(2022, 1, 4, 10),
+                                             Minutes(5)))
+        points.push_back(datetime.to_instant());
+
+    IntervalMatches matches = index.containing_sorted(points);
+    ASSERT_EQ(matches.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i)
+        EXPECT_EQ(sorted(matches[i]), index.containing(points[i]));
+
+    std::vector<Instant> unsorted = {Instant(2), Instant(1)};
+    EXPECT_THROW(index.containing_sorted(unsorted), std::invalid_argument);
+}
+
+TEST(IntervalIndex, overlapping_wrapped)
+{
+    // 23:30 to 01:00 in UTC.
+    Time start = Time(18, 30, 0, 0, 0, 0, TZ::EST);
+    Time end = Time(20, 0, 0, 0, 0, 0, TZ::EST);
+    std::vector<TimeRange> ranges = {
+        TimeRange(Time(17, 0, 0, 0, 0, 0, TZ::EST), Time(18, 0, 0, 0, 0, 0, TZ::EST)),
+        TimeRange(Time(18, 45, 0, 0, 0, 0, TZ::EST), Time(19, 15, 0, 0, 0, 0, TZ::EST)),
+        TimeRange(Time(19, 30, 0, 0, 0, 0, TZ::EST), Time(21, 0, 0, 0, 0, 0, TZ::EST)),
+        TimeRange(Time(12, 0, 0, 0, 0, 0, TZ::EST), Time(23, 0, 0, 0, 0, 0, TZ::EST)),
+    };
+    IntervalIndex<Time> index = IntervalIndex<Time>(ranges);
+
+    // Ordered by where they overlap from the start of the query, each reported once.
+    EXPECT_EQ(index.overlapping(start, end), std::vector<size_t>({3, 1, 2}));
+    EXPECT_EQ(index.overlapping(TimeRange(start, end)), std::vector<size_t>({3, 1, 2}));
+    EXPECT_EQ(index.overlapping(Time(18, 10, 0, 0, 0, 0, TZ::EST),
+                                Time(18, 20, 0, 0, 0, 0, TZ::EST)),
+              std::vector<size_t>({3}));
+}
+
+TEST(IntervalIndex, matches_brute_force)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> start_dist(0, 1'000'000);
+    std::uniform_int_distribution<int64_t> length_dist(0, 20'000);
+
+    std::vector<Range<Instant>> ranges;
+    for (int i = 0; i < 1000; ++i)
+    {
+        Instant start = Instant(start_dist(rng));
+        ranges.emplace_back(start, Instant(start.nanoseconds + length_dist(rng)));
+    }
+    IntervalIndex<Instant> index = IntervalIndex<Instant>(ranges);
+
+    std::vector<Instant> points;
+    for (int i = 0; i < 500; ++i)
+        points.push_back(Instant(start_dist(rng)));
+    std::sort(points.begin(), points.end());
+    IntervalMatches matches = index.containing_sorted(points);
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        std::vector<size_t> expected;
+        for (size_t id = 0; id < ranges.size(); ++id)
+        {
+            if (ranges[id].in_range(points[i]))
+                expected.push_back(id);
+        }
+        EXPECT_EQ(sorted(index.containing(points[i])), expected);
+        EXPECT_EQ(sorted(matches[i]), expected);
+
+        Instant end = Instant(points[i].nanoseconds + 5'000);
+        std::vector<size_t> expected_overlap;
+        for (size_t id = 0; id < ranges.size(); ++id)
+        {
+            if (ranges[id].start <= end && points[i] <= ranges[id].end)
+                expected_overlap.push_back(id);
+        }
+        EXPECT_EQ(sorted(index.overlapping(points[i], end)), expected_overlap);
+    }
+}
+
+TEST(IntervalIndex, matches_brute_force_wrapped)
+{
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int64_t> key_dist(0, Instant::NANOSECONDS_PER_DAY - 1);
+
+    // Ranges in 'TZ::EST' that cross midnight in UTC wrap around.
+    std::vector<TimeRange> ranges;
+    std::vector<std::pair<int64_t, int64_t>> keys;
+    for (int i = 0; i < 200; ++i)
+    {
+        TimeDelta start = TimeDelta::from_nanoseconds(key_dist(rng));
+        TimeDelta end = TimeDelta::from_nanoseconds(key_dist(rng));
+        if (end < start)
+            std::swap(start, end);
+        ranges.emplace_back(Time(start, TZ::EST), Time(end, TZ::EST));
+        keys.emplace_back(IntervalKey<Time>::key(ranges.back().start),
+                          IntervalKey<Time>::key(ranges.back().end));
+    }
+    IntervalIndex<Time> index = IntervalIndex<Time>(ranges);
+    EXPECT_EQ(index.size(), ranges.size());
+
+    for (int i = 0; i < 200; ++i)
+    {
+        int64_t point = key_dist(rng);
+        // Queries can wrap around as well.
+        int64_t end = (point + key_dist(rng) / 4) % Instant::NANOSECONDS_PER_DAY;
+
+        std::vector<size_t> expected;
+        std::vector<size_t> expected_overlap;
+        for (size_t id = 0; id < keys.size(); ++id)
+        {
+            auto [range_start, range_end] = keys[id];
+            bool contains = range_start <= range_end
+                            ? range_start <= point && point <= range_end
+                            : range_start <= point || point <= range_end;
+            bool overlaps = range_start <= range_end && point <= end
+                            ? range_start <= end && point <= range_end
+                            : range_start <= end || point <= range_end
+                              || (range_start > range_end && point > end);
+            if (contains)
+                expected.push_back(id);
+            if (overlaps)
+                expected_overlap.push_back(id);
+        }
+
+        EXPECT_EQ(sorted(index.containing(IntervalKey<Time>::from_key(point))), expected);
+        std::vector<size_t> overlap = index.overlapping(IntervalKey<Time>::from_key(point),
+                                                        IntervalKey<Time>::from_key(end));
+        EXPECT_EQ(sorted(overlap), expected_overlap);
+    }
+}
@@ -0,0 +1,149 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <random>
+
+TEST(IntervalSet, constructor_coalesces)
+{
+    std::vector<DatetimeRange> ranges = {
+        DatetimeRange(Datetime(2022, 1, 3, 12), Datetime(2022, 1, 3, 13)),
+        DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 12)),
+        DatetimeRange(Datetime(2022, 1, 3, 14), Datetime(2022, 1, 3, 16)),
+        DatetimeRange(Datetime(2022, 1, 3, 14, 30), Datetime(2022, 1, 3, 15)),
+    };
+    IntervalSet<Datetime> set = IntervalSet<Datetime>(ranges);
+
+    std::vector<Range<Datetime>> actual = set.ranges();
+    ASSERT_EQ(actual.size(), 2);
+    EXPECT_EQ(actual[0].start, Datetime(2022, 1, 3, 9, 30));
+    EXPECT_EQ(actual[0].end, Datetime(2022, 1, 3, 13));
+    EXPECT_EQ(actual[1].start, Datetime(2022, 1, 3, 14));
+    EXPECT_EQ(actual[1].end, Datetime(2022, 1, 3, 16));
+}
+
+TEST(IntervalSet, contains)
+{
+    IntervalSet<Datetime> set = IntervalSet<Datetime>(std::vector<DatetimeRange>{
+        DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 12)),
+        DatetimeRange(Datetime(2022, 1, 3, 13), Datetime(2022, 1, 3, 16)),
+    });
+    EXPECT_FALSE(set.contains(Datetime(2022, 1, 3, 9, 29)));
+    EXPECT_TRUE(set.contains(Datetime(2022, 1, 3, 9, 30)));
+    EXPECT_TRUE(set.contains(Datetime(2022, 1, 3, 12)));
+    EXPECT_FALSE(set.contains(Datetime(2022, 1, 3, 12, 0, 0, 0, 0, 1)));
+    EXPECT_TRUE(set.contains(Datetime(2022, 1, 3, 21, 0, 0, 0, 0, 0, TZ::UTC)));
+    EXPECT_TRUE(set.contains(Datetime(2022, 1, 3, 14).to_instant()));
+    EXPECT_FALSE(IntervalSet<Datetime>().contains(Datetime(2022, 1, 3)));
+}
+
+TEST(IntervalSet, set_operations)
+{
+    IntervalSet<Datetime> session = IntervalSet<Datetime>(
+        DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 16)));
+    IntervalSet<Datetime> halts = IntervalSet<Datetime>(std::vector<DatetimeRange>{
+        DatetimeRange(Datetime(2022, 1, 3, 9), Datetime(2022, 1, 3, 10)),
+        DatetimeRange(Datetime(2022, 1, 3, 12), Datetime(2022, 1, 3, 12, 30)),
+    });
+
+    IntervalSet<Datetime> trading = session - halts;
+    EXPECT_EQ(trading.size(), 2);
+    EXPECT_FALSE(trading.contains(Datetime(2022, 1, 3, 10)));
+    EXPECT_TRUE(trading.contains(Datetime(2022, 1, 3, 10, 0, 0, 0, 0, 1)));
+    EXPECT_FALSE(trading.contains(Datetime(2022, 1, 3, 12, 15)));
+    EXPECT_TRUE(trading.contains(Datetime(2022, 1, 3, 15)));
+
+    IntervalSet<Datetime> halted = session & halts;
+    EXPECT_EQ(halted.size(), 2);
+    EXPECT_EQ(halted.ranges()[0].start, Datetime(2022, 1, 3, 9, 30));
+    EXPECT_EQ(halted.ranges()[0].end, Datetime(2022, 1, 3, 10));
+
+    IntervalSet<Datetime> all = session | halts;
+    EXPECT_EQ(all.size(), 1);
+    EXPECT_EQ(all.ranges()[0].start, Datetime(2022, 1, 3, 9));
+    EXPECT_EQ(all.ranges()[0].end, Datetime(2022, 1, 3, 16));
+
+    EXPECT_EQ(trading | halted, session);
+    EXPECT_TRUE((trading & halted).empty());
+}
+
+TEST(IntervalSet, complement)
+{
+    IntervalSet<Date> holidays = IntervalSet<Date>(std::vector<DateRange>{
+        DateRange(Date(2022, 12, 24), Date(2022, 12, 26)),
+        DateRange(Date(2022, 12, 31), Date(2023, 1, 2)),
+    });
+    IntervalSet<Date> open = holidays.complement(DateRange(Date(2022, 12, 1),
+                                                           Date(2022, 12, 31)));
+
+    std::vector<Range<Date>> ranges = open.ranges();
+    ASSERT_EQ(ranges.size(), 2);
+    EXPECT_EQ(ranges[0].start, Date(2022, 12, 1));
+    EXPECT_EQ(ranges[0].end, Date(2022, 12, 23));
+    EXPECT_EQ(ranges[1].start, Date(2022, 12, 27));
+    EXPECT_EQ(ranges[1].end, Date(2022, 12, 30));
+}
+
+TEST(IntervalSet, duration)
+{
+    IntervalSet<Datetime> set = IntervalSet<Datetime>(std::vector<DatetimeRange>{
+        DatetimeRange(Datetime(2022, 1, 3, 9, 30), Datetime(2022, 1, 3, 12)),
+        DatetimeRange(Datetime(2022, 1, 3, 12), Datetime(2022, 1, 3, 16)),
+        DatetimeRange(Datetime(2022, 1, 4, 9, 30), Datetime(2022, 1, 5, 9, 30)),
+    });
+    EXPECT_EQ(set.duration(), TimeDelta(1, 6, 30));
+
+    IntervalSet<Date> dates = IntervalSet<Date>(DateRange(Date(2022, 1, 1), Date(2022, 1, 1)));
+    EXPECT_EQ(dates.duration(), TimeDelta(1));
+
+    EXPECT_EQ(IntervalSet<Datetime>().duration(), TimeDelta());
+}
+
+TEST(IntervalSet, time_wraps_midnight_utc)
+{
+    IntervalSet<Time> set = IntervalSet<Time>(std::vector<TimeRange>{
+        TimeRange(Time(18, 0, 0, 0, 0, 0, TZ::EST), Time(20, 0, 0, 0, 0, 0, TZ::EST)),
+    });
+    EXPECT_EQ(set.size(), 2);
+    EXPECT_TRUE(set.contains(Time(18, 0, 0, 0, 0, 0, TZ::EST)));
+    EXPECT_TRUE(set.contains(Time(19, 0, 0, 0, 0, 0, TZ::EST)));
+    EXPECT_TRUE(set.contains(Time(20, 0, 0, 0, 0, 0, TZ::EST)));
+    EXPECT_FALSE(set.contains(Time(20, 0, 0, 0, 0, 1, TZ::EST)));
+    EXPECT_FALSE(set.contains(Time(17, 59, 0, 0, 0, 0, TZ::EST)));
+    EXPECT_EQ(set.duration(), TimeDelta(0, 2));
+}
+
+TEST(IntervalSet, matches_brute_force)
+{
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int64_t> dist(0, 200);
+
+    auto random_set = [&](std::vector<Range<Instant>>& ranges) {
+        for (int i = 0; i < 8; ++i)
+        {
+            int64_t start = dist(rng);
+            ranges.emplace_back(Instant(start), Instant(start + dist(rng) / 10));
+        }
+        return IntervalSet<Instant>(ranges);
+    };
+
+    for (int trial = 0; trial < 50; ++trial)
+    {
+        std::vector<Range<Instant>> a_ranges;
+        std::vector<Range<Instant>> b_ranges;
+        IntervalSet<Instant> a = random_set(a_ranges);
+        IntervalSet<Instant> b = random_set(b_ranges);
+
+        auto in = [](const std::vector<Range<Instant>>& ranges, Instant point) {
+            return std::any_of(ranges.begin(), ranges.end(),
+                               [&](const Range<Instant>& range) { return range.in_range(point); });
+        };
+
+        for (int64_t ns = -1; ns <= 230; ++ns)
+        {
+            Instant point = Instant(ns);
+            EXPECT_EQ(a.contains(point), in(a_ranges, point));
+            EXPECT_EQ((a | b).contains(point), in(a_ranges, point) || in(b_ranges, point));
+            EXPECT_EQ((a & b).contains(point), in(a_ranges, point) && in(b_ranges, point));
+            EXPECT_EQ((a - b).contains(point), in(a_ranges, point) && !in(b_ranges, point));
+        }
+    }
+}
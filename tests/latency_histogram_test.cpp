@@ -0,0 +1,163 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <random>
+#include <thread>
+
+namespace
+{
+TimeDelta ns(int64_t nanoseconds)
+{
+    return TimeDelta::from_nanoseconds(nanoseconds);
+}
+}
+
+TEST(LatencyHistogram, constructor_invalid)
+{
+    EXPECT_THROW(LatencyHistogram(0), std::invalid_argument);
+    EXPECT_THROW(LatencyHistogram(17), std::invalid_argument);
+}
+
+TEST(LatencyHistogram, empty)
+{
+    LatencyHistogram histogram = LatencyHistogram();
+    EXPECT_EQ(histogram.count(), 0);
+    EXPECT_EQ(histogram.min(), TimeDelta());
+    EXPECT_EQ(histogram.max(), TimeDelta());
+    EXPECT_EQ(histogram.mean(), TimeDelta());
+    EXPECT_EQ(histogram.percentile(50), TimeDelta());
+}
+
+TEST(LatencyHistogram, exact_below_precision)
+{
+    LatencyHistogram histogram = LatencyHistogram(4);
+    for (int64_t n : {3, 0, 15, 7, 7})
+        histogram.record(ns(n));
+
+    EXPECT_EQ(histogram.count(), 5);
+    EXPECT_EQ(histogram.min(), ns(0));
+    EXPECT_EQ(histogram.max(), ns(15));
+    EXPECT_EQ(histogram.mean(), ns(6));
+    EXPECT_EQ(histogram.percentile(0), ns(0));
+    EXPECT_EQ(histogram.percentile(50), ns(7));
+    EXPECT_EQ(histogram.percentile(100), ns(15));
+    EXPECT_THROW(histogram.percentile(101), std::invalid_argument);
+    EXPECT_THROW(histogram.record(ns(-1)), std::invalid_argument);
+}
+
+TEST(LatencyHistogram, relative_error)
+{
+    for (uint32_t precision : {1u, 3u, 8u, 16u})
+    {
+        std::mt19937_64 rng(precision);
+        for (size_t i = 0; i < 200; ++i)
+        {
+            auto value = static_cast<int64_t>(rng() >> (1 + rng() % 63));
+            LatencyHistogram histogram = LatencyHistogram(precision);
+            histogram.record_nanoseconds(value);
+
+            int64_t lowest = histogram.min().total_nanoseconds();
+            int64_t highest = histogram.max().total_nanoseconds();
+            ASSERT_LE(lowest, value);
+            ASSERT_GE(highest, value);
+            double error = std::ldexp(1.0, 1 - static_cast<int>(precision));
+            ASSERT_LE(static_cast<double>(highest - lowest), static_cast<double>(value) * error);
+        }
+    }
+
+    LatencyHistogram histogram = LatencyHistogram(1);
+    histogram.record_nanoseconds(std::numeric_limits<int64_t>::max());
+    EXPECT_EQ(histogram.max().total_nanoseconds(), std::numeric_limits<int64_t>::max());
+}
+
+TEST(LatencyHistogram, percentiles)
+{
+    LatencyHistogram histogram = LatencyHistogram(10);
+    for (int64_t us = 1; us <= 1'000; ++us)
+        histogram.record(TimeDelta(0, 0, 0, 0, 0, us));
+
+    auto near = [](TimeDelta actual, int64_t expected_us)
+    {
+        double expected = static_cast<double>(expected_us) * 1'000;
+        return std::abs(static_cast<double>(actual.total_nanoseconds()) - expected)
+            <= expected / 256;
+    };
+    EXPECT_TRUE(near(histogram.percentile(50), 500));
+    EXPECT_TRUE(near(histogram.percentile(99), 990));
+    EXPECT_TRUE(near(histogram.percentile(99.9), 999));
+    EXPECT_TRUE(near(histogram.mean(), 500));
+    EXPECT_EQ(histogram.min(), TimeDelta(0, 0, 0, 0, 0, 1));
+}
+
+TEST(LatencyHistogram, merge_and_reset)
+{
+    LatencyHistogram histogram = LatencyHistogram();
+    LatencyHistogram other = LatencyHistogram();
+    histogram.record(ns(10));
+    other.record(ns(20));
+    other.record(ns(1'000'000));
+    histogram.merge(other);
+
+    EXPECT_EQ(histogram.count(), 3);
+    EXPECT_EQ(histogram.min(), ns(10));
+    EXPECT_EQ(histogram.percentile(50), ns(20));
+    EXPECT_EQ(other.count(), 2);
+    EXPECT_THROW(histogram.merge(LatencyHistogram(5)), std::invalid_argument);
+
+    histogram.reset();
+    EXPECT_EQ(histogram.count(), 0);
+}
+
+TEST(LatencyHistogram, concurrent_record)
+{
+    LatencyHistogram histogram = LatencyHistogram();
+    std::vector<std::thread> threads;
+    for (int64_t t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&histogram, t]()
+        {
+            for (int64_t i = 0; i < 10'000; ++i)
+                histogram.record_nanoseconds(i % 100 + t);
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(histogram.count(), 40'000);
+    EXPECT_EQ(histogram.max(), ns(102));
+}
+
+TEST(LatencyHistogram, serialize)
+{
+    LatencyHistogram histogram = LatencyHistogram(12);
+    std::mt19937_64 rng(91);
+    for (size_t i = 0; i < 10'000; ++i)
+        histogram.record_nanoseconds(static_cast<int64_t>(rng() % 5'000'000));
+
+    std::vector<uint8_t> bytes = histogram.serialize();
+    LatencyHistogram decoded = LatencyHistogram::deserialize(bytes);
+    EXPECT_EQ(decoded.precision(), 12);
+    EXPECT_EQ(decoded.count(), histogram.count());
+    EXPECT_EQ(decoded.serialize(), bytes);
+    for (double percentile : {0.0, 10.0, 50.0, 99.0, 100.0})
+        EXPECT_EQ(decoded.percentile(percentile), histogram.percentile(percentile));
+
+    EXPECT_EQ(LatencyHistogram().serialize().size(), 1);
+}
+
+TEST(LatencyHistogram, deserialize_invalid)
+{
+    EXPECT_THROW(LatencyHistogram::deserialize({}), std::invalid_argument);
+
+    std::vector<uint8_t> precision = {0};
+    EXPECT_THROW(LatencyHistogram::deserialize(precision), std::invalid_argument);
+
+    std::vector<uint8_t> truncated = {8, 0x80};
+    EXPECT_THROW(LatencyHistogram::deserialize(truncated), std::invalid_argument);
+
+    // 1 bit of precision has 64 buckets.
+    std::vector<uint8_t> past_end = {1, 0, 64, 1};
+    EXPECT_THROW(LatencyHistogram::deserialize(past_end), std::invalid_argument);
+    std::vector<uint8_t> last = {1, 0, 63, 1};
+    EXPECT_EQ(LatencyHistogram::deserialize(last).max().total_nanoseconds(),
+              std::numeric_limits<int64_t>::max());
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <numeric>
+#include <random>
+
+namespace
+{
+std::vector<Instant> random_instants(size_t size, int64_t low, int64_t high, uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<int64_t> value(low, high);
+    std::vector<Instant> instants(size);
+    for (Instant& instant : instants)
+        instant = Instant(value(rng));
+    return instants;
+}
+
+/**
+ * Checks 'radix_sort' and 'argsort' of 'instants' against 'std::stable_sort'.
+ */
+void expect_sorted(const std::vector<Instant>& instants)
+{
+    std::vector<size_t> expected_order(instants.size());
+    std::iota(expected_order.begin(), expected_order.end(), 0);
+    std::stable_sort(expected_order.begin(), expected_order.end(), [&](size_t lhs, size_t rhs)
+    {
+        return instants[lhs] < instants[rhs];
+    });
+    std::vector<Instant> expected = instants;
+    std::sort(expected.begin(), expected.end());
+
+    for (unsigned threads : {1, 2, 5})
+    {
+        std::vector<Instant> sorted = instants;
+        radix_sort(sorted, threads);
+        EXPECT_EQ(sorted, expected) << threads;
+        EXPECT_EQ(argsort(instants, threads), expected_order) << threads;
+    }
+}
+}
+
+TEST(RadixSort, empty_and_single)
+{
+    std::vector<Instant> instants;
+    radix_sort(instants);
+    EXPECT_TRUE(argsort(instants).empty());
+
+    instants = {Instant(4)};
+    radix_sort(instants, 3);
+    EXPECT_EQ(instants, std::vector<Instant>({Instant(4)}));
+}
+
+TEST(RadixSort, invalid_thread_count)
+{
+    std::vector<Instant> instants = {Instant(2), Instant(1)};
+    EXPECT_THROW(radix_sort(instants, 0), std::invalid_argument);
+    EXPECT_THROW(argsort(instants, 0), std::invalid_argument);
+}
+
+TEST(RadixSort, small)
+{
+    expect_sorted({Instant(3), Instant(-1), Instant(3), Instant(0), Instant(-7)});
+}
+
+TEST(RadixSort, full_range)
+{
+    auto instants = random_instants(20'000, std::numeric_limits<int64_t>::min(),
+                                    std::numeric_limits<int64_t>::max(), 1);
+    instants.push_back(Instant(std::numeric_limits<int64_t>::min()));
+    instants.push_back(Instant(std::numeric_limits<int64_t>::max()));
+    expect_sorted(instants);
+}
+
+TEST(RadixSort, one_day_with_duplicates)
+{
+    int64_t start = Datetime(2022, 1, 3).to_instant().nanoseconds;
+    auto instants = random_instants(50'000, start, start + Instant::NANOSECONDS_PER_DAY, 2);
+    auto duplicates = random_instants(50'000, start, start + 1'000, 3);
+    instants.insert(instants.end(), duplicates.begin(), duplicates.end());
+    expect_sorted(instants);
+}
+
+TEST(RadixSort, all_equal)
+{
+    expect_sorted(std::vector<Instant>(1'000, Instant(42)));
+}
+
+TEST(RadixSort, datetimes)
+{
+    // Equal 'Datetimes' in different timezones keep their order.
+    std::vector<Datetime> datetimes = {
+        Datetime(2022, 1, 3, 12, 0, 0, 0, 0, 0, TZ::UTC),
+        Datetime(2022, 1, 3, 6, 0, 0, 0, 0, 0, TZ::EST),
+        Datetime(2022, 1, 3, 7, 0, 0, 0, 0, 0, TZ::EST),
+        Datetime(2022, 1, 2)};
+
+    EXPECT_EQ(argsort(std::span<const Datetime>(datetimes)), std::vector<size_t>({3, 1, 0, 2}));
+
+    radix_sort(std::span<Datetime>(datetimes));
+    EXPECT_EQ(datetimes[0], Datetime(2022, 1, 2));
+    EXPECT_EQ(datetimes[1].timezone, TZ::EST);
+    EXPECT_EQ(datetimes[2].timezone, TZ::UTC);
+    EXPECT_EQ(datetimes[3].hour, 7);
+}
@@ -0,0 +1,222 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <random>
+#include <thread>
+#include <datetime/datetime.h>
+#include "test_helpers.h"
+
+TEST(RateLimiter, constructor_invalid)
+{
+    EXPECT_THROW((RateLimiter(0, TimeDelta(0, 0, 0, 1))), std::invalid_argument);
+    EXPECT_THROW((RateLimiter(10, TimeDelta())), std::invalid_argument);
+    EXPECT_THROW((RateLimiter(10, TimeDelta(0, 0, 0, 1), 0)), std::invalid_argument);
+    EXPECT_THROW((RateLimiter(1, TimeDelta(100'000), 2)), std::invalid_argument);
+}
+
+TEST(RateLimiter, try_acquire)
+{
+    RateLimiter limiter = RateLimiter(100, TimeDelta(0, 0, 0, 1));
+    for (int i = 0; i < 100; ++i)
+        ASSERT_TRUE(limiter.try_acquire(1, START)) << i;
+    EXPECT_FALSE(limiter.try_acquire(1, START));
+
+    // A permit is refilled every 10 milliseconds.
+    EXPECT_FALSE(limiter.try_acquire(1, at_ms(9)));
+    EXPECT_TRUE(limiter.try_acquire(1, at_ms(10)));
+    EXPECT_FALSE(limiter.try_acquire(1, at_ms(10)));
+    EXPECT_TRUE(limiter.try_acquire(2, at_ms(30)));
+
+    // The bucket is full again after a second without permits.
+    EXPECT_TRUE(limiter.try_acquire(100, at_ms(1'030)));
+    EXPECT_FALSE(limiter.try_acquire(1, at_ms(1'030)));
+}
+
+TEST(RateLimiter, burst)
+{
+    RateLimiter limiter = RateLimiter(10, TimeDelta(0, 0, 0, 1), 3);
+    EXPECT_TRUE(limiter.try_acquire(3, START));
+    EXPECT_FALSE(limiter.try_acquire(1, START));
+
+    // A batch is acquired whole or not at all.
+    EXPECT_FALSE(limiter.try_acquire(2, at_ms(100)));
+    EXPECT_TRUE(limiter.try_acquire(1, at_ms(100)));
+    EXPECT_TRUE(limiter.try_acquire(3, at_ms(400)));
+    EXPECT_THROW(limiter.try_acquire(4, at_ms(10'000)), std::invalid_argument);
+    EXPECT_TRUE(limiter.try_acquire(0, at_ms(400)));
+}
+
+TEST(RateLimiter, available_at)
+{
+    RateLimiter limiter = RateLimiter(10, TimeDelta(0, 0, 0, 1), 5);
+    EXPECT_EQ(limiter.available_at(5, START), START);
+
+    limiter.try_acquire(5, START);
+    EXPECT_EQ(limiter.available_at(1, START), at_ms(100));
+    EXPECT_EQ(limiter.available_at(3, START), at_ms(300));
+    EXPECT_EQ(limiter.available_at(3, at_ms(350)), at_ms(350));
+
+    Instant available = limiter.available_at(4, at_ms(50));
+    EXPECT_FALSE(limiter.try_acquire(4, available - TimeDelta::from_nanoseconds(1)));
+    EXPECT_TRUE(limiter.try_acquire(4, available));
+}
+
+TEST(RateLimiter, clock_steps_back)
+{
+    RateLimiter limiter = RateLimiter(10, TimeDelta(0, 0, 0, 1));
+    EXPECT_TRUE(limiter.try_acquire(10, at_ms(1'000)));
+
+    // After a step back of an hour, the bucket is empty and refills at the rate.
+    EXPECT_FALSE(limiter.try_acquire(1, at_ms(-3'600'000)));
+    EXPECT_EQ(limiter.available_at(1, at_ms(-3'600'000)), at_ms(-3'599'900));
+    EXPECT_FALSE(limiter.try_acquire(1, at_ms(-3'599'901)));
+    EXPECT_TRUE(limiter.try_acquire(1, at_ms(-3'599'900)));
+    EXPECT_FALSE(limiter.try_acquire(1, at_ms(-3'599'900)));
+}
+
+TEST(RateLimiter, extremes)
+{
+    RateLimiter large = RateLimiter(1, TimeDelta::from_nanoseconds(1), 1'000'000'000'000'000'000);
+    EXPECT_TRUE(large.try_acquire(1'000'000'000'000'000'000, START));
+    EXPECT_FALSE(large.try_acquire(1, START));
+    EXPECT_EQ(large.available_at(1, START), Instant(START.nanoseconds + 1));
+
+    // Arrival times past the last 'Instant' are clamped to it.
+    Instant last = Instant(std::numeric_limits<int64_t>::max() - 10);
+    RateLimiter limiter = RateLimiter(1, TimeDelta(0, 0, 0, 1));
+    EXPECT_TRUE(limiter.try_acquire(1, last));
+    EXPECT_FALSE(limiter.try_acquire(1, last));
+    EXPECT_EQ(limiter.available_at(1, last), Instant(std::numeric_limits<int64_t>::max()));
+
+    RateLimiter first = RateLimiter(1, TimeDelta(0, 0, 0, 1));
+    EXPECT_TRUE(first.try_acquire(1, Instant(std::numeric_limits<int64_t>::min())));
+}
+
+TEST(RateLimiter, mock_instant)
+{
+    Instant::mock_instant = START;
+    RateLimiter limiter = RateLimiter(2, TimeDelta(0, 0, 0, 1));
+    EXPECT_TRUE(limiter.try_acquire(2));
+    EXPECT_FALSE(limiter.try_acquire());
+    EXPECT_EQ(limiter.available_at(), at_ms(500));
+
+    Instant::mock_instant = at_ms(500);
+    EXPECT_TRUE(limiter.try_acquire());
+    Instant::mock_instant.reset();
+}
+
+TEST(Instant, monotonic_now)
+{
+    Instant::mock_instant = START;
+    EXPECT_EQ(Instant::monotonic_now(), START);
+    Instant::mock_instant.reset();
+
+    Instant previous = Instant::monotonic_now();
+    EXPECT_NEAR(static_cast<double>(previous.nanoseconds),
+                static_cast<double>(Instant::now().nanoseconds),
+                static_cast<double>(Instant::NANOSECONDS_PER_HOUR));
+    for (int i = 0; i < 1000; ++i)
+    {
+        Instant now = Instant::monotonic_now();
+        ASSERT_GE(now, previous);
+        previous = now;
+    }
+}
+
+TEST(RateLimiter, concurrent)
+{
+    // Threads acquiring at the same time share the burst exactly.
+    RateLimiter limiter = RateLimiter(1'000, TimeDelta(0, 0, 0, 1), 10'000);
+    std::atomic<uint64_t> acquired = 0;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t)
+        threads.emplace_back([&limiter, &acquired]()
+        {
+            for (int i = 0; i < 5'000; ++i)
+                acquired += limiter.try_acquire(1 + i % 3, START) ? 1 + i % 3 : 0;
+        });
+    for (std::thread& thread : threads)
+        thread.join();
+    EXPECT_EQ(acquired, 10'000);
+    EXPECT_FALSE(limiter.try_acquire(1, START));
+}
+
+TEST(SlidingWindowRateLimiter, constructor_invalid)
+{
+    EXPECT_THROW((SlidingWindowRateLimiter(0, TimeDelta(0, 0, 0, 1))), std::invalid_argument);
+    EXPECT_THROW((SlidingWindowRateLimiter(10, TimeDelta())), std::invalid_argument);
+}
+
+TEST(SlidingWindowRateLimiter, try_acquire)
+{
+    SlidingWindowRateLimiter limiter = SlidingWindowRateLimiter(3, TimeDelta(0, 0, 0, 1));
+    EXPECT_TRUE(limiter.try_acquire(1, START));
+    EXPECT_TRUE(limiter.try_acquire(2, at_ms(600)));
+    EXPECT_FALSE(limiter.try_acquire(1, at_ms(999)));
+
+    // The first permit leaves the window a period after it was acquired.
+    EXPECT_TRUE(limiter.try_acquire(1, at_ms(1'000)));
+    EXPECT_FALSE(limiter.try_acquire(1, at_ms(1'599)));
+    EXPECT_FALSE(limiter.try_acquire(3, at_ms(1'600)));
+    EXPECT_TRUE(limiter.try_acquire(2, at_ms(1'600)));
+    EXPECT_THROW(limiter.try_acquire(4, at_ms(10'000)), std::invalid_argument);
+}
+
+TEST(SlidingWindowRateLimiter, available_at)
+{
+    SlidingWindowRateLimiter limiter = SlidingWindowRateLimiter(3, TimeDelta(0, 0, 0, 1));
+    EXPECT_EQ(limiter.available_at(3, START), START);
+
+    limiter.try_acquire(1, START);
+    limiter.try_acquire(2, at_ms(600));
+    EXPECT_EQ(limiter.available_at(1, at_ms(700)), at_ms(1'000));
+    EXPECT_EQ(limiter.available_at(2, at_ms(700)), at_ms(1'600));
+    EXPECT_EQ(limiter.available_at(1, at_ms(1'200)), at_ms(1'200));
+}
+
+TEST(SlidingWindowRateLimiter, clock_steps_back)
+{
+    SlidingWindowRateLimiter limiter = SlidingWindowRateLimiter(3, TimeDelta(0, 0, 0, 1));
+    EXPECT_TRUE(limiter.try_acquire(3, at_ms(3'600'000)));
+
+    // After a step back of an hour, the permits expire a period after the earlier time.
+    EXPECT_FALSE(limiter.try_acquire(1, START));
+    EXPECT_EQ(limiter.available_at(1, START), at_ms(1'000));
+    EXPECT_FALSE(limiter.try_acquire(1, at_ms(999)));
+    EXPECT_TRUE(limiter.try_acquire(3, at_ms(1'000)));
+}
+
+TEST(SlidingWindowRateLimiter, extremes)
+{
+    Instant last = Instant(std::numeric_limits<int64_t>::max() - 10);
+    SlidingWindowRateLimiter limiter = SlidingWindowRateLimiter(1, TimeDelta(0, 0, 0, 1));
+    EXPECT_TRUE(limiter.try_acquire(1, last));
+    EXPECT_FALSE(limiter.try_acquire(1, Instant(std::numeric_limits<int64_t>::max())));
+    EXPECT_EQ(limiter.available_at(1, last), Instant(std::numeric_limits<int64_t>::max()));
+}
+
+TEST(SlidingWindowRateLimiter, matches_log)
+{
+    // Every rolling second has at most 'LIMIT' permits, and a batch is refused only if it
+    // would exceed it.
+    constexpr uint64_t LIMIT = 20;
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int64_t> step(0, 120);
+    std::uniform_int_distribution<uint64_t> batch(1, 4);
+    SlidingWindowRateLimiter limiter = SlidingWindowRateLimiter(LIMIT, TimeDelta(0, 0, 0, 1));
+    std::deque<Instant> log;
+    Instant now = START;
+    for (int i = 0; i < 10'000; ++i)
+    {
+        now += TimeDelta::from_nanoseconds(step(rng) * 1'000'000);
+        uint64_t permits = batch(rng);
+        while (!log.empty() && log.front() + TimeDelta(0, 0, 0, 1) <= now)
+            log.pop_front();
+
+        bool expected = log.size() + permits <= LIMIT;
+        ASSERT_EQ(limiter.try_acquire(permits, now), expected) << i;
+        if (expected)
+            log.insert(log.end(), permits, now);
+    }
+}
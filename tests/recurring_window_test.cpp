@@ -0,0 +1,98 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+
+namespace
+{
+RecurringWindow regular_hours()
+{
+    return RecurringWindow(TimeRange(Time(9, 30, 0, 0, 0, 0, TZ::EST),
+                                     Time(16, 0, 0, 0, 0, 0, TZ::EST)),
+                           TZ::EST,
+                           RecurringWindow::WEEKDAYS);
+}
+}
+
+TEST(RecurringWindow, constructor_no_days)
+{
+    EXPECT_THROW(RecurringWindow(TimeRange(Time(9), Time(16)), TZ::EST, RecurringWindow::Days()),
+                 std::invalid_argument);
+}
+
+TEST(RecurringWindow, contains)
+{
+    RecurringWindow window = regular_hours();
+
+    // 2022-01-03 is a Monday.
+    EXPECT_FALSE(window.contains(Datetime(2022, 1, 3, 9, 29, 59, 0, 0, 0, TZ::EST)));
+    EXPECT_TRUE(window.contains(Datetime(2022, 1, 3, 9, 30, 0, 0, 0, 0, TZ::EST)));
+    EXPECT_TRUE(window.contains(Datetime(2022, 1, 3, 16, 0, 0, 0, 0, 0, TZ::EST)));
+    EXPECT_FALSE(window.contains(Datetime(2022, 1, 3, 16, 0, 0, 0, 0, 1, TZ::EST)));
+    EXPECT_TRUE(window.contains(Datetime(2022, 1, 3, 20, 0, 0, 0, 0, 0, TZ::UTC)));
+    EXPECT_TRUE(window.contains(Datetime(2022, 1, 7, 12, 0, 0, 0, 0, 0, TZ::EST)));
+    EXPECT_FALSE(window.contains(Datetime(2022, 1, 8, 12, 0, 0, 0, 0, 0, TZ::EST)));
+    EXPECT_FALSE(window.contains(Datetime(2022, 1, 9, 12, 0, 0, 0, 0, 0, TZ::EST)));
+}
+
+TEST(RecurringWindow, contains_matches_date_and_time)
+{
+    RecurringWindow window = regular_hours();
+    for (Datetime datetime : Datetime::range(Datetime(2022, 1, 1, 0, 0, 0, 0, 0, 0, TZ::EST),
+                                             Datetime(2022, 1, 15, 0, 0, 0, 0, 0, 0, TZ::EST),
+                                             Minutes(15)))
+    {
+        bool expected = datetime.is_weekday()
+            && TimeRange(Time(9, 30, 0, 0, 0, 0, TZ::EST), Time(16, 0, 0, 0, 0, 0, TZ::EST))
+                .in_range(datetime.time());
+        EXPECT_EQ(window.contains(datetime), expected) << datetime;
+    }
+}
+
+TEST(RecurringWindow, contains_overnight)
+{
+    // 18:00 to 20:00 EST is 23:00 to 01:00 UTC, so in UTC the window ends on the next day.
+    RecurringWindow window = RecurringWindow(TimeRange(Time(18, 0, 0, 0, 0, 0, TZ::EST),
+                                                       Time(20, 0, 0, 0, 0, 0, TZ::EST)),
+                                             TZ::UTC,
+                                             RecurringWindow::WEEKDAYS);
+
+    // Friday 2022-01-07.
+    EXPECT_TRUE(window.contains(Datetime(2022, 1, 7, 23, 30, 0, 0, 0, 0, TZ::UTC)));
+    EXPECT_TRUE(window.contains(Datetime(2022, 1, 8, 0, 30, 0, 0, 0, 0, TZ::UTC)));
+    EXPECT_FALSE(window.contains(Datetime(2022, 1, 8, 23, 30, 0, 0, 0, 0, TZ::UTC)));
+    EXPECT_FALSE(window.contains(Datetime(2022, 1, 10, 0, 30, 0, 0, 0, 0, TZ::UTC)));
+}
+
+TEST(RecurringWindow, next_start)
+{
+    RecurringWindow window = regular_hours();
+
+    EXPECT_EQ(window.next_start(Datetime(2022, 1, 3, 8, 0, 0, 0, 0, 0, TZ::EST)),
+              Datetime(2022, 1, 3, 9, 30, 0, 0, 0, 0, TZ::EST));
+    EXPECT_EQ(window.next_start(Datetime(2022, 1, 3, 9, 30, 0, 0, 0, 0, TZ::EST)),
+              Datetime(2022, 1, 3, 9, 30, 0, 0, 0, 0, TZ::EST));
+    EXPECT_EQ(window.next_start(Datetime(2022, 1, 3, 9, 30, 0, 0, 0, 1, TZ::EST)),
+              Datetime(2022, 1, 4, 9, 30, 0, 0, 0, 0, TZ::EST));
+
+    Datetime friday_close = Datetime(2022, 1, 7, 16, 0, 0, 0, 0, 0, TZ::EST);
+    Datetime next = window.next_start(friday_close);
+    EXPECT_EQ(next, Datetime(2022, 1, 10, 9, 30, 0, 0, 0, 0, TZ::EST));
+    EXPECT_EQ(next.timezone, TZ::EST);
+}
+
+TEST(RecurringWindow, occurrences)
+{
+    RecurringWindow window = regular_hours();
+
+    std::vector<DatetimeRange> occurrences;
+    for (const DatetimeRange& occurrence : window.occurrences(DateRange(Date(2022, 1, 1),
+                                                                        Date(2022, 1, 10))))
+        occurrences.push_back(occurrence);
+
+    ASSERT_EQ(occurrences.size(), 6);
+    EXPECT_EQ(occurrences.front().start, Datetime(2022, 1, 3, 9, 30, 0, 0, 0, 0, TZ::EST));
+    EXPECT_EQ(occurrences.front().end, Datetime(2022, 1, 3, 16, 0, 0, 0, 0, 0, TZ::EST));
+    EXPECT_EQ(occurrences.back().start, Datetime(2022, 1, 10, 9, 30, 0, 0, 0, 0, TZ::EST));
+
+    auto weekend = window.occurrences(DateRange(Date(2022, 1, 8), Date(2022, 1, 9)));
+    EXPECT_EQ(weekend.begin(), weekend.end());
+}
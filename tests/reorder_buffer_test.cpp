@@ -0,0 +1,121 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <random>
+
+namespace
+{
+std::vector<int64_t> drain_all(ReorderBuffer<int>& buffer)
+{
+    std::vector<int64_t> ret;
+    buffer.drain([&ret](Instant instant, int) { ret.push_back(instant.nanoseconds); });
+    return ret;
+}
+}
+
+TEST(ReorderBuffer, constructor_invalid)
+{
+    EXPECT_THROW(ReorderBuffer<int>(TimeDelta::from_nanoseconds(-1)), std::invalid_argument);
+    EXPECT_THROW(ReorderBuffer<int>(TimeDelta(), TimeDelta::from_nanoseconds(-1)),
+                 std::invalid_argument);
+}
+
+TEST(ReorderBuffer, releases_after_max_disorder)
+{
+    ReorderBuffer<int> buffer = ReorderBuffer<int>(TimeDelta::from_nanoseconds(10));
+    EXPECT_FALSE(buffer.pop());
+
+    buffer.push(Instant(100), 1);
+    buffer.push(Instant(95), 2);
+    buffer.push(Instant(104), 3);
+    EXPECT_EQ(buffer.size(), 3);
+    EXPECT_FALSE(buffer.pop());
+
+    buffer.push(Instant(105), 4);
+    auto item = buffer.pop();
+    ASSERT_TRUE(item);
+    EXPECT_EQ(item->instant, Instant(95));
+    EXPECT_EQ(item->value, 2);
+    EXPECT_FALSE(buffer.pop());
+
+    buffer.push(Instant(120), 5);
+    EXPECT_EQ(drain_all(buffer), std::vector<int64_t>({100, 104, 105}));
+    EXPECT_EQ(buffer.latest_instant(), Instant(120));
+
+    std::vector<int64_t> flushed;
+    auto collect = [&flushed](Instant instant, int) { flushed.push_back(instant.nanoseconds); };
+    EXPECT_EQ(buffer.flush(collect), 1);
+    EXPECT_EQ(flushed, std::vector<int64_t>({120}));
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(ReorderBuffer, rejects_late)
+{
+    ReorderBuffer<int> buffer = ReorderBuffer<int>(TimeDelta::from_nanoseconds(10));
+    buffer.push(Instant(100), 1);
+    buffer.push(Instant(110), 2);
+    EXPECT_EQ(drain_all(buffer), std::vector<int64_t>({100}));
+
+    EXPECT_FALSE(buffer.push(Instant(99), 3));
+    EXPECT_TRUE(buffer.push(Instant(100), 4));
+    EXPECT_EQ(buffer.late_count(), 1);
+    EXPECT_EQ(buffer.size(), 2);
+}
+
+TEST(ReorderBuffer, equal_instants_keep_order)
+{
+    ReorderBuffer<int> buffer = ReorderBuffer<int>(TimeDelta());
+    buffer.push(Instant(5), 1);
+    buffer.push(Instant(5), 2);
+    buffer.push(Instant(3), 3);
+
+    std::vector<int> values;
+    buffer.flush([&values](Instant, int value) { values.push_back(value); });
+    EXPECT_EQ(values, std::vector<int>({3, 1, 2}));
+}
+
+TEST(ReorderBuffer, jumps_past_ring)
+{
+    ReorderBuffer<int> buffer = ReorderBuffer<int>(TimeDelta::from_nanoseconds(16),
+                                                   TimeDelta::from_nanoseconds(4));
+    buffer.push(Instant(-3), 1);
+    buffer.push(Instant(1'000'000), 2);
+    buffer.push(Instant(1'000'002), 3);
+    buffer.push(Instant(999'990), 4);
+    buffer.push(Instant(1'000'000'000), 5);
+    EXPECT_EQ(drain_all(buffer), std::vector<int64_t>({-3, 999'990, 1'000'000, 1'000'002}));
+    EXPECT_EQ(buffer.size(), 1);
+}
+
+TEST(ReorderBuffer, sorts_nearly_sorted)
+{
+    std::mt19937_64 rng(2);
+    // Each instant arrives up to 500 nanoseconds late.
+    std::vector<std::pair<int64_t, int64_t>> arrivals;
+    for (int64_t i = 0; i < 20'000; ++i)
+    {
+        int64_t instant = i * 10 + static_cast<int64_t>(rng() % 7);
+        arrivals.emplace_back(instant + static_cast<int64_t>(rng() % 500), instant);
+    }
+    std::sort(arrivals.begin(), arrivals.end());
+    std::vector<int64_t> instants;
+    for (const auto& [arrival, instant] : arrivals)
+        instants.push_back(instant);
+
+    ReorderBuffer<size_t> buffer = ReorderBuffer<size_t>(TimeDelta::from_nanoseconds(500));
+    std::vector<int64_t> released;
+    auto collect = [&released](Instant instant, size_t)
+    {
+        released.push_back(instant.nanoseconds);
+    };
+    for (size_t i = 0; i < instants.size(); ++i)
+    {
+        EXPECT_TRUE(buffer.push(Instant(instants[i]), i));
+        buffer.drain(collect);
+    }
+    buffer.flush(collect);
+
+    std::vector<int64_t> expected = instants;
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(released, expected);
+    EXPECT_EQ(buffer.late_count(), 0);
+}
@@ -0,0 +1,124 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <datetime/series/resample.h>
+#include <random>
+
+TEST(BucketGrid, constructor_non_positive_width)
+{
+    EXPECT_THROW(BucketGrid grid(TimeDelta{}), std::invalid_argument);
+    EXPECT_THROW(BucketGrid grid(TimeDelta(-1)), std::invalid_argument);
+    EXPECT_THROW(BucketGrid grid(TimeDelta{}, TZ::EST), std::invalid_argument);
+}
+
+TEST(BucketGrid, bucket_id_origin)
+{
+    BucketGrid grid = BucketGrid(TimeDelta(0, 0, 1), Instant(30));
+    EXPECT_EQ(grid.bucket_id(Instant(30)), 0);
+    EXPECT_EQ(grid.bucket_id(Instant(29)), -1);
+    EXPECT_EQ(grid.bucket_id(Instant(30 + 60'000'000'000)), 1);
+    EXPECT_EQ(grid.bucket_id(Instant(30 - 60'000'000'000)), -1);
+    EXPECT_EQ(grid.bucket_id(Instant(29 - 60'000'000'000)), -2);
+    EXPECT_EQ(grid.bucket_start(-2), Instant(30 - 120'000'000'000));
+    EXPECT_EQ(grid.bucket_end(-2), Instant(30 - 60'000'000'000));
+}
+
+TEST(BucketGrid, bucket_id_matches_floor)
+{
+    BucketGrid grid = BucketGrid(TimeDelta(0, 0, 5));
+    for (Datetime datetime : Datetime::range(Datetime(2022, 1, 3, 9), Datetime(2022, 1, 3, 10),
+                                             Seconds(17)))
+    {
+        Instant instant = datetime.to_instant();
+        Instant start = grid.bucket_start(grid.bucket_id(instant));
+
+        Datetime expected = datetime;
+        expected.set_timezone(TZ::UTC);
+        expected.floor(TimeComponent::MINUTE);
+        expected -= Minutes(expected.minute % 5);
+        EXPECT_EQ(start, expected.to_instant()) << datetime;
+    }
+}
+
+TEST(BucketGrid, bucket_ids_matches_bucket_id)
+{
+    std::mt19937_64 rng(3);
+    std::uniform_int_distribution<int64_t> dist(-1'000'000'000'000'000, 1'000'000'000'000'000);
+    std::vector<Instant> instants;
+    for (int i = 0; i < 10'000; ++i)
+        instants.push_back(Instant(dist(rng)));
+
+    for (BucketGrid grid : {BucketGrid(TimeDelta(0, 0, 0, 1), Instant(12345)),
+                            BucketGrid(TimeDelta(0, 0, 0, 0, 0, 0, 7)),
+                            BucketGrid(TimeDelta(0, 0, 7), TZ::EST, TimeDelta(0, 9, 30))})
+    {
+        std::vector<int64_t> ids(instants.size());
+        grid.bucket_ids(instants, ids);
+        for (size_t i = 0; i < instants.size(); ++i)
+        {
+            EXPECT_EQ(ids[i], grid.bucket_id(instants[i]));
+            EXPECT_LE(grid.bucket_start(ids[i]), instants[i]);
+            EXPECT_GT(grid.bucket_end(ids[i]), instants[i]);
+        }
+    }
+}
+
+TEST(BucketGrid, daily_restarts_at_day_offset)
+{
+    // 7 minute bars from 09:30 EST, the last bar of a day ends at 09:30 EST the next day.
+    BucketGrid grid = BucketGrid(TimeDelta(0, 0, 7), TZ::EST, TimeDelta(0, 9, 30));
+
+    Instant open = Datetime(2022, 1, 3, 9, 30, 0, 0, 0, 0, TZ::EST).to_instant();
+    int64_t first = grid.bucket_id(open);
+    EXPECT_EQ(grid.bucket_start(first), open);
+    EXPECT_EQ(grid.bucket_id(open - TimeDelta(0, 0, 0, 0, 0, 0, 1)), first - 1);
+    EXPECT_EQ(grid.bucket_end(first - 1), open);
+    // 1440 minutes is not a multiple of 7, so the last bucket of a day is 5 minutes long.
+    EXPECT_EQ(grid.bucket_start(first - 1),
+              Datetime(2022, 1, 3, 9, 25, 0, 0, 0, 0, TZ::EST).to_instant());
+
+    Instant next_open = Datetime(2022, 1, 4, 9, 30, 0, 0, 0, 0, TZ::EST).to_instant();
+    EXPECT_EQ(grid.bucket_start(grid.bucket_id(next_open)), next_open);
+}
+
+TEST(BucketGrid, free_function)
+{
+    std::vector<Instant> instants = {Instant(0), Instant(9), Instant(10), Instant(-1)};
+    std::vector<int64_t> ids(instants.size());
+    bucket_ids(instants, TimeDelta(0, 0, 0, 0, 0, 0, 10), Instant(), ids);
+    EXPECT_EQ(ids, std::vector<int64_t>({0, 0, 1, -1}));
+
+    std::vector<int64_t> too_small(1);
+    EXPECT_THROW(bucket_ids(instants, TimeDelta(0, 0, 1), Instant(), too_small),
+                 std::invalid_argument);
+}
+
+TEST(Resampler, push)
+{
+    Resampler resampler = Resampler(BucketGrid(TimeDelta(0, 0, 0, 0, 0, 0, 10)));
+    EXPECT_FALSE(resampler.started());
+    EXPECT_TRUE(resampler.push(Instant(3)));
+    EXPECT_TRUE(resampler.started());
+    EXPECT_FALSE(resampler.push(Instant(9)));
+    EXPECT_TRUE(resampler.push(Instant(25)));
+    EXPECT_EQ(resampler.bucket_id(), 2);
+    EXPECT_EQ(resampler.bucket_start(), Instant(20));
+    EXPECT_EQ(resampler.bucket_end(), Instant(30));
+    EXPECT_THROW(resampler.push(Instant(24)), std::invalid_argument);
+}
+
+TEST(Resampler, push_batch)
+{
+    Resampler resampler = Resampler(BucketGrid(TimeDelta(0, 0, 0, 0, 0, 0, 10)));
+    std::vector<size_t> boundaries;
+    std::vector<Instant> first = {Instant(1), Instant(2), Instant(11), Instant(35)};
+    std::vector<Instant> second = {Instant(36), Instant(40), Instant(40), Instant(75)};
+    resampler.push(first, boundaries);
+    EXPECT_EQ(boundaries, std::vector<size_t>({0, 2, 3}));
+
+    boundaries.clear();
+    resampler.push(second, boundaries);
+    EXPECT_EQ(boundaries, std::vector<size_t>({1, 3}));
+
+    std::vector<Instant> unsorted = {Instant(80), Instant(79)};
+    EXPECT_THROW(resampler.push(unsorted, boundaries), std::invalid_argument);
+}
@@ -0,0 +1,191 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <random>
+
+namespace
+{
+/**
+ * Bitwise or, which cannot be undone when an element leaves the window.
+ */
+struct BitwiseOr
+{
+    using value_type = uint64_t;
+
+    static uint64_t identity()
+    {
+        return 0;
+    }
+
+    static uint64_t combine(uint64_t lhs, uint64_t rhs)
+    {
+        return lhs | rhs;
+    }
+};
+
+/**
+ * Concatenation, which is not commutative.
+ */
+struct Concatenate
+{
+    using value_type = std::string;
+
+    static std::string identity()
+    {
+        return "";
+    }
+
+    static std::string combine(const std::string& lhs, const std::string& rhs)
+    {
+        return lhs + rhs;
+    }
+};
+
+/**
+ * Price and size of a trade, aggregated into the volume weighted average price.
+ */
+struct Trade
+{
+    double notional = 0;
+    double size = 0;
+
+    Trade& operator+=(const Trade& other)
+    {
+        notional += other.notional;
+        size += other.size;
+        return *this;
+    }
+
+    Trade& operator-=(const Trade& other)
+    {
+        notional -= other.notional;
+        size -= other.size;
+        return *this;
+    }
+};
+
+const TimeDelta TEN_NANOSECONDS = TimeDelta::from_nanoseconds(10);
+}
+
+TEST(RollingWindow, constructor_non_positive_width)
+{
+    using Window = RollingWindow<int>;
+    EXPECT_THROW(Window window(TimeDelta{}), std::invalid_argument);
+    EXPECT_THROW(Window window(TimeDelta::from_nanoseconds(-1)), std::invalid_argument);
+}
+
+TEST(RollingWindow, evicts_expired)
+{
+    RollingWindow<int, CountAggregation<int>, SumAggregation<int>> window(TEN_NANOSECONDS);
+    window.push(Instant(0), 1);
+    window.push(Instant(5), 2);
+    window.push(Instant(9), 3);
+    EXPECT_EQ(window.size(), 3);
+    EXPECT_EQ(window.get<SumAggregation<int>>(), 6);
+
+    // 0 is exactly 'width' before 10, so it leaves the window.
+    window.push(Instant(10), 4);
+    EXPECT_EQ(window.get<CountAggregation<int>>(), 3);
+    EXPECT_EQ(window.get<SumAggregation<int>>(), 9);
+    EXPECT_EQ(window[0], 2);
+    EXPECT_EQ(window.instant(0), Instant(5));
+    EXPECT_EQ(window.end(), Instant(10));
+
+    window.advance(Instant(19));
+    EXPECT_EQ(window.size(), 1);
+    EXPECT_EQ(window.get<SumAggregation<int>>(), 4);
+
+    window.advance(Instant(100));
+    EXPECT_TRUE(window.empty());
+    EXPECT_EQ(window.get<SumAggregation<int>>(), 0);
+}
+
+TEST(RollingWindow, push_before_latest)
+{
+    RollingWindow<int> window(TEN_NANOSECONDS);
+    window.push(Instant(5), 1);
+    window.push(Instant(5), 1);
+    EXPECT_THROW(window.push(Instant(4), 1), std::invalid_argument);
+    EXPECT_THROW(window.advance(Instant(4)), std::invalid_argument);
+}
+
+TEST(RollingWindow, clear)
+{
+    RollingWindow<int, SumAggregation<int>, MaxAggregation<int>> window(TEN_NANOSECONDS);
+    window.push(Instant(1), 5);
+    window.clear();
+    EXPECT_TRUE(window.empty());
+    window.push(Instant(2), 3);
+    EXPECT_EQ(window.get<SumAggregation<int>>(), 3);
+    EXPECT_EQ(window.get<MaxAggregation<int>>(), 3);
+}
+
+TEST(RollingWindow, vwap)
+{
+    RollingWindow<Trade, SumAggregation<Trade>> window(TimeDelta(0, 0, 0, 1));
+    Instant start = Datetime(2022, 1, 3, 9, 30).to_instant();
+    window.push(start, Trade{100 * 10, 10});
+    window.push(start + TimeDelta(0, 0, 0, 0, 500), Trade{102 * 30, 30});
+    Trade total = window.get<SumAggregation<Trade>>();
+    EXPECT_DOUBLE_EQ(total.notional / total.size, 101.5);
+
+    window.push(start + TimeDelta(0, 0, 0, 1, 200), Trade{104 * 10, 10});
+    total = window.get<SumAggregation<Trade>>();
+    EXPECT_DOUBLE_EQ(total.notional / total.size, 102.5);
+}
+
+TEST(RollingWindow, monoid_is_ordered)
+{
+    RollingWindow<std::string, MonoidAggregation<Concatenate, std::string>> window(
+        TEN_NANOSECONDS);
+    for (int i = 0; i < 30; ++i)
+    {
+        window.push(Instant(i * 3), std::string(1, static_cast<char>('a' + i % 26)));
+
+        std::string expected;
+        for (size_t j = 0; j < window.size(); ++j)
+            expected += window[j];
+        EXPECT_EQ((window.get<MonoidAggregation<Concatenate, std::string>>()), expected);
+    }
+}
+
+TEST(RollingWindow, matches_naive)
+{
+    using Window = RollingWindow<int64_t, CountAggregation<int64_t>, SumAggregation<int64_t>,
+                                 MinAggregation<int64_t>, MaxAggregation<int64_t>,
+                                 MonoidAggregation<BitwiseOr, int64_t>>;
+    Window window(TimeDelta::from_nanoseconds(100));
+
+    std::mt19937_64 rng(1);
+    std::vector<std::pair<Instant, int64_t>> pushed;
+    int64_t nanoseconds = 0;
+    for (int i = 0; i < 5'000; ++i)
+    {
+        nanoseconds += static_cast<int64_t>(rng() % 20);
+        auto value = static_cast<int64_t>(rng() % 50);
+        window.push(Instant(nanoseconds), value);
+        pushed.emplace_back(Instant(nanoseconds), value);
+
+        size_t count = 0;
+        int64_t sum = 0;
+        int64_t min = std::numeric_limits<int64_t>::max();
+        int64_t max = std::numeric_limits<int64_t>::min();
+        uint64_t bits = 0;
+        for (const auto& [instant, element] : pushed)
+        {
+            if (nanoseconds - instant.nanoseconds >= 100)
+                continue;
+            count++;
+            sum += element;
+            min = std::min(min, element);
+            max = std::max(max, element);
+            bits |= static_cast<uint64_t>(element);
+        }
+
+        ASSERT_EQ(window.size(), count);
+        ASSERT_EQ(window.get<CountAggregation<int64_t>>(), count);
+        ASSERT_EQ(window.get<SumAggregation<int64_t>>(), sum);
+        ASSERT_EQ(window.get<MinAggregation<int64_t>>(), min);
+        ASSERT_EQ(window.get<MaxAggregation<int64_t>>(), max);
+        ASSERT_EQ((window.get<MonoidAggregation<BitwiseOr, int64_t>>()), bits);
+    }
+}
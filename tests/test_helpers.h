@@ -0,0 +1,41 @@
+#ifndef DATETIME_TEST_HELPERS_H
+#define DATETIME_TEST_HELPERS_H
+
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include <datetime/datetime.h>
+
+/**
+ * Creates an 'Instant' for each of 'nanoseconds' since the Unix epoch.
+ */
+inline std::vector<Instant> instants(std::initializer_list<int64_t> nanoseconds)
+{
+    std::vector<Instant> ret;
+    for (int64_t n : nanoseconds)
+        ret.push_back(Instant(n));
+    return ret;
+}
+
+/**
+ * 2022-01-03 00:00 UTC, the start of the simulated clocks of the tests.
+ */
+inline constexpr Instant START = Instant(1'641'168'000'000'000'000);
+
+/**
+ * Creates a 'TimeDelta' of 'count' milliseconds.
+ */
+inline TimeDelta milliseconds(int64_t count)
+{
+    return TimeDelta::from_nanoseconds(count * 1'000'000);
+}
+
+/**
+ * Gets the 'Instant' 'count' milliseconds after 'START'.
+ */
+inline Instant at_ms(int64_t count)
+{
+    return START + milliseconds(count);
+}
+
+#endif //DATETIME_TEST_HELPERS_H
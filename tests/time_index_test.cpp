@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <random>
+
+namespace
+{
+/**
+ * Checks every bound of 'index' against 'std::lower_bound' and 'std::upper_bound'.
+ */
+void expect_bounds(const TimeIndex& index, const std::vector<Instant>& queries)
+{
+    std::span<const Instant> keys = index.instants();
+    for (Instant query : queries)
+    {
+        EXPECT_EQ(index.lower_bound(query),
+                  std::lower_bound(keys.begin(), keys.end(), query) - keys.begin())
+            << query.nanoseconds;
+        EXPECT_EQ(index.upper_bound(query),
+                  std::upper_bound(keys.begin(), keys.end(), query) - keys.begin())
+            << query.nanoseconds;
+    }
+}
+}
+
+TEST(TimeIndex, constructor_unsorted)
+{
+    EXPECT_THROW(TimeIndex({Instant(2), Instant(1)}), std::invalid_argument);
+}
+
+TEST(TimeIndex, empty)
+{
+    TimeIndex index = TimeIndex({});
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.lower_bound(Instant(5)), 0);
+    EXPECT_EQ(index.upper_bound(Instant(5)), 0);
+    EXPECT_EQ(index.range(Instant(0), Instant(10)), (std::pair<size_t, size_t>(0, 0)));
+}
+
+TEST(TimeIndex, bounds_with_duplicates)
+{
+    TimeIndex index = TimeIndex({Instant(1), Instant(3), Instant(3), Instant(3), Instant(7)});
+    EXPECT_EQ(index.size(), 5);
+    EXPECT_EQ(index[4], Instant(7));
+    EXPECT_EQ(index.lower_bound(Instant(3)), 1);
+    EXPECT_EQ(index.upper_bound(Instant(3)), 4);
+    EXPECT_EQ(index.lower_bound(Instant(0)), 0);
+    EXPECT_EQ(index.upper_bound(Instant(7)), 5);
+    EXPECT_EQ(index.range(Instant(2), Instant(7)), (std::pair<size_t, size_t>(1, 5)));
+    EXPECT_EQ(index.range(Instant(7), Instant(2)), (std::pair<size_t, size_t>(0, 0)));
+}
+
+TEST(TimeIndex, range_datetime)
+{
+    std::vector<Instant> instants;
+    for (Datetime datetime : Datetime::range(Datetime(2022, 1, 3, 9), Datetime(2022, 1, 3, 17),
+                                             Minutes(1)))
+        instants.push_back(datetime.to_instant());
+    TimeIndex index = TimeIndex(instants);
+
+    auto [first, last] = index.range(DatetimeRange(Datetime(2022, 1, 3, 9, 30),
+                                                   Datetime(2022, 1, 3, 10)));
+    EXPECT_EQ(first, 30);
+    EXPECT_EQ(last, 61);
+}
+
+TEST(TimeIndex, matches_std_uniform)
+{
+    std::mt19937_64 rng(11);
+    std::uniform_int_distribution<int64_t> value(0, 1'000'000'000);
+    std::vector<Instant> instants;
+    for (size_t i = 0; i < 20'000; ++i)
+        instants.push_back(Instant(value(rng)));
+    std::sort(instants.begin(), instants.end());
+
+    std::vector<Instant> queries = {Instant(-1), Instant(0), Instant(1'000'000'001)};
+    for (size_t i = 0; i < 2'000; ++i)
+        queries.push_back(Instant(value(rng)));
+    for (size_t i = 0; i < instants.size(); i += 97)
+        queries.push_back(instants[i]);
+
+    expect_bounds(TimeIndex(instants), queries);
+    expect_bounds(TimeIndex(instants, false), queries);
+}
+
+TEST(TimeIndex, matches_std_skewed)
+{
+    // Clusters and extreme values defeat the interpolation guess.
+    std::vector<Instant> instants = {Instant(std::numeric_limits<int64_t>::min())};
+    for (int64_t i = 0; i < 10'000; ++i)
+        instants.push_back(Instant(i / 7));
+    for (int64_t i = 0; i < 10'000; ++i)
+        instants.push_back(Instant(1'000'000'000'000 + i * i));
+    instants.push_back(Instant(std::numeric_limits<int64_t>::max()));
+
+    std::vector<Instant> queries = {Instant(std::numeric_limits<int64_t>::min()),
+                                    Instant(std::numeric_limits<int64_t>::max()),
+                                    Instant(-5), Instant(500'000'000'000)};
+    for (size_t i = 0; i < instants.size(); i += 13)
+    {
+        queries.push_back(instants[i]);
+        queries.push_back(instants[i] + TimeDelta::from_nanoseconds(1));
+    }
+
+    expect_bounds(TimeIndex(instants), queries);
+    expect_bounds(TimeIndex(instants, false), queries);
+}
@@ -787,6 +787,13 @@ TEST(Time, operator_minus_day_wrap)
 TEST(Time, hash)
 {
     size_t hashed = std::hash<Time>{}(Time());
+
+    // Equal 'Times' in different timezones have the same hash, including across midnight.
+    Time est = Time(22, 30, 0, 0, 0, 0, TZ::EST);
+    Time utc = Time(3, 30, 0, 0, 0, 0, TZ::UTC);
+    ASSERT_EQ(est, utc);
+    EXPECT_EQ(std::hash<Time>{}(est), std::hash<Time>{}(utc));
+    EXPECT_NE(std::hash<Time>{}(est), std::hash<Time>{}(Time(22, 30, 0, 0, 0, 1, TZ::EST)));
 }
 
 TEST(Time, increment_hours)
@@ -395,4 +395,18 @@ TEST(TimeDelta, abs_neg)
 {
     TimeDelta time_delta = TimeDelta(-1);
     ASSERT_EQ(time_delta.abs().days, 1);
-}
\ No newline at end of file
+}
+
+TEST(TimeDelta, from_nanoseconds_pos)
+{
+    TimeDelta time_delta = TimeDelta::from_nanoseconds(90'061'001'002'003);
+    EXPECT_EQ(time_delta, TimeDelta(1, 1, 1, 1, 1, 2, 3));
+    EXPECT_EQ(time_delta.total_nanoseconds(), 90'061'001'002'003);
+}
+
+TEST(TimeDelta, from_nanoseconds_neg)
+{
+    TimeDelta time_delta = TimeDelta::from_nanoseconds(-1);
+    EXPECT_EQ(time_delta, TimeDelta(-1, 23, 59, 59, 999, 999, 999));
+    EXPECT_EQ(time_delta.total_nanoseconds(), -1);
+}
@@ -0,0 +1,184 @@
+#include "gtest/gtest.h"
+#include <random>
+#include <datetime/datetime.h>
+#include "test_helpers.h"
+
+TEST(Instant, now_mock)
+{
+    Instant::mock_instant = START;
+    EXPECT_EQ(Instant::now(), START);
+    *Instant::mock_instant += milliseconds(5);
+    EXPECT_EQ(Instant::now(), START + milliseconds(5));
+    Instant::mock_instant.reset();
+
+    Instant now = Instant::now();
+    EXPECT_NEAR(static_cast<double>(now.nanoseconds),
+                static_cast<double>(Datetime::now().to_instant().nanoseconds),
+                static_cast<double>(Instant::NANOSECONDS_PER_HOUR));
+}
+
+TEST(Instant, now_date_time_mock)
+{
+    Date::mock_date = Date(2022, 1, 3);
+    Time::mock_time = Time(9, 30, 0, 0, 0, 0, TZ::EST);
+    EXPECT_EQ(Instant::now(), Datetime::now().to_instant());
+    EXPECT_EQ(Instant::now(), Datetime(2022, 1, 3, 9, 30, 0, 0, 0, 0, TZ::EST).to_instant());
+
+    // 'Instant::mock_instant' takes precedence.
+    Instant::mock_instant = START;
+    EXPECT_EQ(Instant::now(), START);
+    Instant::mock_instant.reset();
+    Date::mock_date.reset();
+    Time::mock_time.reset();
+}
+
+TEST(TimerWheel, constructor_invalid_resolution)
+{
+    EXPECT_THROW(TimerWheel<int>(TimeDelta(), START), std::invalid_argument);
+}
+
+TEST(TimerWheel, expires_at_deadline)
+{
+    TimerWheel<int> wheel = TimerWheel<int>(milliseconds(1), START);
+    wheel.schedule(START + milliseconds(5), 1);
+    wheel.schedule(START + milliseconds(5) + TimeDelta::from_nanoseconds(1), 2);
+    wheel.schedule(START + milliseconds(300), 3);
+    EXPECT_EQ(wheel.size(), 3);
+
+    std::vector<int> expired;
+    auto collect = [&expired](int value) { expired.push_back(value); };
+
+    EXPECT_EQ(wheel.tick(START + milliseconds(4), collect), 0);
+    EXPECT_EQ(wheel.tick(START + milliseconds(5), collect), 1);
+    EXPECT_EQ(expired, std::vector<int>({1}));
+
+    // Deadlines are rounded up to the resolution.
+    EXPECT_EQ(wheel.tick(START + milliseconds(5) + TimeDelta::from_nanoseconds(1), collect), 0);
+    EXPECT_EQ(wheel.tick(START + milliseconds(6), collect), 1);
+    EXPECT_EQ(wheel.tick(START + milliseconds(299), collect), 0);
+    EXPECT_EQ(wheel.tick(START + milliseconds(1000), collect), 1);
+    EXPECT_EQ(expired, std::vector<int>({1, 2, 3}));
+    EXPECT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheel, matches_sorted_deadlines)
+{
+    std::mt19937_64 rng(7);
+    // Up to 80 days, past the 50 days covered by the levels at a millisecond.
+    std::vector<int64_t> spans = {200, 60'000, 20'000'000, 7'000'000'000};
+    for (int64_t span : spans)
+    {
+        TimerWheel<int64_t> wheel = TimerWheel<int64_t>(milliseconds(1), START);
+        std::uniform_int_distribution<int64_t> deadline(0, span);
+        std::vector<int64_t> deadlines;
+        for (int i = 0; i < 2000; ++i)
+        {
+            deadlines.push_back(deadline(rng));
+            wheel.schedule(START + milliseconds(deadlines.back()), deadlines.back());
+        }
+        std::sort(deadlines.begin(), deadlines.end());
+
+        std::vector<int64_t> expired;
+        int64_t now = 0;
+        std::uniform_int_distribution<int64_t> step(0, span / 500 + 1);
+        while (!wheel.empty())
+        {
+            now += step(rng);
+            wheel.tick(START + milliseconds(now), [&](int64_t value)
+            {
+                EXPECT_LE(value, now) << span;
+                expired.push_back(value);
+            });
+            // Every timer with a reached deadline has expired.
+            size_t due = std::upper_bound(deadlines.begin(), deadlines.end(), now)
+                - deadlines.begin();
+            ASSERT_EQ(expired.size(), due) << span << " " << now;
+        }
+        EXPECT_EQ(expired, deadlines) << span;
+    }
+}
+
+TEST(TimerWheel, cancel)
+{
+    TimerWheel<int> wheel = TimerWheel<int>(milliseconds(1), START);
+    TimerWheel<int>::TimerId first = wheel.schedule(START + milliseconds(10), 1);
+    TimerWheel<int>::TimerId second = wheel.schedule(START + milliseconds(100'000), 2);
+    wheel.schedule(START + milliseconds(10), 3);
+
+    EXPECT_TRUE(wheel.cancel(first));
+    EXPECT_FALSE(wheel.cancel(first));
+    EXPECT_TRUE(wheel.cancel(second));
+    EXPECT_EQ(wheel.size(), 1);
+
+    // The timer reuses the storage of a cancelled one but has a different id.
+    TimerWheel<int>::TimerId reused = wheel.schedule(START + milliseconds(20), 4);
+    EXPECT_NE(reused, first);
+    EXPECT_FALSE(wheel.cancel(first));
+
+    std::vector<int> expired;
+    wheel.tick(START + milliseconds(200'000), [&expired](int value) { expired.push_back(value); });
+    EXPECT_EQ(expired, std::vector<int>({3, 4}));
+    EXPECT_FALSE(wheel.cancel(reused));
+    EXPECT_FALSE(wheel.cancel(~TimerWheel<int>::TimerId(0)));
+}
+
+TEST(TimerWheel, due_timers)
+{
+    TimerWheel<int> wheel = TimerWheel<int>(milliseconds(1), START);
+    wheel.schedule(START - milliseconds(10), 1);
+
+    std::vector<int> expired;
+    auto reschedule = [&](int value)
+    {
+        expired.push_back(value);
+        if (value < 3)
+            wheel.schedule(wheel.now(), value + 1);
+    };
+
+    // Timers scheduled by the callback expire on the next call.
+    EXPECT_EQ(wheel.tick(START, reschedule), 1);
+    EXPECT_EQ(wheel.tick(START, reschedule), 1);
+    EXPECT_EQ(wheel.tick(START - milliseconds(5), reschedule), 1);
+    EXPECT_EQ(wheel.tick(START, reschedule), 0);
+    EXPECT_EQ(expired, std::vector<int>({1, 2, 3}));
+}
+
+TEST(TimerWheel, datetime)
+{
+    Datetime start = Datetime(2022, 1, 3, 9, 30, 0, 0, 0, 0, TZ::EST);
+    TimerWheel<int> wheel = TimerWheel<int>(TimeDelta(0, 0, 0, 1), start.to_instant());
+    wheel.schedule(Datetime(2022, 1, 3, 16, 0, 0, 0, 0, 0, TZ::EST), 1);
+    wheel.schedule_after(TimeDelta(0, 0, 30), 2);
+
+    std::vector<int> expired;
+    auto collect = [&expired](int value) { expired.push_back(value); };
+    wheel.tick(Datetime(2022, 1, 3, 10, 0, 0, 0, 0, 0, TZ::EST), collect);
+    EXPECT_EQ(expired, std::vector<int>({2}));
+    wheel.tick(Datetime(2022, 1, 3, 21, 0, 0, 0, 0, 0, TZ::UTC), collect);
+    EXPECT_EQ(expired, std::vector<int>({2, 1}));
+}
+
+TEST(TimerWheel, simulated_clock)
+{
+    Instant::mock_instant = START;
+    TimerWheel<int> wheel = TimerWheel<int>(milliseconds(1));
+    EXPECT_EQ(wheel.next_expiry(), std::nullopt);
+    wheel.schedule_after(milliseconds(250), 2);
+    wheel.schedule_after(milliseconds(3), 1);
+    wheel.schedule_after(milliseconds(90'000'000), 3);
+
+    // Jump the clock to each possible expiry instead of waiting.
+    std::vector<std::pair<int, Instant>> expired;
+    while (std::optional<Instant> next = wheel.next_expiry())
+    {
+        ASSERT_GE(*next, Instant::now());
+        Instant::mock_instant = *next;
+        wheel.tick([&expired](int value) { expired.emplace_back(value, Instant::now()); });
+    }
+    Instant::mock_instant.reset();
+
+    ASSERT_EQ(expired.size(), 3);
+    EXPECT_EQ(expired[0], std::make_pair(1, START + milliseconds(3)));
+    EXPECT_EQ(expired[1], std::make_pair(2, START + milliseconds(250)));
+    EXPECT_EQ(expired[2], std::make_pair(3, START + milliseconds(90'000'000)));
+}
@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <algorithm>
+#include <random>
+
+namespace
+{
+struct Column
+{
+    std::vector<Instant> instants;
+    std::vector<int> values;
+};
+
+/**
+ * Merges 'columns' with streams reading 'batch_size' items at a time.
+ */
+std::vector<std::pair<int64_t, size_t>> merge(const std::vector<Column>& columns,
+                                              size_t batch_size)
+{
+    std::vector<SpanStream<int>> streams;
+    for (const Column& column : columns)
+        streams.emplace_back(column.instants, column.values);
+    std::vector<TimestampStream<int>*> pointers;
+    for (SpanStream<int>& stream : streams)
+        pointers.push_back(&stream);
+
+    TimestampMerger<int> merger = TimestampMerger<int>(pointers, batch_size);
+    std::vector<std::pair<int64_t, size_t>> ret;
+    while (auto item = merger.next())
+    {
+        EXPECT_EQ(item->value, columns[item->source].values[static_cast<size_t>(
+            std::count_if(ret.begin(), ret.end(),
+                          [&item](const auto& pair) { return pair.second == item->source; }))]);
+        ret.emplace_back(item->instant.nanoseconds, item->source);
+    }
+    EXPECT_TRUE(merger.empty());
+    return ret;
+}
+}
+
+TEST(TimestampMerger, constructor_invalid)
+{
+    std::vector<TimestampStream<int>*> streams = {nullptr};
+    EXPECT_THROW(TimestampMerger<int>{streams}, std::invalid_argument);
+    EXPECT_THROW(TimestampMerger<int>({}, 0), std::invalid_argument);
+}
+
+TEST(TimestampMerger, span_stream_invalid)
+{
+    std::vector<Instant> instants = {Instant(1)};
+    std::vector<int> values;
+    EXPECT_THROW(SpanStream<int>(instants, values), std::invalid_argument);
+}
+
+TEST(TimestampMerger, no_streams)
+{
+    TimestampMerger<int> merger = TimestampMerger<int>({});
+    EXPECT_TRUE(merger.empty());
+    EXPECT_FALSE(merger.next());
+}
+
+TEST(TimestampMerger, merges_in_order)
+{
+    std::vector<Column> columns = {
+        {{Instant(1), Instant(5), Instant(9)}, {10, 11, 12}},
+        {{}, {}},
+        {{Instant(2), Instant(3)}, {20, 21}},
+        {{Instant(4)}, {30}}};
+    std::vector<std::pair<int64_t, size_t>> expected = {
+        {1, 0}, {2, 2}, {3, 2}, {4, 3}, {5, 0}, {9, 0}};
+    EXPECT_EQ(merge(columns, 256), expected);
+    EXPECT_EQ(merge(columns, 1), expected);
+}
+
+TEST(TimestampMerger, ties_in_stream_order)
+{
+    int64_t max = std::numeric_limits<int64_t>::max();
+    std::vector<Column> columns = {
+        {{Instant(2), Instant(max)}, {1, 2}},
+        {{Instant(1), Instant(2), Instant(2)}, {3, 4, 5}},
+        {{Instant(2), Instant(max)}, {6, 7}}};
+    std::vector<std::pair<int64_t, size_t>> expected = {
+        {1, 1}, {2, 0}, {2, 1}, {2, 1}, {2, 2}, {max, 0}, {max, 2}};
+    EXPECT_EQ(merge(columns, 2), expected);
+}
+
+TEST(TimestampMerger, drain)
+{
+    std::vector<Instant> instants = {Instant(3), Instant(4)};
+    std::vector<int> values = {1, 2};
+    std::vector<Instant> other_instants = {Instant(1)};
+    std::vector<int> other_values = {3};
+    SpanStream<int> stream = SpanStream<int>(instants, values);
+    SpanStream<int> other = SpanStream<int>(other_instants, other_values);
+
+    TimestampMerger<int> merger = TimestampMerger<int>({&stream, &other});
+    std::vector<int> drained;
+    EXPECT_EQ(merger.drain([&drained](Instant, size_t, int value) { drained.push_back(value); }),
+              3);
+    EXPECT_EQ(drained, std::vector<int>({3, 1, 2}));
+    EXPECT_TRUE(merger.empty());
+}
+
+TEST(TimestampMerger, unsorted_stream)
+{
+    std::vector<Instant> instants = {Instant(3), Instant(2)};
+    std::vector<int> values = {1, 2};
+    SpanStream<int> stream = SpanStream<int>(instants, values);
+
+    TimestampMerger<int> merger = TimestampMerger<int>({&stream});
+    EXPECT_THROW(merger.drain([](Instant, size_t, int) {}), std::invalid_argument);
+}
+
+TEST(TimestampMerger, matches_stable_sort)
+{
+    std::mt19937_64 rng(89);
+    for (size_t count : {1, 2, 3, 7, 64, 100})
+    {
+        std::vector<Column> columns(count);
+        std::vector<std::pair<int64_t, size_t>> expected;
+        for (size_t s = 0; s < count; ++s)
+        {
+            int64_t nanoseconds = static_cast<int64_t>(rng() % 50);
+            for (size_t i = rng() % 40; i > 0; --i)
+            {
+                nanoseconds += static_cast<int64_t>(rng() % 3);
+                columns[s].instants.emplace_back(nanoseconds);
+                columns[s].values.push_back(static_cast<int>(rng()));
+                expected.emplace_back(nanoseconds, s);
+            }
+        }
+        std::sort(expected.begin(), expected.end());
+
+        EXPECT_EQ(merge(columns, 5), expected);
+    }
+}
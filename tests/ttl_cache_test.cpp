@@ -0,0 +1,203 @@
+#include "gtest/gtest.h"
+#include <map>
+#include <random>
+#include <string>
+#include <datetime/datetime.h>
+#include "test_helpers.h"
+
+TEST(CoarseClock, update)
+{
+    CoarseClock clock = CoarseClock(START);
+    EXPECT_EQ(clock.now(), START);
+
+    clock.update(START + TimeDelta(0, 0, 0, 1));
+    EXPECT_EQ(clock.now(), START + TimeDelta(0, 0, 0, 1));
+
+    Instant::mock_instant = START + TimeDelta(1);
+    clock.update();
+    EXPECT_EQ(clock.now(), START + TimeDelta(1));
+    Instant::mock_instant.reset();
+}
+
+TEST(TtlCache, constructor_invalid)
+{
+    CoarseClock clock = CoarseClock(START);
+    EXPECT_THROW((TtlCache<int, int>(TimeDelta(0, 0, 0, 1), clock, TimeDelta())),
+                 std::invalid_argument);
+    EXPECT_THROW((TtlCache<int, int>(TimeDelta(), clock)), std::invalid_argument);
+    EXPECT_THROW((TtlCache<int, int>(TimeDelta(25), clock)), std::invalid_argument);
+    EXPECT_NO_THROW((TtlCache<int, int>(TimeDelta(24), clock)));
+}
+
+TEST(TtlCache, find)
+{
+    CoarseClock clock = CoarseClock(START);
+    TtlCache<std::string, int> cache = TtlCache<std::string, int>(TimeDelta(0, 0, 0, 5), clock);
+    EXPECT_TRUE(cache.insert_or_assign("ESH2", 1));
+    EXPECT_TRUE(cache.insert_or_assign("NQH2", 2));
+    EXPECT_EQ(cache.size(), 2);
+
+    clock.update(START + TimeDelta(0, 0, 0, 4, 999));
+    ASSERT_NE(cache.find("ESH2"), nullptr);
+    EXPECT_EQ(*cache.find("ESH2"), 1);
+    EXPECT_EQ(cache.find("YMH2"), nullptr);
+
+    // Entries expire at the end of their time to live.
+    clock.update(START + TimeDelta(0, 0, 0, 5));
+    EXPECT_EQ(cache.find("ESH2"), nullptr);
+    EXPECT_EQ(cache.size(), 1);
+
+    EXPECT_EQ(cache.hits(), 2);
+    EXPECT_EQ(cache.misses(), 2);
+    EXPECT_EQ(cache.expirations(), 1);
+}
+
+TEST(TtlCache, insert_or_assign)
+{
+    CoarseClock clock = CoarseClock(START);
+    TtlCache<int, std::string> cache = TtlCache<int, std::string>(TimeDelta(0, 0, 0, 5), clock);
+    cache.insert_or_assign(1, "a");
+
+    clock.update(START + TimeDelta(0, 0, 0, 3));
+    EXPECT_FALSE(cache.insert_or_assign(1, "b"));
+
+    // Replacing a value restarts its time to live.
+    clock.update(START + TimeDelta(0, 0, 0, 7));
+    ASSERT_NE(cache.find(1), nullptr);
+    EXPECT_EQ(*cache.find(1), "b");
+    EXPECT_EQ(cache.evict_expired(), 0);
+
+    clock.update(START + TimeDelta(0, 0, 0, 8));
+    EXPECT_EQ(cache.evict_expired(), 1);
+    EXPECT_EQ(cache.size(), 0);
+    EXPECT_EQ(cache.expirations(), 1);
+    EXPECT_TRUE(cache.insert_or_assign(1, "c"));
+}
+
+TEST(TtlCache, lazy_eviction)
+{
+    CoarseClock clock = CoarseClock(START);
+    TtlCache<int, int> cache = TtlCache<int, int>(TimeDelta(0, 0, 0, 1), clock);
+    for (int i = 0; i < 100; ++i)
+    {
+        clock.update(START + TimeDelta(0, 0, 0, 0, 10 * i));
+        cache.insert_or_assign(i, i);
+    }
+    EXPECT_EQ(cache.size(), 100);
+
+    // Finding an entry does not evict the others.
+    clock.update(START + TimeDelta(0, 0, 0, 1, 500));
+    EXPECT_EQ(cache.find(0), nullptr);
+    EXPECT_EQ(cache.size(), 99);
+
+    // Inserting evicts the buckets that have expired, from 10 ms to 500 ms.
+    cache.insert_or_assign(100, 100);
+    EXPECT_EQ(cache.size(), 50);
+    EXPECT_EQ(cache.expirations(), 51);
+    EXPECT_EQ(cache.find(50), nullptr);
+    ASSERT_NE(cache.find(51), nullptr);
+}
+
+TEST(TtlCache, erase)
+{
+    CoarseClock clock = CoarseClock(START);
+    TtlCache<int, int> cache = TtlCache<int, int>(TimeDelta(0, 0, 0, 1), clock);
+    cache.insert_or_assign(1, 1);
+    cache.insert_or_assign(2, 2);
+    EXPECT_TRUE(cache.erase(1));
+    EXPECT_FALSE(cache.erase(1));
+    EXPECT_EQ(cache.find(1), nullptr);
+
+    clock.update(START + TimeDelta(0, 0, 0, 1));
+    EXPECT_FALSE(cache.erase(2));
+    EXPECT_EQ(cache.expirations(), 1);
+    EXPECT_EQ(cache.evict_expired(), 0);
+}
+
+TEST(TtlCache, shared_clock)
+{
+    CoarseClock clock = CoarseClock(START);
+    TtlCache<int, int> short_lived = TtlCache<int, int>(TimeDelta(0, 0, 0, 1), clock);
+    TtlCache<int, int> long_lived = TtlCache<int, int>(TimeDelta(0, 0, 1), clock,
+                                                       TimeDelta(0, 0, 0, 1));
+    short_lived.insert_or_assign(1, 1);
+    long_lived.insert_or_assign(1, 1);
+
+    clock.update(START + TimeDelta(0, 0, 0, 30));
+    EXPECT_EQ(short_lived.find(1), nullptr);
+    EXPECT_NE(long_lived.find(1), nullptr);
+
+    clock.update(START + TimeDelta(0, 0, 1));
+    EXPECT_EQ(long_lived.find(1), nullptr);
+}
+
+TEST(TtlCache, tick_overflow)
+{
+    // Ticks of a nanosecond overflow 32 bits after about 4.3 seconds.
+    CoarseClock clock = CoarseClock(START);
+    TimeDelta resolution = TimeDelta::from_nanoseconds(1);
+    TtlCache<int, int> cache = TtlCache<int, int>(milliseconds(1), clock, resolution);
+    for (int i = 0; i < 10; ++i)
+    {
+        Instant now = START + TimeDelta(0, 0, 0, 3 * i);
+        clock.update(now);
+        cache.insert_or_assign(i, i);
+        EXPECT_NE(cache.find(i), nullptr);
+
+        clock.update(now + TimeDelta::from_nanoseconds(999'999));
+        EXPECT_NE(cache.find(i), nullptr);
+
+        clock.update(now + milliseconds(1));
+        EXPECT_EQ(cache.find(i), nullptr);
+    }
+
+    // Entries that expired long ago are evicted by 'find' before their stamps wrap around.
+    cache.insert_or_assign(10, 10);
+    clock.update(clock.now() + TimeDelta(0, 0, 0, 3));
+    EXPECT_EQ(cache.find(10), nullptr);
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(TtlCache, matches_map)
+{
+    std::mt19937_64 rng(5);
+    std::uniform_int_distribution<int> key(0, 63);
+    std::uniform_int_distribution<int> operation(0, 3);
+    std::uniform_int_distribution<int64_t> step(0, 400'000);
+    CoarseClock clock = CoarseClock(START);
+    TimeDelta ttl = TimeDelta(0, 0, 0, 0, 20);
+    TtlCache<int, int> cache = TtlCache<int, int>(ttl, clock, TimeDelta::from_nanoseconds(1'000));
+    std::map<int, std::pair<int, Instant>> expected;
+    uint64_t finds = 0;
+    uint64_t hits = 0;
+    for (int i = 0; i < 20'000; ++i)
+    {
+        clock.update(clock.now() + TimeDelta::from_nanoseconds(step(rng)));
+        int k = key(rng);
+        auto it = expected.find(k);
+        bool live = it != expected.end() && it->second.second > clock.now();
+        switch (operation(rng))
+        {
+            case 0:
+                // The time to live is 20 ticks, so the deadline is on a tick.
+                cache.insert_or_assign(k, i);
+                expected[k] = {i, Instant(clock.now().nanoseconds / 1'000 * 1'000) + ttl};
+                break;
+            case 1:
+                ASSERT_EQ(cache.erase(k), live) << i;
+                expected.erase(k);
+                break;
+            default:
+                int* value = cache.find(k);
+                ASSERT_EQ(value != nullptr, live) << i;
+                finds++;
+                hits += live;
+                if (live)
+                {
+                    ASSERT_EQ(*value, it->second.first) << i;
+                }
+        }
+    }
+    EXPECT_EQ(cache.hits(), hits);
+    EXPECT_EQ(cache.misses(), finds - hits);
+}
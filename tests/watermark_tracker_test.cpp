@@ -0,0 +1,90 @@
+#include "gtest/gtest.h"
+#include <datetime/datetime.h>
+#include <thread>
+
+TEST(WatermarkTracker, constructor_invalid)
+{
+    EXPECT_THROW(WatermarkTracker(0, TimeDelta()), std::invalid_argument);
+    EXPECT_THROW(WatermarkTracker(2, TimeDelta::from_nanoseconds(-1)), std::invalid_argument);
+}
+
+TEST(WatermarkTracker, single_source)
+{
+    WatermarkTracker tracker = WatermarkTracker(1, TimeDelta::from_nanoseconds(10));
+    EXPECT_EQ(tracker.watermark(), std::nullopt);
+    EXPECT_EQ(tracker.latest_event_time(0), std::nullopt);
+
+    EXPECT_TRUE(tracker.observe(0, Instant(100)));
+    EXPECT_EQ(tracker.watermark(), Instant(90));
+    EXPECT_TRUE(tracker.observe(0, Instant(95)));
+    EXPECT_EQ(tracker.watermark(), Instant(90));
+    EXPECT_EQ(tracker.latest_event_time(0), Instant(100));
+
+    EXPECT_FALSE(tracker.observe(0, Instant(89)));
+    EXPECT_EQ(tracker.late_events(0), 1);
+    EXPECT_THROW(tracker.observe(1, Instant(100)), std::invalid_argument);
+}
+
+TEST(WatermarkTracker, minimum_over_sources)
+{
+    WatermarkTracker tracker = WatermarkTracker(5, TimeDelta::from_nanoseconds(10));
+    EXPECT_EQ(tracker.source_count(), 5);
+    for (size_t s = 0; s < 4; ++s)
+        tracker.observe(s, Instant(100 + static_cast<int64_t>(s)));
+
+    // Source 4 has had no events yet.
+    EXPECT_EQ(tracker.watermark(), std::nullopt);
+    EXPECT_TRUE(tracker.observe(4, Instant(50)));
+    EXPECT_EQ(tracker.watermark(), Instant(40));
+
+    tracker.observe(4, Instant(200));
+    EXPECT_EQ(tracker.watermark(), Instant(90));
+    tracker.observe(0, Instant(300));
+    EXPECT_EQ(tracker.watermark(), Instant(91));
+
+    EXPECT_FALSE(tracker.observe(3, Instant(80)));
+    EXPECT_FALSE(tracker.observe(2, Instant(90)));
+    EXPECT_TRUE(tracker.observe(2, Instant(91)));
+    EXPECT_EQ(tracker.late_events(3), 1);
+    EXPECT_EQ(tracker.late_events(), 2);
+}
+
+TEST(WatermarkTracker, saturates)
+{
+    WatermarkTracker tracker = WatermarkTracker(1, TimeDelta(0, 1));
+    tracker.observe(0, Instant(std::numeric_limits<int64_t>::min() + 1));
+    EXPECT_EQ(tracker.watermark(), Instant(std::numeric_limits<int64_t>::min()));
+}
+
+TEST(WatermarkTracker, concurrent_sources)
+{
+    constexpr size_t SOURCES = 6;
+    constexpr int64_t EVENTS = 20'000;
+    WatermarkTracker tracker = WatermarkTracker(SOURCES, TimeDelta::from_nanoseconds(5));
+
+    std::vector<std::thread> threads;
+    for (size_t s = 0; s < SOURCES; ++s)
+    {
+        threads.emplace_back([&tracker, s]()
+        {
+            std::optional<Instant> previous;
+            for (int64_t i = 1; i <= EVENTS; ++i)
+            {
+                tracker.observe(s, Instant(i * static_cast<int64_t>(s + 1)));
+
+                // The watermark never decreases.
+                std::optional<Instant> current = tracker.watermark();
+                if (previous)
+                {
+                    EXPECT_GE(current, previous);
+                }
+                previous = current;
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(tracker.watermark(), Instant(EVENTS - 5));
+    EXPECT_EQ(tracker.late_events(), 0);
+}